@@ -1,6 +1,11 @@
 #include "CPUPhysicsEngine.h"
 #include "../managers/logmanager/Logger.h"
+#include "../managers/jobmanager/JobSystem.h"
+#include "../managers/profilemanager/AllocationTracker.h"
+#include "../managers/profilemanager/HardwareCounters.h"
+#include "../managers/profilemanager/Profiler.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 namespace cpu_physics {
@@ -20,6 +25,14 @@ bool CPUPhysicsEngine::initialize(uint32_t maxRigidBodies) {
     entityFactory = std::make_shared<RigidBodyEntityFactory>(ecsManager);
     collisionSystem = std::make_shared<CPUPhysicsCollisionSystem>(ecsManager);
     
+    // Job system for the parallel stages, unless the host supplied one
+    if (!jobSystem) {
+        jobSystem = std::make_shared<JobSystem>();
+    }
+    collisionSystem->setJobSystem(jobSystem);
+    collisionSystem->setDeterministic(deterministic);
+    systemScheduler.setJobSystem(jobSystem);
+    
     // Set up layer interaction callback
     collisionSystem->setLayerInteractionCallback(
         [this](uint32_t layer1, uint32_t layer2) {
@@ -42,6 +55,8 @@ void CPUPhysicsEngine::cleanup() {
     
     // ECS components will be cleaned up automatically when shared_ptrs are destroyed
     collisionSystem.reset();
+    systemScheduler = SystemScheduler();
+    jobSystem.reset();
     entityFactory.reset();
     ecsManager.reset();
     
@@ -61,10 +76,8 @@ uint32_t CPUPhysicsEngine::createRigidBody(float x, float y, float z, float widt
         // Create legacy wrapper for compatibility
         createLegacyRigidBodyWrapper(entityId);
         
-        LOG_INFO(LogCategory::RIGIDBODY, 
-            "Created rigidbody " + std::to_string(entityId) + 
-            " at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")" +
-            " with dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ", " + std::to_string(depth) + ")");
+        LOG_INFO(LogCategory::RIGIDBODY, "Created rigidbody {} at ({}, {}, {}) with dimensions ({}, {}, {})",
+                 entityId, x, y, z, width, height, depth);
     }
     
     return entityId;
@@ -94,18 +107,48 @@ RigidBodyComponent* CPUPhysicsEngine::getRigidBody(uint32_t entityId) {
     return it->second.get();
 }
 
-void CPUPhysicsEngine::updatePhysics(float deltaTime) {
+bool CPUPhysicsEngine::setContinuousCollision(uint32_t entityId, bool enabled) {
+    auto* physics = ecsManager ? ecsManager->getComponent<PhysicsComponent>(entityId) : nullptr;
+    if (!physics) {
+        return false;
+    }
+    
+    physics->continuousCollision = enabled;
+    return true;
+}
+
+void CPUPhysicsEngine::updatePhysics(float deltaTime, float budgetMs) {
     if (!collisionSystem) {
         LOG_WARN(LogCategory::PHYSICS, "Collision system not initialized");
         return;
     }
+    PROFILE_SCOPE("CPUPhysicsEngine::updatePhysics");
+    auto startTime = std::chrono::high_resolution_clock::now();
     
     // Delegate to collision system
-    collisionSystem->update(deltaTime);
+    collisionSystem->update(deltaTime, budgetMs);
+    lastStepStats = collisionSystem->getLastStepStats();
+    
+    {
+        PROFILE_SCOPE("systems");
+        AllocationPhase allocations("systems");
+        CounterScope counters(lastStepStats.systemsCounters);
+        // Registered systems run after the rigidbody step, concurrently where their components allow
+        systemScheduler.update(deltaTime);
+        lastStepStats.systemsMs = systemScheduler.getLastUpdateTime();
+    }
     
-    // Update legacy rigidbody wrappers
-    for (const auto& [entityId, wrapper] : legacyRigidBodies) {
-        updateLegacyRigidBodyData(entityId);
+    {
+        PROFILE_SCOPE("legacy sync");
+        AllocationPhase allocations("legacy sync");
+        auto syncStart = std::chrono::high_resolution_clock::now();
+        // Update legacy rigidbody wrappers
+        for (const auto& [entityId, wrapper] : legacyRigidBodies) {
+            updateLegacyRigidBodyData(entityId);
+        }
+        auto syncEnd = std::chrono::high_resolution_clock::now();
+        lastStepStats.legacySyncMs = std::chrono::duration<float, std::milli>(syncEnd - syncStart).count();
+        lastStepStats.totalMs = std::chrono::duration<float, std::milli>(syncEnd - startTime).count();
     }
 }
 
@@ -123,6 +166,23 @@ void CPUPhysicsEngine::setGravity(float x, float y, float z) {
         std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
 }
 
+void CPUPhysicsEngine::setDeterministic(bool enabled) {
+    deterministic = enabled;
+    if (collisionSystem) {
+        collisionSystem->setDeterministic(enabled);
+    }
+    
+    LOG_INFO(LogCategory::PHYSICS, std::string("Deterministic mode ") + (enabled ? "enabled" : "disabled"));
+}
+
+uint64_t CPUPhysicsEngine::getLastStateHash() const {
+    return collisionSystem ? collisionSystem->getLastStateHash() : 0;
+}
+
+StepBudgetStats CPUPhysicsEngine::getLastBudgetStats() const {
+    return collisionSystem ? collisionSystem->getLastBudgetStats() : StepBudgetStats{};
+}
+
 uint32_t CPUPhysicsEngine::createLayer(const std::string& name) {
     PhysicsLayer layer;
     layer.id = nextLayerId++;
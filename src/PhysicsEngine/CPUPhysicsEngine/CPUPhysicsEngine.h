@@ -13,6 +13,9 @@
 #include "factories/components/RigidbodyComponentFactory.h"
 #include "factories/entities/RigidbodyEntityFactory.h"
 #include "systems/CpuPhysicsCollisionSystem.h"
+#include "systems/SystemScheduler.h"
+
+class JobSystem;
 
 namespace cpu_physics {
 
@@ -30,6 +33,8 @@ struct PhysicsLayer {
  * - Uses ECS Manager for component storage
  * - Uses Entity Factory for rigidbody creation
  * - Uses Collision System for physics simulation
+ * - Runs additional CPUPhysicsSystems through a dependency-graph scheduler
+ * - Owns the work-stealing job system used by the parallel stages
  * - Maintains layer system for collision filtering
  */
 class CPUPhysicsEngine {
@@ -44,9 +49,11 @@ public:
     uint32_t createRigidBody(float x, float y, float z, float width, float height, float depth, float mass = 1.0f, uint32_t layer = 0);
     bool removeRigidBody(uint32_t entityId);
     RigidBodyComponent* getRigidBody(uint32_t entityId); // Legacy compatibility
+    // Continuous collision detection for a fast body (e.g. a projectile)
+    bool setContinuousCollision(uint32_t entityId, bool enabled);
     
-    // Physics simulation - delegates to collision system
-    void updatePhysics(float deltaTime);
+    // Physics simulation - delegates to collision system; budgetMs > 0 allows degradation
+    void updatePhysics(float deltaTime, float budgetMs = 0.0f);
     void setGravity(float x, float y, float z);
     
     // Layer system for collision filtering
@@ -60,6 +67,26 @@ public:
     std::shared_ptr<ECSManager> getECSManager() const { return ecsManager; }
     std::shared_ptr<RigidBodyEntityFactory> getEntityFactory() const { return entityFactory; }
     std::shared_ptr<CPUPhysicsCollisionSystem> getCollisionSystem() const { return collisionSystem; }
+    std::shared_ptr<JobSystem> getJobSystem() const { return jobSystem; }
+    SystemScheduler& getSystemScheduler() { return systemScheduler; }
+    
+    // Additional systems, updated after the collision system each step
+    void addSystem(std::shared_ptr<interfaces::CPUPhysicsSystem> system) { systemScheduler.addSystem(std::move(system)); }
+    bool removeSystem(const interfaces::CPUPhysicsSystem* system) { return systemScheduler.removeSystem(system); }
+    
+    // Use a host-provided job system instead of creating one (call before initialize)
+    void setJobSystem(std::shared_ptr<JobSystem> jobs) { jobSystem = std::move(jobs); }
+    
+    // Deterministic mode: bit-identical results for any worker count, plus a per-step state hash
+    void setDeterministic(bool enabled);
+    bool isDeterministic() const { return deterministic; }
+    uint64_t getLastStateHash() const;
+    
+    // Degradations applied by the last budgeted step
+    StepBudgetStats getLastBudgetStats() const;
+    
+    // Counters and phase times of the last step (the particle fields stay 0)
+    const PhysicsStepStats& getLastStepStats() const { return lastStepStats; }
     
     // Configuration and statistics
     uint32_t getMaxRigidBodies() const { return maxRigidBodies; }
@@ -70,12 +97,18 @@ private:
     std::shared_ptr<ECSManager> ecsManager;
     std::shared_ptr<RigidBodyEntityFactory> entityFactory;
     std::shared_ptr<CPUPhysicsCollisionSystem> collisionSystem;
+    SystemScheduler systemScheduler;
+    PhysicsStepStats lastStepStats;
+    
+    // Job system shared by the parallel physics stages
+    std::shared_ptr<JobSystem> jobSystem;
     
     // Legacy rigidbody tracking (for compatibility)
     std::unordered_map<uint32_t, std::unique_ptr<RigidBodyComponent>> legacyRigidBodies;
     
     // Configuration
     uint32_t maxRigidBodies = 512;
+    bool deterministic = false;
     
     // Layer system
     std::unordered_map<uint32_t, PhysicsLayer> layers;
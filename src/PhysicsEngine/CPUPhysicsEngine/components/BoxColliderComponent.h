@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace cpu_physics {
 
 // Box Collider Component (only supported collider type for now)
@@ -8,6 +10,7 @@ struct BoxColliderComponent {
     float height = 1.0f;
     float depth = 1.0f;
     bool enabled = true;
+    uint32_t layer = 0; // Physics layer for collision filtering
 };
 
 } // namespace cpu_physics
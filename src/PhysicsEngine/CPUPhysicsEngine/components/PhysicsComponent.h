@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace cpu_physics {
 
 // Physics Component
@@ -12,6 +14,16 @@ struct PhysicsComponent {
     float friction = 0.3f;
     bool isStatic = false;
     bool useGravity = true;
+    bool isSleeping = false; // sleeping bodies are skipped by the integrator and solver
+    float sleepTimer = 0.0f; // seconds spent below the sleep thresholds
+    bool continuousCollision = false; // swept against other colliders so fast bodies cannot tunnel
+    
+    // Simulation level of detail (see CPUPhysicsCollisionSystem::addFocusPoint)
+    float lodImportance = 1.0f;    // divides the distance to the focus points; 0 always uses the lowest rate
+    uint32_t lodPeriod = 1;        // steps between updates, chosen each step
+    uint32_t lodHoldSteps = 0;     // steps left at a promoted rate after touching a faster body
+    uint32_t lodHoldPeriod = 1;
+    float lodPendingTime = 0.0f;   // simulated time the body has not been stepped for yet
 };
 
 } // namespace cpu_physics
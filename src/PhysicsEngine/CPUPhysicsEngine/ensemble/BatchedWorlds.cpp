@@ -0,0 +1,354 @@
+#include "BatchedWorlds.h"
+#include "../../managers/jobmanager/JobSystem.h"
+#include "../../managers/logmanager/Logger.h"
+#include <algorithm>
+
+namespace cpu_physics {
+
+namespace {
+
+using simd::FloatW;
+constexpr uint32_t WIDTH = simd::WIDTH;
+
+// Picks b where mask is 1 and a where it is 0, exactly for both
+inline FloatW blend(FloatW a, FloatW b, FloatW mask) {
+    return b * mask + a * (FloatW::splat(1.0f) - mask);
+}
+
+inline bool anyLane(FloatW mask) {
+    alignas(32) float lanes[WIDTH];
+    mask.store(lanes);
+    for (uint32_t lane = 0; lane < WIDTH; lane++) {
+        if (lanes[lane] != 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+uint32_t BatchedWorlds::addBody(float x, float y, float z, float width, float height, float depth,
+                                float mass, float restitution) {
+    if (worldCount > 0) {
+        LOG_WARN(LogCategory::PHYSICS, "BatchedWorlds: Bodies must be added before initialize()");
+        return 0;
+    }
+
+    TemplateBody body;
+    body.position[0] = x;
+    body.position[1] = y;
+    body.position[2] = z;
+    body.halfExtent[0] = width * 0.5f;
+    body.halfExtent[1] = height * 0.5f;
+    body.halfExtent[2] = depth * 0.5f;
+    body.invMass = mass > 0.0f ? 1.0f / mass : 0.0f;
+    body.restitution = restitution;
+    templateBodies.push_back(body);
+    return static_cast<uint32_t>(templateBodies.size() - 1);
+}
+
+bool BatchedWorlds::initialize(uint32_t count) {
+    if (count == 0 || templateBodies.empty()) {
+        LOG_ERROR(LogCategory::PHYSICS, "BatchedWorlds: Need at least one world and one body");
+        return false;
+    }
+
+    worldCount = count;
+    blockCount = (count + WIDTH - 1) / WIDTH;
+    uint32_t bodyCount = getBodyCount();
+
+    // Pair list in row order, the order a single world finds its contacts in
+    pairs.clear();
+    for (uint32_t a = 0; a < bodyCount; a++) {
+        for (uint32_t b = a + 1; b < bodyCount; b++) {
+            if (templateBodies[a].invMass > 0.0f || templateBodies[b].invMass > 0.0f) {
+                pairs.push_back({a, b});
+            }
+        }
+    }
+
+    bodies.clear();
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    for (size_t block = 0; block < blockCount; block++) {
+        for (const TemplateBody& body : templateBodies) {
+            for (uint32_t lane = 0; lane < WIDTH; lane++) {
+                uint32_t index = bodies.add(zero, body.position, body.invMass);
+                bodies.gravityScale[index] = body.invMass > 0.0f ? 1.0f : 0.0f;
+                bodies.halfExtentX[index] = body.halfExtent[0];
+                bodies.halfExtentY[index] = body.halfExtent[1];
+                bodies.halfExtentZ[index] = body.halfExtent[2];
+            }
+        }
+    }
+    BodyIntegrator::updateBounds(bodies);
+
+    blockContacts.assign(blockCount, {});
+    for (auto& contacts : blockContacts) {
+        contacts.reserve(pairs.size());
+    }
+
+    LOG_INFO(LogCategory::PHYSICS, "BatchedWorlds: " + std::to_string(worldCount) + " worlds of " +
+             std::to_string(bodyCount) + " bodies in " + std::to_string(blockCount) + " blocks of " +
+             std::to_string(WIDTH));
+    return true;
+}
+
+void BatchedWorlds::step(float deltaTime) {
+    if (worldCount == 0) {
+        return;
+    }
+
+    if (jobSystem && blockCount > 1) {
+        jobSystem->parallelFor(blockCount, 1, [this, deltaTime](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; block++) {
+                stepBlock(block, deltaTime);
+            }
+        });
+    } else {
+        for (size_t block = 0; block < blockCount; block++) {
+            stepBlock(block, deltaTime);
+        }
+    }
+}
+
+void BatchedWorlds::stepBlock(size_t block, float deltaTime) {
+    const size_t base = block * templateBodies.size() * WIDTH;
+    integrator.integrateRange(bodies, base, base + templateBodies.size() * WIDTH, gravity, deltaTime);
+
+    auto& contacts = blockContacts[block];
+    contacts.clear();
+    for (const BodyPair& pair : pairs) {
+        PairContact contact;
+        if (detectPair(base, pair, contact)) {
+            contacts.push_back(contact);
+        }
+    }
+
+    // Same order as ContactSolver::solveSequential(): prepare, push apart, then iterate
+    for (auto& contact : contacts) {
+        prepareContact(base, contact);
+    }
+    for (const auto& contact : contacts) {
+        correctPositions(base, contact);
+    }
+    for (uint32_t iteration = 0; iteration < solverIterations; iteration++) {
+        for (auto& contact : contacts) {
+            solveVelocity(base, contact);
+        }
+    }
+}
+
+bool BatchedWorlds::detectPair(size_t base, const BodyPair& pair, PairContact& contact) const {
+    const size_t a = base + pair.bodyA * WIDTH;
+    const size_t b = base + pair.bodyB * WIDTH;
+    const float* positions[3] = {bodies.positionX.data(), bodies.positionY.data(), bodies.positionZ.data()};
+    const TemplateBody& bodyA = templateBodies[pair.bodyA];
+    const TemplateBody& bodyB = templateBodies[pair.bodyB];
+
+    // Box-box overlap per lane, as in CPUPhysicsCollisionSystem::narrowPhaseDetection()
+    FloatW inside = FloatW::splat(1.0f);
+    FloatW penetration[3];
+    FloatW aAbove[3];
+    for (int axis = 0; axis < 3; axis++) {
+        FloatW positionA = FloatW::loadUnaligned(positions[axis] + a);
+        FloatW positionB = FloatW::loadUnaligned(positions[axis] + b);
+        FloatW distance = abs(positionA - positionB);
+        FloatW totalExtent = FloatW::splat(bodyA.halfExtent[axis] + bodyB.halfExtent[axis]);
+        inside = inside * lessMask(distance, totalExtent);
+        penetration[axis] = totalExtent - distance;
+        aAbove[axis] = lessMask(positionB, positionA);
+    }
+    if (!anyLane(inside)) {
+        return false;
+    }
+
+    // Axis of least penetration; ties keep the lower axis
+    const FloatW one = FloatW::splat(1.0f);
+    FloatW least = penetration[0];
+    FloatW pickY = lessMask(penetration[1], least);
+    least = blend(least, penetration[1], pickY);
+    FloatW pickZ = lessMask(penetration[2], least);
+    least = blend(least, penetration[2], pickZ);
+    const FloatW onAxis[3] = {(one - pickY) * (one - pickZ), pickY * (one - pickZ), pickZ};
+
+    contact.bodyA = pair.bodyA;
+    contact.bodyB = pair.bodyB;
+    for (int axis = 0; axis < 3; axis++) {
+        FloatW sign = aAbove[axis] * FloatW::splat(2.0f) - one;
+        blend(FloatW::zero(), onAxis[axis] * sign, inside).store(contact.normal[axis]);
+    }
+    blend(FloatW::zero(), least, inside).store(contact.penetration);
+    inside.store(contact.contactMask);
+    return true;
+}
+
+void BatchedWorlds::prepareContact(size_t base, PairContact& contact) const {
+    const size_t a = base + contact.bodyA * WIDTH;
+    const size_t b = base + contact.bodyB * WIDTH;
+    const TemplateBody& bodyA = templateBodies[contact.bodyA];
+    const TemplateBody& bodyB = templateBodies[contact.bodyB];
+    const FloatW mask = FloatW::load(contact.contactMask);
+
+    float invMassSum = bodyA.invMass + bodyB.invMass;
+    float normalMass = invMassSum > 0.0f ? 1.0f / invMassSum : 0.0f;
+    blend(FloatW::zero(), FloatW::splat(normalMass), mask).store(contact.normalMass);
+    FloatW::zero().store(contact.accumulatedImpulse);
+
+    FloatW relativeNormalVelocity =
+        (FloatW::loadUnaligned(bodies.velocityX.data() + a) - FloatW::loadUnaligned(bodies.velocityX.data() + b)) *
+            FloatW::load(contact.normal[0]) +
+        (FloatW::loadUnaligned(bodies.velocityY.data() + a) - FloatW::loadUnaligned(bodies.velocityY.data() + b)) *
+            FloatW::load(contact.normal[1]) +
+        (FloatW::loadUnaligned(bodies.velocityZ.data() + a) - FloatW::loadUnaligned(bodies.velocityZ.data() + b)) *
+            FloatW::load(contact.normal[2]);
+
+    float restitution = std::min(bodyA.restitution, bodyB.restitution);
+    FloatW approaching = lessMask(relativeNormalVelocity, FloatW::zero()) * mask;
+    blend(FloatW::zero(), FloatW::splat(-restitution) * relativeNormalVelocity, approaching)
+        .store(contact.velocityBias);
+}
+
+void BatchedWorlds::correctPositions(size_t base, const PairContact& contact) {
+    const TemplateBody& bodyA = templateBodies[contact.bodyA];
+    const TemplateBody& bodyB = templateBodies[contact.bodyB];
+    const FloatW mask = FloatW::load(contact.contactMask);
+    const FloatW penetration = FloatW::load(contact.penetration);
+    float totalInvMass = bodyA.invMass + bodyB.invMass;
+
+    float* positions[3] = {bodies.positionX.data(), bodies.positionY.data(), bodies.positionZ.data()};
+    FloatW separationA = FloatW::splat(bodyA.invMass / totalInvMass) * penetration * FloatW::splat(0.5f);
+    FloatW separationB = FloatW::splat(bodyB.invMass / totalInvMass) * penetration * FloatW::splat(0.5f);
+
+    for (int axis = 0; axis < 3; axis++) {
+        FloatW normal = FloatW::load(contact.normal[axis]);
+        if (bodyA.invMass > 0.0f) {
+            float* position = positions[axis] + base + contact.bodyA * WIDTH;
+            FloatW current = FloatW::loadUnaligned(position);
+            blend(current, current + normal * separationA, mask).storeUnaligned(position);
+        }
+        if (bodyB.invMass > 0.0f) {
+            float* position = positions[axis] + base + contact.bodyB * WIDTH;
+            FloatW current = FloatW::loadUnaligned(position);
+            blend(current, current - normal * separationB, mask).storeUnaligned(position);
+        }
+    }
+}
+
+void BatchedWorlds::solveVelocity(size_t base, PairContact& contact) {
+    const TemplateBody& bodyA = templateBodies[contact.bodyA];
+    const TemplateBody& bodyB = templateBodies[contact.bodyB];
+    const FloatW mask = FloatW::load(contact.contactMask);
+    float* velocities[3] = {bodies.velocityX.data(), bodies.velocityY.data(), bodies.velocityZ.data()};
+    const size_t a = base + contact.bodyA * WIDTH;
+    const size_t b = base + contact.bodyB * WIDTH;
+
+    FloatW velocityA[3], velocityB[3], normal[3];
+    for (int axis = 0; axis < 3; axis++) {
+        velocityA[axis] = FloatW::loadUnaligned(velocities[axis] + a);
+        velocityB[axis] = FloatW::loadUnaligned(velocities[axis] + b);
+        normal[axis] = FloatW::load(contact.normal[axis]);
+    }
+
+    // Same arithmetic as ContactSolver::solveVelocity(), one world per lane
+    FloatW relativeNormalVelocity = (velocityA[0] - velocityB[0]) * normal[0] +
+                                    (velocityA[1] - velocityB[1]) * normal[1] +
+                                    (velocityA[2] - velocityB[2]) * normal[2];
+    FloatW lambda = FloatW::load(contact.normalMass) * (FloatW::load(contact.velocityBias) - relativeNormalVelocity);
+
+    FloatW previousImpulse = FloatW::load(contact.accumulatedImpulse);
+    FloatW accumulatedImpulse = max(previousImpulse + lambda, FloatW::zero());
+    accumulatedImpulse.store(contact.accumulatedImpulse);
+    lambda = accumulatedImpulse - previousImpulse;
+
+    FloatW impulseA = lambda * FloatW::splat(bodyA.invMass);
+    FloatW impulseB = lambda * FloatW::splat(bodyB.invMass);
+    for (int axis = 0; axis < 3; axis++) {
+        if (bodyA.invMass > 0.0f) {
+            blend(velocityA[axis], velocityA[axis] + impulseA * normal[axis], mask)
+                .storeUnaligned(velocities[axis] + a);
+        }
+        if (bodyB.invMass > 0.0f) {
+            blend(velocityB[axis], velocityB[axis] - impulseB * normal[axis], mask)
+                .storeUnaligned(velocities[axis] + b);
+        }
+    }
+}
+
+size_t BatchedWorlds::bodyIndex(uint32_t world, uint32_t body) const {
+    return ((world / WIDTH) * templateBodies.size() + body) * WIDTH + world % WIDTH;
+}
+
+void BatchedWorlds::observe(float* states) const {
+    const std::vector<float>* arrays[STATE_SIZE] = {
+        &bodies.positionX, &bodies.positionY, &bodies.positionZ,
+        &bodies.rotationW, &bodies.rotationX, &bodies.rotationY, &bodies.rotationZ,
+        &bodies.velocityX, &bodies.velocityY, &bodies.velocityZ,
+        &bodies.angularVelocityX, &bodies.angularVelocityY, &bodies.angularVelocityZ
+    };
+
+    for (uint32_t world = 0; world < worldCount; world++) {
+        for (uint32_t body = 0; body < getBodyCount(); body++) {
+            size_t index = bodyIndex(world, body);
+            for (uint32_t component = 0; component < STATE_SIZE; component++) {
+                *states++ = (*arrays[component])[index];
+            }
+        }
+    }
+}
+
+void BatchedWorlds::reset(const float* states) {
+    for (uint32_t world = 0; world < worldCount; world++) {
+        writeState(world, states + static_cast<size_t>(world) * getBodyCount() * STATE_SIZE);
+    }
+}
+
+void BatchedWorlds::resetWorlds(const uint32_t* worlds, size_t count, const float* states) {
+    for (size_t i = 0; i < count; i++) {
+        if (worlds[i] < worldCount) {
+            writeState(worlds[i], states + i * getBodyCount() * STATE_SIZE);
+        }
+    }
+}
+
+void BatchedWorlds::resetWorldsToTemplate(const uint32_t* worlds, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (worlds[i] < worldCount) {
+            writeTemplateState(worlds[i]);
+        }
+    }
+}
+
+void BatchedWorlds::writeState(uint32_t world, const float* state) {
+    std::vector<float>* arrays[STATE_SIZE] = {
+        &bodies.positionX, &bodies.positionY, &bodies.positionZ,
+        &bodies.rotationW, &bodies.rotationX, &bodies.rotationY, &bodies.rotationZ,
+        &bodies.velocityX, &bodies.velocityY, &bodies.velocityZ,
+        &bodies.angularVelocityX, &bodies.angularVelocityY, &bodies.angularVelocityZ
+    };
+
+    for (uint32_t body = 0; body < getBodyCount(); body++) {
+        size_t index = bodyIndex(world, body);
+        for (uint32_t component = 0; component < STATE_SIZE; component++) {
+            (*arrays[component])[index] = *state++;
+        }
+    }
+}
+
+void BatchedWorlds::writeTemplateState(uint32_t world) {
+    std::vector<float> state(getBodyCount() * STATE_SIZE, 0.0f);
+    for (uint32_t body = 0; body < getBodyCount(); body++) {
+        float* bodyState = state.data() + body * STATE_SIZE;
+        std::copy(templateBodies[body].position, templateBodies[body].position + 3, bodyState);
+        bodyState[3] = 1.0f; // identity rotation
+    }
+    writeState(world, state.data());
+}
+
+void BatchedWorlds::setGravity(float x, float y, float z) {
+    gravity[0] = x;
+    gravity[1] = y;
+    gravity[2] = z;
+}
+
+} // namespace cpu_physics
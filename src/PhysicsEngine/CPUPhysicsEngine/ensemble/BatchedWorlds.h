@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../solver/ContactConstraint.h"
+#include "../solver/BodyIntegrator.h"
+#include "../solver/SimdFloat.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+namespace cpu_physics {
+
+/**
+ * Batched Worlds - Many structurally identical scenes simulated side by side
+ *
+ * Every world has the same bodies (shapes, masses, static/dynamic) and only
+ * their state differs, as in reinforcement learning rollouts or parameter
+ * sweeps. Worlds are stored interleaved in blocks of simd::WIDTH: one SIMD
+ * register holds the same body in 4 or 8 worlds, so the integrator,
+ * narrowphase and contact solver advance a whole block per instruction.
+ * Blocks are independent and run in parallel on the job system.
+ *
+ * Each world steps exactly like a CPUPhysicsEngine holding the same bodies in
+ * deterministic mode with every layer interacting, and produces the same
+ * results bit for bit.
+ *
+ * State moves in and out as contiguous tensors of shape
+ * [world][body][STATE_SIZE]: position (3), rotation quaternion w,x,y,z (4),
+ * velocity (3) and angular velocity (3).
+ */
+class BatchedWorlds {
+public:
+    static constexpr uint32_t STATE_SIZE = 13;
+
+    // Scene template (before initialize); mass <= 0 makes a static body.
+    // Returns the body's index in the state tensors.
+    uint32_t addBody(float x, float y, float z, float width, float height, float depth,
+                     float mass = 1.0f, float restitution = 0.5f);
+
+    // Creates worldCount copies of the template
+    bool initialize(uint32_t worldCount);
+
+    // Advances every world by deltaTime
+    void step(float deltaTime);
+
+    // Bulk state access, tensors laid out [world][body][STATE_SIZE]
+    void observe(float* states) const;
+    void reset(const float* states);
+    // Overwrites only the listed worlds; states is [count][body][STATE_SIZE]
+    void resetWorlds(const uint32_t* worlds, size_t count, const float* states);
+    // Puts the listed worlds back to the template's initial state
+    void resetWorldsToTemplate(const uint32_t* worlds, size_t count);
+
+    // Configuration
+    void setGravity(float x, float y, float z);
+    void setSolverIterations(uint32_t count) { solverIterations = count; }
+    void setJobSystem(std::shared_ptr<JobSystem> jobs) { jobSystem = std::move(jobs); }
+
+    // Statistics
+    uint32_t getWorldCount() const { return worldCount; }
+    uint32_t getBodyCount() const { return static_cast<uint32_t>(templateBodies.size()); }
+    size_t getBlockCount() const { return blockCount; }
+
+private:
+    struct TemplateBody {
+        float position[3];
+        float halfExtent[3];
+        float invMass;
+        float restitution;
+    };
+
+    // Template body pair that can touch (not both static)
+    struct BodyPair {
+        uint32_t bodyA;
+        uint32_t bodyB;
+    };
+
+    // Contact of one pair in every world of a block; lanes without contact have a zero mask
+    struct PairContact {
+        uint32_t bodyA;
+        uint32_t bodyB;
+        alignas(32) float normal[3][simd::WIDTH];
+        alignas(32) float penetration[simd::WIDTH];
+        alignas(32) float contactMask[simd::WIDTH];
+        alignas(32) float normalMass[simd::WIDTH];
+        alignas(32) float velocityBias[simd::WIDTH];
+        alignas(32) float accumulatedImpulse[simd::WIDTH];
+    };
+
+    std::vector<TemplateBody> templateBodies;
+    std::vector<BodyPair> pairs;
+    uint32_t worldCount = 0;
+    size_t blockCount = 0;
+
+    // Body (block, body, lane) lives at index (block * bodyCount + body) * WIDTH + lane
+    SolverBodies bodies;
+    BodyIntegrator integrator;
+    std::vector<std::vector<PairContact>> blockContacts;
+
+    float gravity[3] = {0.0f, -9.81f, 0.0f};
+    uint32_t solverIterations = 4;
+    std::shared_ptr<JobSystem> jobSystem;
+
+    size_t bodyIndex(uint32_t world, uint32_t body) const;
+    void writeState(uint32_t world, const float* state);
+    void writeTemplateState(uint32_t world);
+
+    void stepBlock(size_t block, float deltaTime);
+    bool detectPair(size_t base, const BodyPair& pair, PairContact& contact) const;
+    void prepareContact(size_t base, PairContact& contact) const;
+    void correctPositions(size_t base, const PairContact& contact);
+    void solveVelocity(size_t base, PairContact& contact);
+};
+
+} // namespace cpu_physics
@@ -100,14 +100,9 @@ uint32_t RigidBodyEntityFactory::createRigidBodyWithComponents(
         return 0;
     }
     
-    LOG_INFO(LogCategory::RIGIDBODY, 
-        "Created rigidbody entity " + std::to_string(entityId) + 
-        " at (" + std::to_string(transform.position[0]) + 
-        ", " + std::to_string(transform.position[1]) + 
-        ", " + std::to_string(transform.position[2]) + ")" +
-        " with box collider (" + std::to_string(collider.width) + 
-        ", " + std::to_string(collider.height) + 
-        ", " + std::to_string(collider.depth) + ")");
+    LOG_INFO(LogCategory::RIGIDBODY, "Created rigidbody entity {} at ({}, {}, {}) with box collider ({}, {}, {})",
+             entityId, transform.position[0], transform.position[1], transform.position[2],
+             collider.width, collider.height, collider.depth);
     
     return entityId;
 }
@@ -119,7 +114,7 @@ bool RigidBodyEntityFactory::destroyRigidBody(uint32_t entityId) {
     
     bool result = ecsManager->destroyEntity(entityId);
     if (result) {
-        LOG_INFO(LogCategory::RIGIDBODY, "Destroyed rigidbody entity " + std::to_string(entityId));
+        LOG_INFO(LogCategory::RIGIDBODY, "Destroyed rigidbody entity {}", entityId);
     }
     
     return result;
@@ -159,9 +154,8 @@ std::vector<uint32_t> RigidBodyEntityFactory::createRigidBodyBatch(
         }
     }
     
-    LOG_INFO(LogCategory::RIGIDBODY, 
-        "Created batch of " + std::to_string(entities.size()) + 
-        " rigidbodies from " + std::to_string(specs.size()) + " specifications");
+    LOG_INFO(LogCategory::RIGIDBODY, "Created batch of {} rigidbodies from {} specifications",
+             entities.size(), specs.size());
     
     return entities;
 }
@@ -124,9 +124,9 @@ bool RigidBodyEntityFactory::addAllComponents(
     uint32_t layer) {
     ecsManager->addComponent<TransformComponent>(entityId, transform);
     ecsManager->addComponent<PhysicsComponent>(entityId, physics);
-    ecsManager->addComponent<BoxColliderComponent>(entityId, collider);
-    // TODO: layer component type
-    (void)layer;
+    BoxColliderComponent layeredCollider = collider;
+    layeredCollider.layer = layer;
+    ecsManager->addComponent<BoxColliderComponent>(entityId, layeredCollider);
     return true;
 }
 
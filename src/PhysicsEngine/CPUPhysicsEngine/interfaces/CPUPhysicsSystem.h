@@ -121,6 +121,28 @@ public:
      */
     virtual std::vector<CPUPhysicsComponent::ComponentType> getOptionalComponents() const = 0;
 
+    /**
+     * Get the component types this system reads during update. Used by the
+     * system scheduler to find systems that can run concurrently.
+     * @return Vector of read component types (defaults to required + optional)
+     */
+    virtual std::vector<CPUPhysicsComponent::ComponentType> getReadComponents() const {
+        auto components = getRequiredComponents();
+        auto optional = getOptionalComponents();
+        components.insert(components.end(), optional.begin(), optional.end());
+        return components;
+    }
+
+    /**
+     * Get the component types this system writes during update. Systems that
+     * only read some of their components should override this so they can
+     * run alongside other readers.
+     * @return Vector of written component types (defaults to every read type)
+     */
+    virtual std::vector<CPUPhysicsComponent::ComponentType> getWriteComponents() const {
+        return getReadComponents();
+    }
+
     /**
      * Enable or disable the system
      * @param enabled New enabled state
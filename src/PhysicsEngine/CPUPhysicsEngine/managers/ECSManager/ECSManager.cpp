@@ -13,7 +13,7 @@ uint32_t ECSManager::createEntity() {
     uint32_t entityId = nextEntityId++;
     entities.push_back(entityId);
     
-    LOG_DEBUG(LogCategory::PHYSICS, "Created entity " + std::to_string(entityId));
+    LOG_DEBUG(LogCategory::PHYSICS, "Created entity {}", entityId);
     return entityId;
 }
 
@@ -31,7 +31,7 @@ bool ECSManager::destroyEntity(uint32_t entityId) {
     // Remove from entity list
     entities.erase(it);
     
-    LOG_DEBUG(LogCategory::PHYSICS, "Destroyed entity " + std::to_string(entityId));
+    LOG_DEBUG(LogCategory::PHYSICS, "Destroyed entity {}", entityId);
     return true;
 }
 
@@ -124,6 +124,13 @@ std::vector<uint32_t> ECSManager::getEntitiesWithTransformComponent() const {
     return result;
 }
 
+void ECSManager::forEachTransformComponent(
+    const std::function<void(uint32_t, const TransformComponent&)>& visit) const {
+    for (const auto& [entityId, component] : transformComponents) {
+        visit(entityId, component);
+    }
+}
+
 std::vector<uint32_t> ECSManager::getEntitiesWithPhysicsComponent() const {
     std::vector<uint32_t> result;
     for (const auto& [entityId, component] : physicsComponents) {
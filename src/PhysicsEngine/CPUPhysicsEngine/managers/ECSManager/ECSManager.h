@@ -4,6 +4,7 @@
 #include <vector>
 #include <typeindex>
 #include <memory>
+#include <functional>
 #include <cstdint>
 
 namespace cpu_physics {
@@ -54,6 +55,9 @@ public:
     std::vector<uint32_t> getEntitiesWithPhysicsComponent() const;
     std::vector<uint32_t> getEntitiesWithBoxColliderComponent() const;
     
+    // Calls visit(entityId, transform) for every transform component, without building an ID list
+    void forEachTransformComponent(const std::function<void(uint32_t, const TransformComponent&)>& visit) const;
+    
     // Template helpers for generic access
     template<typename T>
     T* getComponent(uint32_t entityId);
@@ -0,0 +1,188 @@
+#include "BodyIntegrator.h"
+#include "SimdFloat.h"
+#include "../../managers/jobmanager/JobSystem.h"
+#include <algorithm>
+
+namespace cpu_physics {
+
+namespace {
+
+using simd::FloatW;
+
+// Pointers to simd::WIDTH consecutive bodies in every integrated array
+struct BodyLanes {
+    float* velocity[3];
+    float* position[3];
+    float* angularVelocity[3];
+    float* rotation[4];
+    const float* gravityScale;
+    const float* motionMask;
+    const float* halfExtent[3];
+    float* aabbMin[3];
+    float* aabbMax[3];
+    const float* timeScale;
+};
+
+// Picks b where mask is 1 and a where it is 0, exactly for both
+inline FloatW blend(FloatW a, FloatW b, FloatW mask) {
+    return b * mask + a * (FloatW::splat(1.0f) - mask);
+}
+
+void integrateLanes(const BodyLanes& lanes, const float gravity[3], float damping, float deltaTime) {
+    const FloatW dt = FloatW::splat(deltaTime) * FloatW::loadUnaligned(lanes.timeScale);
+    const FloatW damp = FloatW::splat(damping);
+    const FloatW mask = FloatW::loadUnaligned(lanes.motionMask);
+    const FloatW gravityScale = FloatW::loadUnaligned(lanes.gravityScale);
+
+    // Gravity, damping and position
+    FloatW position[3];
+    for (int axis = 0; axis < 3; axis++) {
+        FloatW velocity = FloatW::loadUnaligned(lanes.velocity[axis]);
+        FloatW accelerated = (velocity + FloatW::splat(gravity[axis]) * gravityScale * dt) * damp;
+        velocity = blend(velocity, accelerated, mask);
+        velocity.storeUnaligned(lanes.velocity[axis]);
+
+        position[axis] = FloatW::loadUnaligned(lanes.position[axis]);
+        position[axis] = blend(position[axis], position[axis] + velocity * dt, mask);
+        position[axis].storeUnaligned(lanes.position[axis]);
+    }
+
+    // Angular damping
+    FloatW angular[3];
+    for (int axis = 0; axis < 3; axis++) {
+        angular[axis] = FloatW::loadUnaligned(lanes.angularVelocity[axis]);
+        angular[axis] = blend(angular[axis], angular[axis] * damp, mask);
+        angular[axis].storeUnaligned(lanes.angularVelocity[axis]);
+    }
+
+    // Orientation: q += 0.5 * dt * (0, w) * q, then renormalize
+    FloatW qw = FloatW::loadUnaligned(lanes.rotation[0]);
+    FloatW qx = FloatW::loadUnaligned(lanes.rotation[1]);
+    FloatW qy = FloatW::loadUnaligned(lanes.rotation[2]);
+    FloatW qz = FloatW::loadUnaligned(lanes.rotation[3]);
+    const FloatW halfDt = FloatW::splat(0.5f) * dt;
+    const FloatW& wx = angular[0];
+    const FloatW& wy = angular[1];
+    const FloatW& wz = angular[2];
+
+    FloatW nw = qw - halfDt * (wx * qx + wy * qy + wz * qz);
+    FloatW nx = qx + halfDt * (wx * qw + wy * qz - wz * qy);
+    FloatW ny = qy + halfDt * (wy * qw + wz * qx - wx * qz);
+    FloatW nz = qz + halfDt * (wz * qw + wx * qy - wy * qx);
+    FloatW length = sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+    blend(qw, nw / length, mask).storeUnaligned(lanes.rotation[0]);
+    blend(qx, nx / length, mask).storeUnaligned(lanes.rotation[1]);
+    blend(qy, ny / length, mask).storeUnaligned(lanes.rotation[2]);
+    blend(qz, nz / length, mask).storeUnaligned(lanes.rotation[3]);
+
+    // World AABBs from the new positions
+    for (int axis = 0; axis < 3; axis++) {
+        FloatW halfExtent = FloatW::loadUnaligned(lanes.halfExtent[axis]);
+        (position[axis] - halfExtent).storeUnaligned(lanes.aabbMin[axis]);
+        (position[axis] + halfExtent).storeUnaligned(lanes.aabbMax[axis]);
+    }
+}
+
+BodyLanes lanesAt(SolverBodies& bodies, size_t index) {
+    BodyLanes lanes;
+    lanes.velocity[0] = bodies.velocityX.data() + index;
+    lanes.velocity[1] = bodies.velocityY.data() + index;
+    lanes.velocity[2] = bodies.velocityZ.data() + index;
+    lanes.position[0] = bodies.positionX.data() + index;
+    lanes.position[1] = bodies.positionY.data() + index;
+    lanes.position[2] = bodies.positionZ.data() + index;
+    lanes.angularVelocity[0] = bodies.angularVelocityX.data() + index;
+    lanes.angularVelocity[1] = bodies.angularVelocityY.data() + index;
+    lanes.angularVelocity[2] = bodies.angularVelocityZ.data() + index;
+    lanes.rotation[0] = bodies.rotationW.data() + index;
+    lanes.rotation[1] = bodies.rotationX.data() + index;
+    lanes.rotation[2] = bodies.rotationY.data() + index;
+    lanes.rotation[3] = bodies.rotationZ.data() + index;
+    lanes.gravityScale = bodies.gravityScale.data() + index;
+    lanes.motionMask = bodies.motionMask.data() + index;
+    lanes.halfExtent[0] = bodies.halfExtentX.data() + index;
+    lanes.halfExtent[1] = bodies.halfExtentY.data() + index;
+    lanes.halfExtent[2] = bodies.halfExtentZ.data() + index;
+    lanes.aabbMin[0] = bodies.aabbMinX.data() + index;
+    lanes.aabbMin[1] = bodies.aabbMinY.data() + index;
+    lanes.aabbMin[2] = bodies.aabbMinZ.data() + index;
+    lanes.aabbMax[0] = bodies.aabbMaxX.data() + index;
+    lanes.aabbMax[1] = bodies.aabbMaxY.data() + index;
+    lanes.aabbMax[2] = bodies.aabbMaxZ.data() + index;
+    lanes.timeScale = bodies.timeScale.data() + index;
+    return lanes;
+}
+
+} // namespace
+
+void BodyIntegrator::integrate(SolverBodies& bodies, const float gravity[3], float deltaTime) const {
+    size_t count = bodies.size();
+    if (jobSystem && count >= parallelThreshold) {
+        jobSystem->parallelFor(count, parallelThreshold / 4, [&](size_t begin, size_t end) {
+            integrateRange(bodies, begin, end, gravity, deltaTime);
+        });
+    } else {
+        integrateRange(bodies, 0, count, gravity, deltaTime);
+    }
+}
+
+void BodyIntegrator::integrateRange(SolverBodies& bodies, size_t begin, size_t end,
+                                    const float gravity[3], float deltaTime) const {
+    size_t index = begin;
+    for (; index + simd::WIDTH <= end; index += simd::WIDTH) {
+        integrateLanes(lanesAt(bodies, index), gravity, damping, deltaTime);
+    }
+    if (index == end) {
+        return;
+    }
+
+    // Partial tail: run the same kernel on a padded copy so results match the full lanes
+    constexpr int ARRAY_COUNT = 25;
+    alignas(32) float tail[ARRAY_COUNT][simd::WIDTH] = {};
+    BodyLanes source = lanesAt(bodies, index);
+    float* sourceArrays[ARRAY_COUNT] = {
+        source.velocity[0], source.velocity[1], source.velocity[2],
+        source.position[0], source.position[1], source.position[2],
+        source.angularVelocity[0], source.angularVelocity[1], source.angularVelocity[2],
+        source.rotation[0], source.rotation[1], source.rotation[2], source.rotation[3],
+        const_cast<float*>(source.gravityScale), const_cast<float*>(source.motionMask),
+        const_cast<float*>(source.halfExtent[0]), const_cast<float*>(source.halfExtent[1]),
+        const_cast<float*>(source.halfExtent[2]),
+        source.aabbMin[0], source.aabbMin[1], source.aabbMin[2],
+        source.aabbMax[0], source.aabbMax[1], source.aabbMax[2],
+        const_cast<float*>(source.timeScale)
+    };
+    size_t remaining = end - index;
+    for (int array = 0; array < ARRAY_COUNT; array++) {
+        std::copy(sourceArrays[array], sourceArrays[array] + remaining, tail[array]);
+    }
+    std::fill(tail[9] + remaining, tail[9] + simd::WIDTH, 1.0f); // identity rotation in padding lanes
+
+    BodyLanes padded = {
+        {tail[0], tail[1], tail[2]}, {tail[3], tail[4], tail[5]}, {tail[6], tail[7], tail[8]},
+        {tail[9], tail[10], tail[11], tail[12]}, tail[13], tail[14], {tail[15], tail[16], tail[17]},
+        {tail[18], tail[19], tail[20]}, {tail[21], tail[22], tail[23]}, tail[24]
+    };
+    integrateLanes(padded, gravity, damping, deltaTime);
+
+    for (int array = 0; array < ARRAY_COUNT; array++) {
+        // Gravity scale, motion mask, half extents (13-17) and time scale (24) are inputs only
+        if ((array >= 13 && array <= 17) || array == 24) {
+            continue;
+        }
+        std::copy(tail[array], tail[array] + remaining, sourceArrays[array]);
+    }
+}
+
+void BodyIntegrator::updateBounds(SolverBodies& bodies) {
+    for (size_t i = 0; i < bodies.size(); i++) {
+        bodies.aabbMinX[i] = bodies.positionX[i] - bodies.halfExtentX[i];
+        bodies.aabbMinY[i] = bodies.positionY[i] - bodies.halfExtentY[i];
+        bodies.aabbMinZ[i] = bodies.positionZ[i] - bodies.halfExtentZ[i];
+        bodies.aabbMaxX[i] = bodies.positionX[i] + bodies.halfExtentX[i];
+        bodies.aabbMaxY[i] = bodies.positionY[i] + bodies.halfExtentY[i];
+        bodies.aabbMaxZ[i] = bodies.positionZ[i] + bodies.halfExtentZ[i];
+    }
+}
+
+} // namespace cpu_physics
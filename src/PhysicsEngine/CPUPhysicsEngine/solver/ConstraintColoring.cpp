@@ -0,0 +1,75 @@
+#include "ConstraintColoring.h"
+#include <algorithm>
+#include <bit>
+
+namespace cpu_physics {
+
+namespace {
+constexpr uint8_t OVERFLOW_COLOR = 0xFF;
+}
+
+void ConstraintColoring::build(const std::vector<ContactConstraint>& constraints, const SolverBodies& bodies) {
+    clear();
+
+    bodyColorMasks.assign(bodies.size(), 0);
+    constraintColors.resize(constraints.size());
+    colorCounts.assign(MAX_COLORS + 1, 0);
+
+    uint32_t usedColors = 0;
+
+    // Greedy coloring: pick the lowest color not yet used by either dynamic body
+    for (size_t i = 0; i < constraints.size(); i++) {
+        const auto& constraint = constraints[i];
+        bool dynamicA = bodies.isDynamic(constraint.bodyA);
+        bool dynamicB = bodies.isDynamic(constraint.bodyB);
+
+        uint64_t usedMask = 0;
+        if (dynamicA) usedMask |= bodyColorMasks[constraint.bodyA];
+        if (dynamicB) usedMask |= bodyColorMasks[constraint.bodyB];
+
+        if (usedMask == ~uint64_t(0)) {
+            constraintColors[i] = OVERFLOW_COLOR;
+            colorCounts[MAX_COLORS]++;
+            continue;
+        }
+
+        uint32_t color = static_cast<uint32_t>(std::countr_one(usedMask));
+        uint64_t colorBit = uint64_t(1) << color;
+        if (dynamicA) bodyColorMasks[constraint.bodyA] |= colorBit;
+        if (dynamicB) bodyColorMasks[constraint.bodyB] |= colorBit;
+
+        constraintColors[i] = static_cast<uint8_t>(color);
+        colorCounts[color]++;
+        usedColors = std::max(usedColors, color + 1);
+    }
+
+    // Prefix sums give each color its slice of the order array
+    colorOffsets.resize(usedColors + 1);
+    colorOffsets[0] = 0;
+    for (uint32_t color = 0; color < usedColors; color++) {
+        colorOffsets[color + 1] = colorOffsets[color] + colorCounts[color];
+    }
+    overflowBegin = colorOffsets[usedColors];
+
+    // Counting sort keeps constraints in their original relative order per color
+    std::vector<size_t>& cursors = colorCounts;
+    for (uint32_t color = 0; color < usedColors; color++) {
+        cursors[color] = colorOffsets[color];
+    }
+    cursors[MAX_COLORS] = overflowBegin;
+
+    order.resize(constraints.size());
+    for (size_t i = 0; i < constraints.size(); i++) {
+        uint8_t color = constraintColors[i];
+        size_t slot = (color == OVERFLOW_COLOR) ? cursors[MAX_COLORS]++ : cursors[color]++;
+        order[slot] = static_cast<uint32_t>(i);
+    }
+}
+
+void ConstraintColoring::clear() {
+    order.clear();
+    colorOffsets.clear();
+    overflowBegin = 0;
+}
+
+} // namespace cpu_physics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ContactConstraint.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cpu_physics {
+
+/**
+ * Partitions contact constraints into independent batches (colors).
+ *
+ * No two constraints inside a color touch the same dynamic body, so every
+ * constraint of a color can be solved concurrently without locks on body
+ * velocities. Static bodies are never written by the solver and therefore
+ * do not create conflicts.
+ *
+ * Coloring is greedy with one 64-bit color mask per body. Constraints that
+ * cannot be placed in any of the 64 colors end up in a trailing overflow
+ * batch that must be solved serially.
+ */
+class ConstraintColoring {
+public:
+    static constexpr uint32_t MAX_COLORS = 64;
+
+    void build(const std::vector<ContactConstraint>& constraints, const SolverBodies& bodies);
+    void clear();
+
+    // Number of parallel colors (excludes the overflow batch)
+    size_t getColorCount() const { return colorOffsets.empty() ? 0 : colorOffsets.size() - 1; }
+
+    // Constraint index range [first, second) into getOrder() for a color
+    std::pair<size_t, size_t> getColorRange(size_t color) const {
+        return {colorOffsets[color], colorOffsets[color + 1]};
+    }
+
+    // Constraints that did not fit any color, solved serially after the colors
+    std::pair<size_t, size_t> getOverflowRange() const {
+        return {overflowBegin, order.size()};
+    }
+
+    // Constraint indices grouped by color
+    const std::vector<uint32_t>& getOrder() const { return order; }
+
+private:
+    std::vector<uint32_t> order;
+    std::vector<size_t> colorOffsets;
+    size_t overflowBegin = 0;
+
+    // Scratch buffers reused between builds
+    std::vector<uint64_t> bodyColorMasks;
+    std::vector<uint8_t> constraintColors;
+    std::vector<size_t> colorCounts;
+};
+
+} // namespace cpu_physics
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cpu_physics {
+
+/**
+ * Structure-of-arrays view of the bodies taking part in a step.
+ *
+ * Bodies are gathered from the ECS PhysicsComponent/TransformComponent pools
+ * once per step so the integrator and solver work on contiguous arrays
+ * instead of per-contact hash map lookups. An inverse mass of zero marks a
+ * static (or sleeping) body; the solver never writes to such bodies, and the
+ * integrator leaves bodies with a zero motion mask untouched.
+ */
+struct SolverBodies {
+    std::vector<float> velocityX, velocityY, velocityZ;
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> invMass;
+
+    // Integrator state
+    std::vector<float> angularVelocityX, angularVelocityY, angularVelocityZ;
+    std::vector<float> rotationW, rotationX, rotationY, rotationZ;
+    std::vector<float> gravityScale; // 1 if the body uses gravity, else 0
+    std::vector<float> motionMask;   // 1 for awake dynamic bodies, 0 for static/sleeping
+    std::vector<float> timeScale;    // multiplies the step's dt (bodies stepped at a reduced rate)
+
+    // Collider half extents and the world AABB cached by the integrator
+    std::vector<float> halfExtentX, halfExtentY, halfExtentZ;
+    std::vector<float> aabbMinX, aabbMinY, aabbMinZ;
+    std::vector<float> aabbMaxX, aabbMaxY, aabbMaxZ;
+
+    size_t size() const { return invMass.size(); }
+
+    void clear() {
+        velocityX.clear(); velocityY.clear(); velocityZ.clear();
+        positionX.clear(); positionY.clear(); positionZ.clear();
+        invMass.clear();
+        angularVelocityX.clear(); angularVelocityY.clear(); angularVelocityZ.clear();
+        rotationW.clear(); rotationX.clear(); rotationY.clear(); rotationZ.clear();
+        gravityScale.clear(); motionMask.clear(); timeScale.clear();
+        halfExtentX.clear(); halfExtentY.clear(); halfExtentZ.clear();
+        aabbMinX.clear(); aabbMinY.clear(); aabbMinZ.clear();
+        aabbMaxX.clear(); aabbMaxY.clear(); aabbMaxZ.clear();
+    }
+
+    // Adds a body with no rotation, no extents and gravity off; the caller
+    // fills in the integrator fields it needs by index
+    uint32_t add(const float* velocity, const float* position, float inverseMass) {
+        velocityX.push_back(velocity[0]);
+        velocityY.push_back(velocity[1]);
+        velocityZ.push_back(velocity[2]);
+        positionX.push_back(position[0]);
+        positionY.push_back(position[1]);
+        positionZ.push_back(position[2]);
+        invMass.push_back(inverseMass);
+
+        angularVelocityX.push_back(0.0f);
+        angularVelocityY.push_back(0.0f);
+        angularVelocityZ.push_back(0.0f);
+        rotationW.push_back(1.0f);
+        rotationX.push_back(0.0f);
+        rotationY.push_back(0.0f);
+        rotationZ.push_back(0.0f);
+        gravityScale.push_back(0.0f);
+        motionMask.push_back(inverseMass > 0.0f ? 1.0f : 0.0f);
+        timeScale.push_back(1.0f);
+
+        halfExtentX.push_back(0.0f);
+        halfExtentY.push_back(0.0f);
+        halfExtentZ.push_back(0.0f);
+        aabbMinX.push_back(position[0]);
+        aabbMinY.push_back(position[1]);
+        aabbMinZ.push_back(position[2]);
+        aabbMaxX.push_back(position[0]);
+        aabbMaxY.push_back(position[1]);
+        aabbMaxZ.push_back(position[2]);
+        return static_cast<uint32_t>(invMass.size() - 1);
+    }
+
+    bool isDynamic(uint32_t body) const { return invMass[body] > 0.0f; }
+};
+
+/**
+ * Non-penetration constraint between two solver bodies.
+ *
+ * The normal points from body B towards body A. The accumulated impulse is
+ * clamped to stay non-negative across solver iterations.
+ */
+struct ContactConstraint {
+    uint32_t bodyA = 0;
+    uint32_t bodyB = 0;
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float penetrationDepth = 0.0f;
+    float restitution = 0.0f;
+
+    // Filled in by ContactSolver::prepareConstraint()
+    float normalMass = 0.0f;
+    float velocityBias = 0.0f;
+    float accumulatedImpulse = 0.0f;
+};
+
+} // namespace cpu_physics
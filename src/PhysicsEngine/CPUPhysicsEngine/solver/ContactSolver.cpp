@@ -0,0 +1,320 @@
+#include "ContactSolver.h"
+#include "../../managers/jobmanager/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace cpu_physics {
+
+void ContactSolver::solve(SolverBodies& bodies, std::vector<ContactConstraint>& constraints) {
+    if (constraints.empty()) {
+        return;
+    }
+
+    for (auto& constraint : constraints) {
+        prepareConstraint(bodies, constraint);
+    }
+    coloring.build(constraints, bodies);
+
+    // Push overlapping bodies apart once, then iterate on velocities
+    forEachColor([&bodies, &constraints](uint32_t index) {
+        correctPosition(bodies, constraints[index]);
+    });
+
+    if (mode == SolverMode::SIMD) {
+        buildBatches(bodies, constraints);
+        for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+            solveBatches(bodies, constraints);
+        }
+        storeBatchImpulses(constraints);
+        return;
+    }
+
+    for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+        forEachColor([&bodies, &constraints](uint32_t index) {
+            solveVelocity(bodies, constraints[index]);
+        });
+    }
+}
+
+void ContactSolver::solveSequential(SolverBodies& bodies, std::vector<ContactConstraint>& constraints,
+                                    const uint32_t* constraintIndices, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        prepareConstraint(bodies, constraints[constraintIndices[i]]);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        correctPosition(bodies, constraints[constraintIndices[i]]);
+    }
+
+    for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+        for (size_t i = 0; i < count; i++) {
+            solveVelocity(bodies, constraints[constraintIndices[i]]);
+        }
+    }
+}
+
+float ContactSolver::computeResidual(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints) {
+    float residual = 0.0f;
+    for (const auto& constraint : constraints) {
+        if (constraint.normalMass <= 0.0f) {
+            continue;
+        }
+        float relativeNormalVelocity =
+            (bodies.velocityX[constraint.bodyA] - bodies.velocityX[constraint.bodyB]) * constraint.normal[0] +
+            (bodies.velocityY[constraint.bodyA] - bodies.velocityY[constraint.bodyB]) * constraint.normal[1] +
+            (bodies.velocityZ[constraint.bodyA] - bodies.velocityZ[constraint.bodyB]) * constraint.normal[2];
+        // A contact that is not pushing can only be asked to push harder
+        float error = constraint.velocityBias - relativeNormalVelocity;
+        residual = std::max(residual, constraint.accumulatedImpulse > 0.0f ? std::abs(error) : std::max(error, 0.0f));
+    }
+    return residual;
+}
+
+void ContactSolver::prepareConstraint(const SolverBodies& bodies, ContactConstraint& constraint) {
+    float invMassSum = bodies.invMass[constraint.bodyA] + bodies.invMass[constraint.bodyB];
+    constraint.normalMass = invMassSum > 0.0f ? 1.0f / invMassSum : 0.0f;
+    constraint.accumulatedImpulse = 0.0f;
+
+    // Restitution targets a bounce relative to the approach velocity at the start of the step
+    float relativeNormalVelocity =
+        (bodies.velocityX[constraint.bodyA] - bodies.velocityX[constraint.bodyB]) * constraint.normal[0] +
+        (bodies.velocityY[constraint.bodyA] - bodies.velocityY[constraint.bodyB]) * constraint.normal[1] +
+        (bodies.velocityZ[constraint.bodyA] - bodies.velocityZ[constraint.bodyB]) * constraint.normal[2];
+    constraint.velocityBias = relativeNormalVelocity < 0.0f ? -constraint.restitution * relativeNormalVelocity : 0.0f;
+}
+
+template<typename Func>
+void ContactSolver::forEachColor(Func&& func) {
+    const auto& order = coloring.getOrder();
+
+    auto runRange = [&order, &func](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            func(order[i]);
+        }
+    };
+
+    for (size_t color = 0; color < coloring.getColorCount(); color++) {
+        auto [begin, end] = coloring.getColorRange(color);
+        size_t count = end - begin;
+
+        if (jobSystem && count >= parallelBatchThreshold) {
+            // parallelFor returns once the whole color is done, acting as the barrier
+            jobSystem->parallelFor(count, parallelBatchThreshold / 4,
+                [&runRange, begin](size_t first, size_t last) {
+                    runRange(begin + first, begin + last);
+                });
+        } else {
+            runRange(begin, end);
+        }
+    }
+
+    // Constraints that could not be colored share bodies arbitrarily
+    auto [overflowBegin, overflowEnd] = coloring.getOverflowRange();
+    runRange(overflowBegin, overflowEnd);
+}
+
+void ContactSolver::correctPosition(SolverBodies& bodies, const ContactConstraint& constraint) {
+    float invMassA = bodies.invMass[constraint.bodyA];
+    float invMassB = bodies.invMass[constraint.bodyB];
+    float totalInvMass = invMassA + invMassB;
+    if (totalInvMass <= 0.0f) {
+        return; // Both static
+    }
+
+    // Split the separation by inverse mass so heavier bodies move less
+    float separationA = (invMassA / totalInvMass) * constraint.penetrationDepth * 0.5f;
+    float separationB = (invMassB / totalInvMass) * constraint.penetrationDepth * 0.5f;
+
+    if (invMassA > 0.0f) {
+        bodies.positionX[constraint.bodyA] += constraint.normal[0] * separationA;
+        bodies.positionY[constraint.bodyA] += constraint.normal[1] * separationA;
+        bodies.positionZ[constraint.bodyA] += constraint.normal[2] * separationA;
+    }
+
+    if (invMassB > 0.0f) {
+        bodies.positionX[constraint.bodyB] -= constraint.normal[0] * separationB;
+        bodies.positionY[constraint.bodyB] -= constraint.normal[1] * separationB;
+        bodies.positionZ[constraint.bodyB] -= constraint.normal[2] * separationB;
+    }
+}
+
+void ContactSolver::solveVelocity(SolverBodies& bodies, ContactConstraint& constraint) {
+    uint32_t a = constraint.bodyA;
+    uint32_t b = constraint.bodyB;
+    float invMassA = bodies.invMass[a];
+    float invMassB = bodies.invMass[b];
+
+    float relativeNormalVelocity =
+        (bodies.velocityX[a] - bodies.velocityX[b]) * constraint.normal[0] +
+        (bodies.velocityY[a] - bodies.velocityY[b]) * constraint.normal[1] +
+        (bodies.velocityZ[a] - bodies.velocityZ[b]) * constraint.normal[2];
+
+    float lambda = constraint.normalMass * (constraint.velocityBias - relativeNormalVelocity);
+
+    // Contacts can only push: clamp the accumulated impulse, not the increment
+    float previousImpulse = constraint.accumulatedImpulse;
+    constraint.accumulatedImpulse = std::max(previousImpulse + lambda, 0.0f);
+    lambda = constraint.accumulatedImpulse - previousImpulse;
+
+    // Static bodies are shared between colors, so they must never be written
+    if (invMassA > 0.0f) {
+        bodies.velocityX[a] += lambda * invMassA * constraint.normal[0];
+        bodies.velocityY[a] += lambda * invMassA * constraint.normal[1];
+        bodies.velocityZ[a] += lambda * invMassA * constraint.normal[2];
+    }
+
+    if (invMassB > 0.0f) {
+        bodies.velocityX[b] -= lambda * invMassB * constraint.normal[0];
+        bodies.velocityY[b] -= lambda * invMassB * constraint.normal[1];
+        bodies.velocityZ[b] -= lambda * invMassB * constraint.normal[2];
+    }
+}
+
+void ContactSolver::buildBatches(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints) {
+    const auto& order = coloring.getOrder();
+    batches.clear();
+    colorBatchOffsets.assign(1, 0);
+
+    for (size_t color = 0; color < coloring.getColorCount(); color++) {
+        auto [begin, end] = coloring.getColorRange(color);
+
+        for (size_t first = begin; first < end; first += simd::WIDTH) {
+            ContactBatch& batch = batches.emplace_back();
+            batch.laneCount = static_cast<uint32_t>(std::min<size_t>(simd::WIDTH, end - first));
+
+            for (uint32_t lane = 0; lane < simd::WIDTH; lane++) {
+                if (lane < batch.laneCount) {
+                    uint32_t index = order[first + lane];
+                    const auto& constraint = constraints[index];
+                    batch.constraintIndex[lane] = index;
+                    batch.bodyA[lane] = constraint.bodyA;
+                    batch.bodyB[lane] = constraint.bodyB;
+                    batch.normalX[lane] = constraint.normal[0];
+                    batch.normalY[lane] = constraint.normal[1];
+                    batch.normalZ[lane] = constraint.normal[2];
+                    batch.normalMass[lane] = constraint.normalMass;
+                    batch.velocityBias[lane] = constraint.velocityBias;
+                    batch.accumulatedImpulse[lane] = constraint.accumulatedImpulse;
+                    batch.writeA[lane] = bodies.isDynamic(constraint.bodyA);
+                    batch.writeB[lane] = bodies.isDynamic(constraint.bodyB);
+                } else {
+                    // Padding lanes read a valid body but produce a zero impulse and never write
+                    batch.constraintIndex[lane] = 0;
+                    batch.bodyA[lane] = batch.bodyA[0];
+                    batch.bodyB[lane] = batch.bodyB[0];
+                    batch.normalX[lane] = batch.normalY[lane] = batch.normalZ[lane] = 0.0f;
+                    batch.normalMass[lane] = 0.0f;
+                    batch.velocityBias[lane] = 0.0f;
+                    batch.accumulatedImpulse[lane] = 0.0f;
+                    batch.writeA[lane] = false;
+                    batch.writeB[lane] = false;
+                }
+            }
+        }
+
+        colorBatchOffsets.push_back(batches.size());
+    }
+}
+
+void ContactSolver::solveBatches(SolverBodies& bodies, std::vector<ContactConstraint>& constraints) {
+    auto runRange = [this, &bodies](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            solveVelocityBatch(bodies, batches[i]);
+        }
+    };
+
+    for (size_t color = 0; color + 1 < colorBatchOffsets.size(); color++) {
+        size_t begin = colorBatchOffsets[color];
+        size_t count = colorBatchOffsets[color + 1] - begin;
+
+        if (jobSystem && count * simd::WIDTH >= parallelBatchThreshold) {
+            size_t minBatches = std::max<size_t>(1, parallelBatchThreshold / (4 * simd::WIDTH));
+            jobSystem->parallelFor(count, minBatches,
+                [&runRange, begin](size_t first, size_t last) {
+                    runRange(begin + first, begin + last);
+                });
+        } else {
+            runRange(begin, begin + count);
+        }
+    }
+
+    // The overflow batch may alias bodies, so it stays scalar
+    const auto& order = coloring.getOrder();
+    auto [overflowBegin, overflowEnd] = coloring.getOverflowRange();
+    for (size_t i = overflowBegin; i < overflowEnd; i++) {
+        solveVelocity(bodies, constraints[order[i]]);
+    }
+}
+
+void ContactSolver::storeBatchImpulses(std::vector<ContactConstraint>& constraints) const {
+    for (const auto& batch : batches) {
+        for (uint32_t lane = 0; lane < batch.laneCount; lane++) {
+            constraints[batch.constraintIndex[lane]].accumulatedImpulse = batch.accumulatedImpulse[lane];
+        }
+    }
+}
+
+void ContactSolver::solveVelocityBatch(SolverBodies& bodies, ContactBatch& batch) {
+    using simd::FloatW;
+
+    FloatW velocityAX = simd::gather(bodies.velocityX.data(), batch.bodyA);
+    FloatW velocityAY = simd::gather(bodies.velocityY.data(), batch.bodyA);
+    FloatW velocityAZ = simd::gather(bodies.velocityZ.data(), batch.bodyA);
+    FloatW velocityBX = simd::gather(bodies.velocityX.data(), batch.bodyB);
+    FloatW velocityBY = simd::gather(bodies.velocityY.data(), batch.bodyB);
+    FloatW velocityBZ = simd::gather(bodies.velocityZ.data(), batch.bodyB);
+    FloatW invMassA = simd::gather(bodies.invMass.data(), batch.bodyA);
+    FloatW invMassB = simd::gather(bodies.invMass.data(), batch.bodyB);
+
+    FloatW normalX = FloatW::load(batch.normalX);
+    FloatW normalY = FloatW::load(batch.normalY);
+    FloatW normalZ = FloatW::load(batch.normalZ);
+
+    // Same arithmetic as solveVelocity(), one constraint per lane
+    FloatW relativeNormalVelocity =
+        (velocityAX - velocityBX) * normalX +
+        (velocityAY - velocityBY) * normalY +
+        (velocityAZ - velocityBZ) * normalZ;
+
+    FloatW lambda = FloatW::load(batch.normalMass) * (FloatW::load(batch.velocityBias) - relativeNormalVelocity);
+
+    FloatW previousImpulse = FloatW::load(batch.accumulatedImpulse);
+    FloatW accumulatedImpulse = max(previousImpulse + lambda, FloatW::zero());
+    accumulatedImpulse.store(batch.accumulatedImpulse);
+    lambda = accumulatedImpulse - previousImpulse;
+
+    FloatW impulseA = lambda * invMassA;
+    FloatW impulseB = lambda * invMassB;
+    velocityAX = velocityAX + impulseA * normalX;
+    velocityAY = velocityAY + impulseA * normalY;
+    velocityAZ = velocityAZ + impulseA * normalZ;
+    velocityBX = velocityBX - impulseB * normalX;
+    velocityBY = velocityBY - impulseB * normalY;
+    velocityBZ = velocityBZ - impulseB * normalZ;
+
+    // Scatter back, skipping static bodies and padding lanes
+    alignas(32) float lanes[6][simd::WIDTH];
+    velocityAX.store(lanes[0]);
+    velocityAY.store(lanes[1]);
+    velocityAZ.store(lanes[2]);
+    velocityBX.store(lanes[3]);
+    velocityBY.store(lanes[4]);
+    velocityBZ.store(lanes[5]);
+
+    for (uint32_t lane = 0; lane < simd::WIDTH; lane++) {
+        if (batch.writeA[lane]) {
+            uint32_t a = batch.bodyA[lane];
+            bodies.velocityX[a] = lanes[0][lane];
+            bodies.velocityY[a] = lanes[1][lane];
+            bodies.velocityZ[a] = lanes[2][lane];
+        }
+        if (batch.writeB[lane]) {
+            uint32_t b = batch.bodyB[lane];
+            bodies.velocityX[b] = lanes[3][lane];
+            bodies.velocityY[b] = lanes[4][lane];
+            bodies.velocityZ[b] = lanes[5][lane];
+        }
+    }
+}
+
+} // namespace cpu_physics
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ContactConstraint.h"
+#include "ConstraintColoring.h"
+#include "SimdFloat.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+namespace cpu_physics {
+
+/**
+ * Iterative sequential-impulse contact solver.
+ *
+ * Each step the solver:
+ * - Prepares effective masses and restitution bias for every constraint
+ * - Colors the constraints so independent batches can run concurrently
+ * - Applies positional correction once per constraint
+ * - Runs a fixed number of velocity iterations, color by color
+ *
+ * Colors are dispatched to the job system with a barrier in between, so
+ * the result is identical to a serial solve of the same colored order.
+ *
+ * In SIMD mode the constraints of each color are packed into batches of
+ * simd::WIDTH lanes. Because a color never shares a dynamic body, lanes of
+ * a batch never alias, so body velocities can be gathered, updated in
+ * lockstep and scattered back. Both modes read and write the same
+ * ContactConstraint array and are interchangeable.
+ */
+class ContactSolver {
+public:
+    enum class SolverMode {
+        SCALAR,
+        SIMD
+    };
+
+    ContactSolver() = default;
+    ~ContactSolver() = default;
+
+    void solve(SolverBodies& bodies, std::vector<ContactConstraint>& constraints);
+
+    // Serially solve a subset of constraints in the given order (one island).
+    // Does not touch solver state, so disjoint subsets can be solved concurrently.
+    void solveSequential(SolverBodies& bodies, std::vector<ContactConstraint>& constraints,
+                         const uint32_t* constraintIndices, size_t count) const;
+
+    // Configuration
+    void setIterations(uint32_t iterations) { this->iterations = iterations > 0 ? iterations : 1; }
+    uint32_t getIterations() const { return iterations; }
+    void setJobSystem(std::shared_ptr<JobSystem> jobs) { jobSystem = std::move(jobs); }
+    void setParallelBatchThreshold(size_t threshold) { parallelBatchThreshold = threshold; }
+    void setMode(SolverMode mode) { this->mode = mode; }
+    SolverMode getMode() const { return mode; }
+
+    // Statistics and debugging
+    size_t getLastColorCount() const { return coloring.getColorCount(); }
+    // Largest velocity error another iteration would still correct (m/s), after solving
+    static float computeResidual(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints);
+    const ConstraintColoring& getColoring() const { return coloring; }
+
+private:
+    // SIMD lanes of one color, packed from the shared constraint array
+    struct alignas(32) ContactBatch {
+        uint32_t bodyA[simd::WIDTH];
+        uint32_t bodyB[simd::WIDTH];
+        uint32_t constraintIndex[simd::WIDTH];
+        alignas(32) float normalX[simd::WIDTH];
+        alignas(32) float normalY[simd::WIDTH];
+        alignas(32) float normalZ[simd::WIDTH];
+        alignas(32) float normalMass[simd::WIDTH];
+        alignas(32) float velocityBias[simd::WIDTH];
+        alignas(32) float accumulatedImpulse[simd::WIDTH];
+        bool writeA[simd::WIDTH];
+        bool writeB[simd::WIDTH];
+        uint32_t laneCount;
+    };
+
+    static void prepareConstraint(const SolverBodies& bodies, ContactConstraint& constraint);
+
+    // Run func over every constraint of every color, respecting color barriers
+    template<typename Func>
+    void forEachColor(Func&& func);
+
+    static void correctPosition(SolverBodies& bodies, const ContactConstraint& constraint);
+    static void solveVelocity(SolverBodies& bodies, ContactConstraint& constraint);
+
+    // SIMD path
+    void buildBatches(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints);
+    void solveBatches(SolverBodies& bodies, std::vector<ContactConstraint>& constraints);
+    void storeBatchImpulses(std::vector<ContactConstraint>& constraints) const;
+    static void solveVelocityBatch(SolverBodies& bodies, ContactBatch& batch);
+
+    ConstraintColoring coloring;
+    std::shared_ptr<JobSystem> jobSystem;
+    SolverMode mode = SolverMode::SCALAR;
+
+    std::vector<ContactBatch> batches;
+    std::vector<size_t> colorBatchOffsets;
+
+    uint32_t iterations = 4;
+    size_t parallelBatchThreshold = 256;
+};
+
+} // namespace cpu_physics
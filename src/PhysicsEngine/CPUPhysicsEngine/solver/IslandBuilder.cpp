@@ -0,0 +1,144 @@
+#include "IslandBuilder.h"
+#include <algorithm>
+#include <limits>
+
+namespace cpu_physics {
+
+namespace {
+constexpr uint32_t NO_ISLAND = std::numeric_limits<uint32_t>::max();
+}
+
+void IslandBuilder::build(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints) {
+    const uint32_t bodyCount = static_cast<uint32_t>(bodies.size());
+
+    // Union-find over dynamic bodies; static bodies stay unconnected
+    parents.resize(bodyCount);
+    for (uint32_t body = 0; body < bodyCount; body++) {
+        parents[body] = body;
+    }
+
+    for (const auto& constraint : constraints) {
+        if (!bodies.isDynamic(constraint.bodyA) || !bodies.isDynamic(constraint.bodyB)) {
+            continue;
+        }
+        uint32_t rootA = findRoot(constraint.bodyA);
+        uint32_t rootB = findRoot(constraint.bodyB);
+        if (rootA != rootB) {
+            // Lower index wins so island layout does not depend on union order
+            if (rootA < rootB) parents[rootB] = rootA;
+            else parents[rootA] = rootB;
+        }
+    }
+
+    // Number islands in order of their lowest body index
+    islands.clear();
+    islandOfRoot.assign(bodyCount, NO_ISLAND);
+    for (uint32_t body = 0; body < bodyCount; body++) {
+        if (!bodies.isDynamic(body)) {
+            continue;
+        }
+        uint32_t root = findRoot(body);
+        if (islandOfRoot[root] == NO_ISLAND) {
+            islandOfRoot[root] = static_cast<uint32_t>(islands.size());
+            islands.emplace_back();
+        }
+        islands[islandOfRoot[root]].bodyCount++;
+    }
+
+    constraintIsland.assign(constraints.size(), NO_ISLAND);
+    for (size_t i = 0; i < constraints.size(); i++) {
+        const auto& constraint = constraints[i];
+        uint32_t dynamicBody = bodies.isDynamic(constraint.bodyA) ? constraint.bodyA : constraint.bodyB;
+        if (!bodies.isDynamic(dynamicBody)) {
+            continue; // Static-static contacts have nothing to solve
+        }
+        constraintIsland[i] = islandOfRoot[findRoot(dynamicBody)];
+        islands[constraintIsland[i]].constraintCount++;
+    }
+
+    // Prefix sums turn the counts into ranges
+    uint32_t bodyOffset = 0;
+    uint32_t constraintOffset = 0;
+    for (auto& island : islands) {
+        island.bodyBegin = bodyOffset;
+        island.constraintBegin = constraintOffset;
+        bodyOffset += island.bodyCount;
+        constraintOffset += island.constraintCount;
+        island.bodyCount = 0;
+        island.constraintCount = 0;
+    }
+
+    bodyOrder.resize(bodyOffset);
+    for (uint32_t body = 0; body < bodyCount; body++) {
+        if (!bodies.isDynamic(body)) {
+            continue;
+        }
+        Island& island = islands[islandOfRoot[findRoot(body)]];
+        bodyOrder[island.bodyBegin + island.bodyCount++] = body;
+    }
+
+    constraintOrder.resize(constraintOffset);
+    for (size_t i = 0; i < constraints.size(); i++) {
+        if (constraintIsland[i] == NO_ISLAND) {
+            continue;
+        }
+        Island& island = islands[constraintIsland[i]];
+        constraintOrder[island.constraintBegin + island.constraintCount++] = static_cast<uint32_t>(i);
+    }
+}
+
+void IslandBuilder::packBins(size_t binCount, size_t largeIslandThreshold) {
+    binCount = std::max<size_t>(binCount, 1);
+
+    largeIslands.clear();
+    sortedIslands.clear();
+    for (uint32_t index = 0; index < islands.size(); index++) {
+        if (islands[index].constraintCount > largeIslandThreshold) {
+            largeIslands.push_back(index);
+        } else {
+            sortedIslands.push_back(index);
+        }
+    }
+
+    // Every island costs at least its integration, even without contacts
+    auto islandCost = [this](uint32_t index) -> size_t {
+        return std::max<size_t>(islands[index].constraintCount, 1);
+    };
+
+    std::stable_sort(sortedIslands.begin(), sortedIslands.end(),
+        [&islandCost](uint32_t a, uint32_t b) { return islandCost(a) > islandCost(b); });
+
+    // Longest-processing-time first: each island goes to the least loaded bin
+    binLoads.assign(binCount, 0);
+    binAssignment.resize(sortedIslands.size());
+    for (size_t i = 0; i < sortedIslands.size(); i++) {
+        size_t bin = static_cast<size_t>(std::min_element(binLoads.begin(), binLoads.end()) - binLoads.begin());
+        binLoads[bin] += islandCost(sortedIslands[i]);
+        binAssignment[i] = static_cast<uint32_t>(bin);
+    }
+
+    binOffsets.assign(binCount + 1, 0);
+    for (uint32_t bin : binAssignment) {
+        binOffsets[bin + 1]++;
+    }
+    for (size_t bin = 0; bin < binCount; bin++) {
+        binOffsets[bin + 1] += binOffsets[bin];
+    }
+
+    binIslands.resize(sortedIslands.size());
+    binLoads.assign(binCount, 0); // Reused as fill cursors
+    for (size_t i = 0; i < sortedIslands.size(); i++) {
+        uint32_t bin = binAssignment[i];
+        binIslands[binOffsets[bin] + binLoads[bin]++] = sortedIslands[i];
+    }
+}
+
+uint32_t IslandBuilder::findRoot(uint32_t body) {
+    while (parents[body] != body) {
+        parents[body] = parents[parents[body]];
+        body = parents[body];
+    }
+    return body;
+}
+
+} // namespace cpu_physics
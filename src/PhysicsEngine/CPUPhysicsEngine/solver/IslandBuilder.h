@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ContactConstraint.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cpu_physics {
+
+/**
+ * A set of dynamic bodies connected through contacts.
+ *
+ * Bodies and constraints of an island are stored as ranges into the
+ * builder's body and constraint order arrays. Islands never share a dynamic
+ * body, so they can be solved independently.
+ */
+struct Island {
+    uint32_t bodyBegin = 0;
+    uint32_t bodyCount = 0;
+    uint32_t constraintBegin = 0;
+    uint32_t constraintCount = 0;
+};
+
+/**
+ * Splits the solver bodies into islands after narrowphase and packs them
+ * into work bins for the job system.
+ *
+ * Static bodies never join islands, so a shared ground does not merge every
+ * pile standing on it into one island. Islands above the large-island
+ * threshold are left out of the bins so they can be split further by the
+ * graph-colored solver; the remaining islands are distributed over the bins
+ * by constraint count (largest first, onto the least loaded bin).
+ */
+class IslandBuilder {
+public:
+    void build(const SolverBodies& bodies, const std::vector<ContactConstraint>& constraints);
+    void packBins(size_t binCount, size_t largeIslandThreshold);
+
+    const std::vector<Island>& getIslands() const { return islands; }
+    const std::vector<uint32_t>& getBodyOrder() const { return bodyOrder; }
+    const std::vector<uint32_t>& getConstraintOrder() const { return constraintOrder; }
+
+    // Island indices handled by the colored solver
+    const std::vector<uint32_t>& getLargeIslands() const { return largeIslands; }
+
+    // Island indices per bin, stored as ranges into getBinIslands()
+    size_t getBinCount() const { return binOffsets.empty() ? 0 : binOffsets.size() - 1; }
+    const std::vector<uint32_t>& getBinIslands() const { return binIslands; }
+    const std::vector<size_t>& getBinOffsets() const { return binOffsets; }
+
+private:
+    uint32_t findRoot(uint32_t body);
+
+    std::vector<Island> islands;
+    std::vector<uint32_t> bodyOrder;
+    std::vector<uint32_t> constraintOrder;
+
+    std::vector<uint32_t> largeIslands;
+    std::vector<uint32_t> binIslands;
+    std::vector<size_t> binOffsets;
+
+    // Scratch buffers reused between builds
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> islandOfRoot;
+    std::vector<uint32_t> constraintIsland;
+    std::vector<uint32_t> sortedIslands;
+    std::vector<size_t> binLoads;
+    std::vector<uint32_t> binAssignment;
+};
+
+} // namespace cpu_physics
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TITANIUM_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TITANIUM_SIMD_SSE 1
+#endif
+
+namespace cpu_physics {
+namespace simd {
+
+/**
+ * Minimal fixed-width float vector used by the SIMD solver paths.
+ *
+ * The width is picked at compile time: 8 lanes with AVX, 4 lanes with SSE2,
+ * and a 4-lane scalar fallback elsewhere so the SIMD code paths still build
+ * and produce the same results on other architectures.
+ */
+#if defined(TITANIUM_SIMD_AVX)
+
+constexpr uint32_t WIDTH = 8;
+
+struct FloatW {
+    __m256 v;
+
+    static FloatW zero() { return {_mm256_setzero_ps()}; }
+    static FloatW splat(float value) { return {_mm256_set1_ps(value)}; }
+    static FloatW load(const float* data) { return {_mm256_load_ps(data)}; }
+    static FloatW loadUnaligned(const float* data) { return {_mm256_loadu_ps(data)}; }
+    void store(float* data) const { _mm256_store_ps(data, v); }
+    void storeUnaligned(float* data) const { _mm256_storeu_ps(data, v); }
+
+    friend FloatW operator+(FloatW a, FloatW b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend FloatW operator-(FloatW a, FloatW b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend FloatW operator*(FloatW a, FloatW b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend FloatW operator/(FloatW a, FloatW b) { return {_mm256_div_ps(a.v, b.v)}; }
+    friend FloatW sqrt(FloatW a) { return {_mm256_sqrt_ps(a.v)}; }
+    friend FloatW max(FloatW a, FloatW b) { return {_mm256_max_ps(a.v, b.v)}; }
+    friend FloatW min(FloatW a, FloatW b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend FloatW abs(FloatW a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    // 1.0f in lanes where a < b, 0.0f elsewhere
+    friend FloatW lessMask(FloatW a, FloatW b) {
+        return {_mm256_and_ps(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ), _mm256_set1_ps(1.0f))};
+    }
+};
+
+#elif defined(TITANIUM_SIMD_SSE)
+
+constexpr uint32_t WIDTH = 4;
+
+struct FloatW {
+    __m128 v;
+
+    static FloatW zero() { return {_mm_setzero_ps()}; }
+    static FloatW splat(float value) { return {_mm_set1_ps(value)}; }
+    static FloatW load(const float* data) { return {_mm_load_ps(data)}; }
+    static FloatW loadUnaligned(const float* data) { return {_mm_loadu_ps(data)}; }
+    void store(float* data) const { _mm_store_ps(data, v); }
+    void storeUnaligned(float* data) const { _mm_storeu_ps(data, v); }
+
+    friend FloatW operator+(FloatW a, FloatW b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend FloatW operator-(FloatW a, FloatW b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend FloatW operator*(FloatW a, FloatW b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend FloatW operator/(FloatW a, FloatW b) { return {_mm_div_ps(a.v, b.v)}; }
+    friend FloatW sqrt(FloatW a) { return {_mm_sqrt_ps(a.v)}; }
+    friend FloatW max(FloatW a, FloatW b) { return {_mm_max_ps(a.v, b.v)}; }
+    friend FloatW min(FloatW a, FloatW b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend FloatW abs(FloatW a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+    // 1.0f in lanes where a < b, 0.0f elsewhere
+    friend FloatW lessMask(FloatW a, FloatW b) { return {_mm_and_ps(_mm_cmplt_ps(a.v, b.v), _mm_set1_ps(1.0f))}; }
+};
+
+#else
+
+constexpr uint32_t WIDTH = 4;
+
+struct FloatW {
+    float v[WIDTH];
+
+    static FloatW zero() { return splat(0.0f); }
+    static FloatW splat(float value) {
+        FloatW result;
+        for (uint32_t i = 0; i < WIDTH; i++) result.v[i] = value;
+        return result;
+    }
+    static FloatW load(const float* data) {
+        FloatW result;
+        for (uint32_t i = 0; i < WIDTH; i++) result.v[i] = data[i];
+        return result;
+    }
+    static FloatW loadUnaligned(const float* data) { return load(data); }
+    void store(float* data) const {
+        for (uint32_t i = 0; i < WIDTH; i++) data[i] = v[i];
+    }
+    void storeUnaligned(float* data) const { store(data); }
+
+    friend FloatW operator+(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] += b.v[i]; return a; }
+    friend FloatW operator-(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] -= b.v[i]; return a; }
+    friend FloatW operator*(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] *= b.v[i]; return a; }
+    friend FloatW operator/(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] /= b.v[i]; return a; }
+    friend FloatW sqrt(FloatW a) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] = std::sqrt(a.v[i]); return a; }
+    friend FloatW max(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return a; }
+    friend FloatW min(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return a; }
+    friend FloatW abs(FloatW a) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] = std::fabs(a.v[i]); return a; }
+    // 1.0f in lanes where a < b, 0.0f elsewhere
+    friend FloatW lessMask(FloatW a, FloatW b) { for (uint32_t i = 0; i < WIDTH; i++) a.v[i] = a.v[i] < b.v[i] ? 1.0f : 0.0f; return a; }
+};
+
+#endif
+
+// Load base[indices[lane]] into each lane
+inline FloatW gather(const float* base, const uint32_t* indices) {
+    alignas(32) float lanes[WIDTH];
+    for (uint32_t i = 0; i < WIDTH; i++) {
+        lanes[i] = base[indices[i]];
+    }
+    return FloatW::load(lanes);
+}
+
+} // namespace simd
+} // namespace cpu_physics
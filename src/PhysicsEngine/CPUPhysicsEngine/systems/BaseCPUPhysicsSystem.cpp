@@ -1,5 +1,6 @@
 #include "BaseCPUPhysicsSystem.h"
 #include "../../managers/logmanager/Logger.h"
+#include "../../managers/profilemanager/Profiler.h"
 #include <chrono>
 
 namespace cpu_physics {
@@ -45,6 +46,7 @@ void BaseCPUPhysicsSystem::update(float deltaTime) {
     if (!initialized || !enabled) {
         return;
     }
+    PROFILE_SCOPE("system update");
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -61,6 +63,7 @@ void BaseCPUPhysicsSystem::update(const std::vector<interfaces::CPUPhysicsEntity
     if (!initialized || !enabled) {
         return;
     }
+    PROFILE_SCOPE("system update");
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -1,9 +1,15 @@
 #include "CpuPhysicsCollisionSystem.h"
 #include "../../managers/logmanager/Logger.h"
+#include "../../managers/jobmanager/JobSystem.h"
+#include "../../managers/profilemanager/AllocationTracker.h"
+#include "../../managers/profilemanager/HardwareCounters.h"
+#include "../../managers/profilemanager/Profiler.h"
 #include <cmath>
 #include <algorithm>
+#include <bit>
 #include <chrono>
 #include <functional>
+#include <limits>
 
 namespace cpu_physics {
 
@@ -12,372 +18,821 @@ CPUPhysicsCollisionSystem::CPUPhysicsCollisionSystem(std::shared_ptr<ECSManager>
     LOG_INFO(LogCategory::PHYSICS, "Creating CPU Physics Collision System with ECS integration");
 }
 
-void CPUPhysicsCollisionSystem::update(float deltaTime) {
+void CPUPhysicsCollisionSystem::update(float deltaTime, float budgetMs) {
+    PROFILE_SCOPE("CollisionSystem::update");
     auto startTime = std::chrono::high_resolution_clock::now();
+    auto elapsedMs = [&startTime]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+    };
+    // Time since the previous lap
+    auto lapMs = [&elapsedMs, lapStartMs = 0.0f]() mutable {
+        float nowMs = elapsedMs();
+        float lap = nowMs - lapStartMs;
+        lapStartMs = nowMs;
+        return lap;
+    };
     
-    // Get all entities with the required components for physics
-    auto entities = ecsManager->getEntitiesWithComponent<TransformComponent>();
+    PhysicsStepStats& stats = lastStepStats;
+    stats = PhysicsStepStats{};
     
-    // Filter entities that have all required components (Transform, Physics, Collider)
     std::vector<uint32_t> physicsEntities;
-    for (uint32_t entityId : entities) {
-        if (ecsManager->hasComponent<TransformComponent>(entityId) &&
-            ecsManager->hasComponent<PhysicsComponent>(entityId) &&
-            ecsManager->hasComponent<BoxColliderComponent>(entityId)) {
-            physicsEntities.push_back(entityId);
+    {
+        PROFILE_SCOPE("gather");
+        AllocationPhase allocations("gather");
+        CounterScope counters(stats.gatherCounters);
+        // Get all entities with the required components for physics
+        auto entities = ecsManager->getEntitiesWithComponent<TransformComponent>();
+        
+        // Filter entities that have all required components (Transform, Physics, Collider)
+        for (uint32_t entityId : entities) {
+            if (ecsManager->hasComponent<TransformComponent>(entityId) &&
+                ecsManager->hasComponent<PhysicsComponent>(entityId) &&
+                ecsManager->hasComponent<BoxColliderComponent>(entityId)) {
+                physicsEntities.push_back(entityId);
+            }
+        }
+        
+        // Component pools are hash maps; their iteration order depends on history.
+        // Entity IDs give every replica the same body order, and every later stage
+        // (contact rows, islands, colors) derives its order from the body order.
+        if (deterministic) {
+            std::sort(physicsEntities.begin(), physicsEntities.end());
+        }
+        
+        // Gather bodies into contiguous storage (one component lookup each)
+        gatherBodies(physicsEntities, deltaTime);
+    }
+    stats.gatherMs = lapMs();
+    
+    {
+        PROFILE_SCOPE("integrate");
+        AllocationPhase allocations("integrate");
+        CounterScope counters(stats.integrateCounters);
+        // Fused integration: forces, damping, position, orientation, world AABBs
+        const float gravityVector[3] = {gravity.x, gravity.y, gravity.z};
+        integrator.integrate(solverBodies, gravityVector, deltaTime);
+    }
+    stats.integrateMs = lapMs();
+    
+    {
+        PROFILE_SCOPE("continuous sweep");
+        AllocationPhase allocations("continuous sweep");
+        // Fast flagged bodies stop at their first impact instead of passing through
+        sweepContinuousBodies();
+    }
+    stats.continuousMs = lapMs();
+    
+    {
+        PROFILE_SCOPE("contacts");
+        AllocationPhase allocations("contacts");
+        // Collision detection on the cached AABBs
+        findContacts();
+        promoteLodContacts();
+    }
+    stats.collisionDetectionMs = lapMs();
+    stats.narrowphaseContacts = static_cast<uint32_t>(activeCollisions.size());
+    
+    // First degradation: fit the solver iterations into what is left of the budget
+    const uint32_t configuredIterations = contactSolver.getIterations();
+    StepBudgetStats budgetStats;
+    budgetStats.budgetMs = budgetMs;
+    budgetStats.solverIterations = configuredIterations;
+    if (budgetMs > 0.0f && solveMsPerIteration > 0.0f) {
+        float remainingMs = budgetMs - elapsedMs();
+        if (solveMsPerIteration * configuredIterations > remainingMs) {
+            uint32_t affordable = remainingMs > 0.0f ? static_cast<uint32_t>(remainingMs / solveMsPerIteration) : 0;
+            budgetStats.solverIterations = std::clamp(affordable, std::min(minSolverIterations, configuredIterations),
+                                                      configuredIterations);
+            budgetStats.reducedIterations = budgetStats.solverIterations < configuredIterations;
         }
     }
     
-    // Clear previous collision data
-    activeCollisions.clear();
-    
-    // Physics integration (apply forces, update velocities)
-    for (uint32_t entityId : physicsEntities) {
-        integratePhysics(entityId, deltaTime);
+    // Split into islands and solve them across the job system
+    float solveStartMs = elapsedMs();
+    {
+        PROFILE_SCOPE("solve");
+        AllocationPhase allocations("solve");
+        CounterScope counters(stats.solveCounters);
+        contactSolver.setIterations(budgetStats.solverIterations);
+        solveIslands();
+        contactSolver.setIterations(configuredIterations);
     }
+    if (!contactConstraints.empty()) {
+        float measured = (elapsedMs() - solveStartMs) / static_cast<float>(budgetStats.solverIterations);
+        solveMsPerIteration = solveMsPerIteration > 0.0f ? solveMsPerIteration * 0.75f + measured * 0.25f : measured;
+    }
+    stats.solveMs = lapMs();
+    stats.solverIterations = contactConstraints.empty() ? 0 : budgetStats.solverIterations;
+    stats.solverResidual = ContactSolver::computeResidual(solverBodies, contactConstraints);
+    stats.islands = static_cast<uint32_t>(islandBuilder.getIslands().size());
     
-    // Collision detection
-    if (!physicsEntities.empty()) {
-        detectCollisions(physicsEntities);
+    {
+        PROFILE_SCOPE("continuous advance");
+        AllocationPhase allocations("continuous advance");
+        // Bodies stopped at an impact spend the rest of the step with their resolved velocity
+        advanceContinuousBodies(deltaTime);
     }
+    stats.continuousMs += lapMs();
     
-    // Collision resolution
-    if (!activeCollisions.empty()) {
-        resolveCollisions(deltaTime);
+    {
+        PROFILE_SCOPE("write back");
+        AllocationPhase allocations("write back");
+        CounterScope counters(stats.writeBackCounters);
+        writeBackSolverBodies();
     }
+    stats.writeBackMs = lapMs();
     
-    // Update transforms based on physics
-    for (uint32_t entityId : physicsEntities) {
-        updateTransformFromPhysics(entityId, deltaTime);
+    // Second degradation: postpone the sleep timers (waking still happens) once over budget
+    if (sleepingEnabled) {
+        PROFILE_SCOPE("sleep");
+        AllocationPhase allocations("sleep");
+        budgetStats.deferredSleepChecks = budgetMs > 0.0f && elapsedMs() > budgetMs;
+        updateSleepState(deltaTime, !budgetStats.deferredSleepChecks);
+        stats.sleepMs = lapMs();
     }
     
+    lastStateHash = deterministic ? computeStateHash() : 0;
+    
     // Update statistics
     lastCollisionCount = activeCollisions.size();
     auto endTime = std::chrono::high_resolution_clock::now();
     lastUpdateTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    budgetStats.elapsedMs = lastUpdateTime;
+    stats.totalMs = lastUpdateTime;
+    stats.lodSkippedBodies = static_cast<uint32_t>(lastLodSkippedCount);
+    lodStepIndex = (lodStepIndex + 1) % LOD_MAX_PERIOD;
+    lastBudgetStats = budgetStats;
     
     if (physicsEntities.size() > 0) {
-        LOG_DEBUG(LogCategory::PHYSICS, 
-            "Collision system update: " + std::to_string(physicsEntities.size()) + 
-            " entities, " + std::to_string(lastCollisionCount) + 
-            " collisions, " + std::to_string(lastUpdateTime) + "ms");
+        LOG_DEBUG(LogCategory::PHYSICS, "Collision system update: {} entities, {} collisions, {:.3f}ms",
+                  physicsEntities.size(), lastCollisionCount, lastUpdateTime);
     }
 }
 
 void CPUPhysicsCollisionSystem::detectCollisions(const std::vector<uint32_t>& entities) {
-    std::vector<std::pair<uint32_t, uint32_t>> candidatePairs;
+    lastStepStats = PhysicsStepStats{};
+    gatherBodies(entities);
+    BodyIntegrator::updateBounds(solverBodies);
+    findContacts();
+}
+
+void CPUPhysicsCollisionSystem::findContacts() {
+    activeCollisions.clear();
+    
+    uint32_t bodyCount = static_cast<uint32_t>(solverBodies.size());
+    size_t chunkCount = (bodyCount + CONTACT_ROWS_PER_CHUNK - 1) / CONTACT_ROWS_PER_CHUNK;
+    if (contactChunks.size() < chunkCount) {
+        contactChunks.resize(chunkCount);
+    }
     
-    if (broadPhaseEnabled) {
-        candidatePairs = broadPhaseDetection(entities);
+    auto findChunks = [this, bodyCount](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; chunk++) {
+            uint32_t rowBegin = static_cast<uint32_t>(chunk * CONTACT_ROWS_PER_CHUNK);
+            uint32_t rowEnd = std::min(rowBegin + CONTACT_ROWS_PER_CHUNK, bodyCount);
+            findContactsInRows(rowBegin, rowEnd, contactChunks[chunk]);
+        }
+    };
+    
+    if (jobSystem && bodyCount >= parallelContactThreshold) {
+        jobSystem->parallelFor(chunkCount, 1, findChunks);
     } else {
-        // Brute force - test all pairs
-        for (size_t i = 0; i < entities.size(); i++) {
-            for (size_t j = i + 1; j < entities.size(); j++) {
-                candidatePairs.emplace_back(entities[i], entities[j]);
+        findChunks(0, chunkCount);
+    }
+    
+    // Concatenate in row order so the contact order does not depend on scheduling
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        const ContactChunk& found = contactChunks[chunk];
+        activeCollisions.insert(activeCollisions.end(), found.contacts.begin(), found.contacts.end());
+        lastStepStats.broadphasePairsTested += found.pairsTested;
+        lastStepStats.broadphasePairsEmitted += found.candidates.size();
+        lastStepStats.layerFilteredPairs += found.layerFilteredPairs;
+        lastStepStats.broadphaseMs += found.broadphaseMs;
+        lastStepStats.narrowphaseMs += found.narrowphaseMs;
+        lastStepStats.broadphaseCounters += found.broadphaseCounters;
+        lastStepStats.narrowphaseCounters += found.narrowphaseCounters;
+    }
+}
+
+void CPUPhysicsCollisionSystem::findContactsInRows(uint32_t rowBegin, uint32_t rowEnd, ContactChunk& chunk) const {
+    chunk.candidates.clear();
+    chunk.contacts.clear();
+    chunk.layerFilteredPairs = 0;
+    chunk.broadphaseCounters = HardwareCounterValues{};
+    chunk.narrowphaseCounters = HardwareCounterValues{};
+    
+    uint32_t bodyCount = static_cast<uint32_t>(solverBodies.size());
+    auto broadphaseStart = std::chrono::high_resolution_clock::now();
+    {
+        PROFILE_SCOPE("broadphase");
+        AllocationPhase allocations("broadphase");
+        CounterScope counters(chunk.broadphaseCounters);
+        for (uint32_t i = rowBegin; i < rowEnd; i++) {
+            for (uint32_t j = i + 1; j < bodyCount; j++) {
+                // AABB overlap on the cached bounds (brute force tests every pair)
+                if (broadPhaseEnabled && !aabbOverlap(i, j)) {
+                    continue;
+                }
+                if (!canBodiesCollide(i, j)) {
+                    chunk.layerFilteredPairs++;
+                    continue;
+                }
+                // A body held still by the LOD cannot be promoted by a static one
+                if ((bodyLodSkipped[i] && !bodyLodSkipped[j] && !solverBodies.isDynamic(j)) ||
+                    (bodyLodSkipped[j] && !bodyLodSkipped[i] && !solverBodies.isDynamic(i))) {
+                    continue;
+                }
+                chunk.candidates.emplace_back(i, j);
             }
         }
     }
+    // Every row tests the bodies after it
+    uint64_t rows = rowEnd - rowBegin;
+    chunk.pairsTested = rows * (bodyCount - rowBegin) - rows * (rows + 1) / 2;
+    auto narrowphaseStart = std::chrono::high_resolution_clock::now();
     
-    // Narrow phase detection
-    for (const auto& pair : candidatePairs) {
-        if (canEntitiesCollide(pair.first, pair.second)) {
+    {
+        PROFILE_SCOPE("narrowphase");
+        AllocationPhase allocations("narrowphase");
+        CounterScope counters(chunk.narrowphaseCounters);
+        for (const auto& [a, b] : chunk.candidates) {
             CollisionPair collision;
-            if (narrowPhaseDetection(pair.first, pair.second, collision)) {
-                activeCollisions.push_back(collision);
+            if (narrowPhaseDetection(a, b, collision)) {
+                chunk.contacts.push_back(collision);
             }
         }
     }
+    
+    auto narrowphaseEnd = std::chrono::high_resolution_clock::now();
+    chunk.broadphaseMs = std::chrono::duration<float, std::milli>(narrowphaseStart - broadphaseStart).count();
+    chunk.narrowphaseMs = std::chrono::duration<float, std::milli>(narrowphaseEnd - narrowphaseStart).count();
 }
 
-void CPUPhysicsCollisionSystem::resolveCollisions(float deltaTime) {
-    for (const auto& collision : activeCollisions) {
-        if (collisionResponseEnabled) {
-            resolveCollision(collision);
-        }
+void CPUPhysicsCollisionSystem::resolveCollisions(float /*deltaTime*/) {
+    if (!collisionResponseEnabled) {
+        return;
     }
+    
+    // Bodies were gathered by detectCollisions()
+    buildContactConstraints();
+    
+    contactSolver.solve(solverBodies, contactConstraints);
+    
+    writeBackSolverBodies();
 }
 
-void CPUPhysicsCollisionSystem::setLayerInteractionCallback(
-    std::function<bool(uint32_t, uint32_t)> canLayersInteractCallback) {
-    canLayersInteract = canLayersInteractCallback;
-}
-
-void CPUPhysicsCollisionSystem::setGravity(float x, float y, float z) {
-    gravity.x = x;
-    gravity.y = y;
-    gravity.z = z;
-    
-    LOG_INFO(LogCategory::PHYSICS, 
-        "Collision system gravity set to (" + 
-        std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
+void CPUPhysicsCollisionSystem::setJobSystem(std::shared_ptr<JobSystem> jobs) {
+    jobSystem = jobs;
+    integrator.setJobSystem(jobs);
+    contactSolver.setJobSystem(std::move(jobs));
 }
 
-std::vector<uint32_t> CPUPhysicsCollisionSystem::getCollidingEntities(uint32_t entityId) const {
-    std::vector<uint32_t> colliding;
+void CPUPhysicsCollisionSystem::buildContactConstraints() {
+    contactConstraints.clear();
+    if (!collisionResponseEnabled) {
+        return;
+    }
+    contactConstraints.reserve(activeCollisions.size());
     
     for (const auto& collision : activeCollisions) {
-        if (collision.entityA == entityId) {
-            colliding.push_back(collision.entityB);
-        } else if (collision.entityB == entityId) {
-            colliding.push_back(collision.entityA);
+        ContactConstraint constraint;
+        constraint.bodyA = collision.bodyA;
+        constraint.bodyB = collision.bodyB;
+        for (int i = 0; i < 3; i++) {
+            constraint.normal[i] = collision.normal[i];
         }
+        constraint.penetrationDepth = collision.penetrationDepth;
+        constraint.restitution = std::min(bodyRestitution[collision.bodyA], bodyRestitution[collision.bodyB]);
+        contactConstraints.push_back(constraint);
     }
-    
-    return colliding;
 }
 
-bool CPUPhysicsCollisionSystem::areEntitiesColliding(uint32_t entityA, uint32_t entityB) const {
-    for (const auto& collision : activeCollisions) {
-        if ((collision.entityA == entityA && collision.entityB == entityB) ||
-            (collision.entityA == entityB && collision.entityB == entityA)) {
-            return true;
+void CPUPhysicsCollisionSystem::solveIslands() {
+    {
+        PROFILE_SCOPE("build islands");
+        buildContactConstraints();
+        
+        size_t binCount = jobSystem ? (jobSystem->getWorkerCount() + 1) * 2 : 1;
+        islandBuilder.build(solverBodies, contactConstraints);
+        islandBuilder.packBins(binCount, largeIslandThreshold);
+    }
+    
+    // Large islands are split further by the graph-colored solver
+    const auto& islands = islandBuilder.getIslands();
+    for (uint32_t islandIndex : islandBuilder.getLargeIslands()) {
+        solveLargeIsland(islands[islandIndex]);
+    }
+    
+    // Small islands: one bin per task, each solved serially
+    if (jobSystem) {
+        jobSystem->parallelFor(islandBuilder.getBinCount(), 1, [this](size_t begin, size_t end) {
+            for (size_t bin = begin; bin < end; bin++) {
+                solveIslandBin(bin);
+            }
+        });
+    } else {
+        for (size_t bin = 0; bin < islandBuilder.getBinCount(); bin++) {
+            solveIslandBin(bin);
         }
     }
-    return false;
 }
 
-void CPUPhysicsCollisionSystem::integratePhysics(uint32_t entityId, float deltaTime) {
-    auto* physics = ecsManager->getComponent<PhysicsComponent>(entityId);
-    if (!physics || physics->isStatic) {
-        return;
-    }
+void CPUPhysicsCollisionSystem::solveLargeIsland(const Island& island) {
+    PROFILE_SCOPE("solve large island");
+    const auto& constraintOrder = islandBuilder.getConstraintOrder();
     
-    // Apply gravity
-    if (physics->useGravity) {
-        applyGravity(entityId, deltaTime);
+    largeIslandConstraints.clear();
+    for (uint32_t i = 0; i < island.constraintCount; i++) {
+        largeIslandConstraints.push_back(contactConstraints[constraintOrder[island.constraintBegin + i]]);
     }
-    
-    // Apply damping (air resistance)
-    const float damping = 0.99f;
-    for (int i = 0; i < 3; i++) {
-        physics->velocity[i] *= damping;
-        physics->angularVelocity[i] *= damping;
+    contactSolver.solve(solverBodies, largeIslandConstraints);
+    for (uint32_t i = 0; i < island.constraintCount; i++) {
+        contactConstraints[constraintOrder[island.constraintBegin + i]] = largeIslandConstraints[i];
     }
 }
 
-void CPUPhysicsCollisionSystem::applyGravity(uint32_t entityId, float deltaTime) {
-    auto* physics = ecsManager->getComponent<PhysicsComponent>(entityId);
-    if (!physics || physics->isStatic || physics->invMass <= 0.0f) {
-        return;
+void CPUPhysicsCollisionSystem::solveIslandBin(size_t bin) {
+    PROFILE_SCOPE("solve island bin");
+    const auto& islands = islandBuilder.getIslands();
+    const auto& binIslands = islandBuilder.getBinIslands();
+    const auto& binOffsets = islandBuilder.getBinOffsets();
+    const auto& constraintOrder = islandBuilder.getConstraintOrder();
+    
+    for (size_t i = binOffsets[bin]; i < binOffsets[bin + 1]; i++) {
+        const Island& island = islands[binIslands[i]];
+        if (island.constraintCount > 0) {
+            contactSolver.solveSequential(solverBodies, contactConstraints,
+                                          constraintOrder.data() + island.constraintBegin, island.constraintCount);
+        }
     }
+}
+
+void CPUPhysicsCollisionSystem::gatherBodies(const std::vector<uint32_t>& entities, float deltaTime) {
+    solverBodies.clear();
+    solverBodyEntities.clear();
+    bodyRestitution.clear();
+    bodyColliderEnabled.clear();
+    bodyLayers.clear();
+    bodyLodSkipped.clear();
+    bodyLodPeriod.clear();
+    lastLodSkippedCount = 0;
+    continuousSweeps.clear();
     
-    // F = ma, a = F/m, where F is gravity force
-    physics->velocity[0] += gravity.x * deltaTime;
-    physics->velocity[1] += gravity.y * deltaTime;
-    physics->velocity[2] += gravity.z * deltaTime;
+    for (uint32_t entityId : entities) {
+        auto* transform = ecsManager->getComponent<TransformComponent>(entityId);
+        auto* physics = ecsManager->getComponent<PhysicsComponent>(entityId);
+        auto* collider = ecsManager->getComponent<BoxColliderComponent>(entityId);
+        if (!transform || !physics || !collider) {
+            continue;
+        }
+        
+        // Sleeping bodies behave like static ones until they are woken
+        float invMass = (physics->isStatic || physics->isSleeping) ? 0.0f : physics->invMass;
+        if (physics->isStatic || physics->invMass == 0.0f) {
+            lastStepStats.staticBodies++;
+        } else if (physics->isSleeping) {
+            lastStepStats.sleepingBodies++;
+        } else {
+            lastStepStats.awakeBodies++;
+        }
+        uint32_t index = solverBodies.add(physics->velocity, transform->position, invMass);
+        
+        solverBodies.angularVelocityX[index] = physics->angularVelocity[0];
+        solverBodies.angularVelocityY[index] = physics->angularVelocity[1];
+        solverBodies.angularVelocityZ[index] = physics->angularVelocity[2];
+        solverBodies.rotationW[index] = transform->rotation[0];
+        solverBodies.rotationX[index] = transform->rotation[1];
+        solverBodies.rotationY[index] = transform->rotation[2];
+        solverBodies.rotationZ[index] = transform->rotation[3];
+        solverBodies.gravityScale[index] = physics->useGravity ? 1.0f : 0.0f;
+        solverBodies.halfExtentX[index] = collider->width * transform->scale[0] * 0.5f;
+        solverBodies.halfExtentY[index] = collider->height * transform->scale[1] * 0.5f;
+        solverBodies.halfExtentZ[index] = collider->depth * transform->scale[2] * 0.5f;
+        
+        solverBodyEntities.push_back(entityId);
+        bodyRestitution.push_back(physics->restitution);
+        bodyColliderEnabled.push_back(collider->enabled ? 1 : 0);
+        bodyLayers.push_back(collider->layer);
+        
+        // Reduced-rate bodies step on every period-th step with the time they skipped;
+        // the shared phase keeps neighbours at the same rate stepping together
+        uint32_t period = 1;
+        bool skipped = false;
+        if (deltaTime > 0.0f && invMass > 0.0f) {
+            period = selectLodPeriod(transform->position, *physics);
+            physics->lodPendingTime += deltaTime;
+            if (lodStepIndex % period != 0) {
+                skipped = true;
+                solverBodies.invMass[index] = 0.0f;
+                solverBodies.motionMask[index] = 0.0f;
+                lastLodSkippedCount++;
+            } else {
+                solverBodies.timeScale[index] = physics->lodPendingTime / deltaTime;
+                physics->lodPendingTime = 0.0f;
+            }
+        }
+        bodyLodSkipped.push_back(skipped ? 1 : 0);
+        bodyLodPeriod.push_back(static_cast<uint8_t>(period));
+        
+        if (deltaTime > 0.0f && physics->continuousCollision && solverBodies.motionMask[index] > 0.0f) {
+            continuousSweeps.push_back({index, {transform->position[0], transform->position[1], transform->position[2]}, 1.0f});
+        }
+    }
 }
 
-void CPUPhysicsCollisionSystem::updateTransformFromPhysics(uint32_t entityId, float deltaTime) {
-    auto* transform = ecsManager->getComponent<TransformComponent>(entityId);
-    auto* physics = ecsManager->getComponent<PhysicsComponent>(entityId);
+void CPUPhysicsCollisionSystem::sweepContinuousBodies() {
+    lastContinuousHitCount = 0;
+    for (auto& sweep : continuousSweeps) {
+        uint32_t body = sweep.body;
+        float* position[3] = {&solverBodies.positionX[body], &solverBodies.positionY[body], &solverBodies.positionZ[body]};
+        const float halfExtent[3] = {solverBodies.halfExtentX[body], solverBodies.halfExtentY[body], solverBodies.halfExtentZ[body]};
+        
+        // A body that moved less than its half extent on every axis still overlaps
+        // anything it passed, so the discrete test is enough
+        float displacement[3];
+        bool fast = false;
+        for (int axis = 0; axis < 3; axis++) {
+            displacement[axis] = *position[axis] - sweep.start[axis];
+            fast |= std::abs(displacement[axis]) > halfExtent[axis];
+        }
+        
+        float timeOfImpact = 1.0f;
+        int hitAxis = 0;
+        if (!fast || !findTimeOfImpact(body, sweep.start, displacement, timeOfImpact, hitAxis)) {
+            continue;
+        }
+        
+        // Stop just inside the obstacle so the regular pipeline finds and resolves the contact
+        for (int axis = 0; axis < 3; axis++) {
+            *position[axis] = sweep.start[axis] + displacement[axis] * timeOfImpact;
+        }
+        *position[hitAxis] += displacement[hitAxis] > 0.0f ? CONTINUOUS_CONTACT_SLOP : -CONTINUOUS_CONTACT_SLOP;
+        
+        sweep.timeOfImpact = timeOfImpact;
+        lastContinuousHitCount++;
+    }
     
-    if (!transform || !physics || physics->isStatic) {
+    if (lastContinuousHitCount > 0) {
+        BodyIntegrator::updateBounds(solverBodies);
+    }
+}
+
+void CPUPhysicsCollisionSystem::advanceContinuousBodies(float deltaTime) {
+    if (lastContinuousHitCount == 0) {
         return;
     }
     
-    // Update position based on velocity
-    transform->position[0] += physics->velocity[0] * deltaTime;
-    transform->position[1] += physics->velocity[1] * deltaTime;
-    transform->position[2] += physics->velocity[2] * deltaTime;
-    
-    // TODO: Update rotation based on angular velocity (quaternion integration)
+    for (const auto& sweep : continuousSweeps) {
+        if (sweep.timeOfImpact >= 1.0f) {
+            continue;
+        }
+        
+        // Sub-step over the rest of the step, swept again so the body cannot tunnel after bouncing
+        uint32_t body = sweep.body;
+        float remaining = (1.0f - sweep.timeOfImpact) * deltaTime * solverBodies.timeScale[body];
+        const float start[3] = {solverBodies.positionX[body], solverBodies.positionY[body], solverBodies.positionZ[body]};
+        const float displacement[3] = {solverBodies.velocityX[body] * remaining,
+                                       solverBodies.velocityY[body] * remaining,
+                                       solverBodies.velocityZ[body] * remaining};
+        
+        float timeOfImpact = 1.0f;
+        int hitAxis = 0;
+        findTimeOfImpact(body, start, displacement, timeOfImpact, hitAxis);
+        solverBodies.positionX[body] = start[0] + displacement[0] * timeOfImpact;
+        solverBodies.positionY[body] = start[1] + displacement[1] * timeOfImpact;
+        solverBodies.positionZ[body] = start[2] + displacement[2] * timeOfImpact;
+    }
+    BodyIntegrator::updateBounds(solverBodies);
 }
 
-std::vector<std::pair<uint32_t, uint32_t>> CPUPhysicsCollisionSystem::broadPhaseDetection(const std::vector<uint32_t>& entities) {
-    std::vector<std::pair<uint32_t, uint32_t>> candidatePairs;
-    
-    // Simple AABB overlap test for broad phase
-    for (size_t i = 0; i < entities.size(); i++) {
-        for (size_t j = i + 1; j < entities.size(); j++) {
-            uint32_t entityA = entities[i];
-            uint32_t entityB = entities[j];
-            
-            auto* transformA = ecsManager->getComponent<TransformComponent>(entityA);
-            auto* transformB = ecsManager->getComponent<TransformComponent>(entityB);
-            auto* colliderA = ecsManager->getComponent<BoxColliderComponent>(entityA);
-            auto* colliderB = ecsManager->getComponent<BoxColliderComponent>(entityB);
-            
-            if (transformA && transformB && colliderA && colliderB) {
-                AABB aabbA = calculateAABB(*transformA, *colliderA);
-                AABB aabbB = calculateAABB(*transformB, *colliderB);
-                
-                if (aabbOverlap(aabbA, aabbB)) {
-                    candidatePairs.emplace_back(entityA, entityB);
-                }
+bool CPUPhysicsCollisionSystem::findTimeOfImpact(uint32_t body, const float start[3], const float displacement[3],
+                                                 float& timeOfImpact, int& hitAxis) const {
+    const SolverBodies& b = solverBodies;
+    const float halfExtent[3] = {b.halfExtentX[body], b.halfExtentY[body], b.halfExtentZ[body]};
+    const float end[3] = {start[0] + displacement[0], start[1] + displacement[1], start[2] + displacement[2]};
+    float sweptMin[3], sweptMax[3];
+    for (int axis = 0; axis < 3; axis++) {
+        sweptMin[axis] = std::min(start[axis], end[axis]) - halfExtent[axis];
+        sweptMax[axis] = std::max(start[axis], end[axis]) + halfExtent[axis];
+    }
+    
+    bool hit = false;
+    uint32_t bodyCount = static_cast<uint32_t>(b.size());
+    for (uint32_t other = 0; other < bodyCount; other++) {
+        if (other == body || !bodyColliderEnabled[other] || !bodyColliderEnabled[body]) {
+            continue;
+        }
+        
+        // Broad phase: swept AABB against the other body's AABB
+        const float otherMin[3] = {b.aabbMinX[other], b.aabbMinY[other], b.aabbMinZ[other]};
+        const float otherMax[3] = {b.aabbMaxX[other], b.aabbMaxY[other], b.aabbMaxZ[other]};
+        if (sweptMin[0] > otherMax[0] || sweptMax[0] < otherMin[0] ||
+            sweptMin[1] > otherMax[1] || sweptMax[1] < otherMin[1] ||
+            sweptMin[2] > otherMax[2] || sweptMax[2] < otherMin[2]) {
+            continue;
+        }
+        if (!canBodiesCollide(body, other)) {
+            continue;
+        }
+        
+        // Slab test of the centre's path against the other box grown by this body's half extents
+        float entry = 0.0f;
+        float exit = 1.0f;
+        int entryAxis = -1;
+        bool missed = false;
+        for (int axis = 0; axis < 3 && !missed; axis++) {
+            float low = otherMin[axis] - halfExtent[axis];
+            float high = otherMax[axis] + halfExtent[axis];
+            if (displacement[axis] == 0.0f) {
+                missed = start[axis] <= low || start[axis] >= high;
+                continue;
+            }
+            float t0 = (low - start[axis]) / displacement[axis];
+            float t1 = (high - start[axis]) / displacement[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
             }
+            if (t0 > entry) {
+                entry = t0;
+                entryAxis = axis;
+            }
+            exit = std::min(exit, t1);
+            missed = entry >= exit;
+        }
+        
+        // Bodies already overlapping at the start are left to the discrete contact
+        if (missed || entryAxis < 0 || entry >= timeOfImpact) {
+            continue;
         }
+        timeOfImpact = entry;
+        hitAxis = entryAxis;
+        hit = true;
     }
-    
-    return candidatePairs;
+    return hit;
 }
 
-bool CPUPhysicsCollisionSystem::narrowPhaseDetection(uint32_t entityA, uint32_t entityB, CollisionPair& collision) {
-    auto* transformA = ecsManager->getComponent<TransformComponent>(entityA);
-    auto* transformB = ecsManager->getComponent<TransformComponent>(entityB);
-    auto* colliderA = ecsManager->getComponent<BoxColliderComponent>(entityA);
-    auto* colliderB = ecsManager->getComponent<BoxColliderComponent>(entityB);
-    
-    if (!transformA || !transformB || !colliderA || !colliderB) {
-        return false;
+uint32_t CPUPhysicsCollisionSystem::selectLodPeriod(const float* position, PhysicsComponent& physics) const {
+    uint32_t period = 1;
+    if (!focusPoints.empty()) {
+        // Nearest focus point, in weighted distance
+        float nearest = std::numeric_limits<float>::max();
+        for (const auto& point : focusPoints) {
+            float dx = position[0] - point.position[0];
+            float dy = position[1] - point.position[1];
+            float dz = position[2] - point.position[2];
+            nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy + dz * dz) / point.weight);
+        }
+        
+        float distance = physics.lodImportance > 0.0f ? nearest / physics.lodImportance
+                                                      : std::numeric_limits<float>::max();
+        period = distance < lodHalfRateDistance ? 1 : (distance < lodQuarterRateDistance ? 2 : LOD_MAX_PERIOD);
     }
     
-    if (!colliderA->enabled || !colliderB->enabled) {
-        return false;
+    // A recently promoted body keeps the rate of the body that touched it for a while
+    if (physics.lodHoldSteps > 0) {
+        period = std::min(period, physics.lodHoldPeriod);
+        physics.lodHoldSteps--;
     }
-    
-    collision.entityA = entityA;
-    collision.entityB = entityB;
-    
-    return checkBoxBoxCollision(*transformA, *colliderA, *transformB, *colliderB, collision);
+    physics.lodPeriod = period;
+    return period;
 }
 
-bool CPUPhysicsCollisionSystem::checkBoxBoxCollision(
-    const TransformComponent& transformA, const BoxColliderComponent& colliderA,
-    const TransformComponent& transformB, const BoxColliderComponent& colliderB,
-    CollisionPair& collision) {
-    
-    // Calculate half extents
-    float halfExtentsA[3] = {
-        colliderA.width * transformA.scale[0] * 0.5f,
-        colliderA.height * transformA.scale[1] * 0.5f,
-        colliderA.depth * transformA.scale[2] * 0.5f
-    };
-    
-    float halfExtentsB[3] = {
-        colliderB.width * transformB.scale[0] * 0.5f,
-        colliderB.height * transformB.scale[1] * 0.5f,
-        colliderB.depth * transformB.scale[2] * 0.5f
-    };
-    
-    // Calculate distance between centers
-    float distance[3];
-    for (int i = 0; i < 3; i++) {
-        distance[i] = std::abs(transformA.position[i] - transformB.position[i]);
+void CPUPhysicsCollisionSystem::promoteLodContacts() {
+    if (lastLodSkippedCount == 0) {
+        return;
     }
     
-    // Check for separation along each axis
-    float penetration[3];
-    bool colliding = true;
-    
-    for (int i = 0; i < 3; i++) {
-        float totalExtent = halfExtentsA[i] + halfExtentsB[i];
-        if (distance[i] >= totalExtent) {
-            colliding = false;
-            break;
+    // A skipped body touched by a body that moves this step joins the step as a
+    // dynamic body, so momentum is exchanged both ways. Its position catches up
+    // on the next step, which it takes at the toucher's rate. Repeat until no
+    // skipped body touches a promoted one, so whole touching stacks promote.
+    bool promoted = true;
+    while (promoted) {
+        promoted = false;
+        for (const auto& collision : activeCollisions) {
+            uint32_t bodies[2] = {collision.bodyA, collision.bodyB};
+            for (int side = 0; side < 2; side++) {
+                uint32_t body = bodies[side];
+                uint32_t other = bodies[1 - side];
+                if (!bodyLodSkipped[body] || bodyLodSkipped[other] || !solverBodies.isDynamic(other)) {
+                    continue;
+                }
+                
+                auto* physics = ecsManager->getComponent<PhysicsComponent>(solverBodyEntities[body]);
+                physics->lodHoldSteps = lodPromotionSteps;
+                physics->lodHoldPeriod = bodyLodPeriod[other];
+                solverBodies.invMass[body] = physics->invMass;
+                bodyLodSkipped[body] = 0;
+                bodyLodPeriod[body] = bodyLodPeriod[other];
+                lastLodSkippedCount--;
+                promoted = true;
+            }
         }
-        penetration[i] = totalExtent - distance[i];
     }
-    
-    if (!colliding) {
-        return false;
+}
+
+void CPUPhysicsCollisionSystem::addFocusPoint(float x, float y, float z, float weight) {
+    focusPoints.push_back({{x, y, z}, weight > 0.0f ? weight : 1.0f});
+}
+
+void CPUPhysicsCollisionSystem::setLodDistances(float halfRateDistance, float quarterRateDistance) {
+    lodHalfRateDistance = std::max(halfRateDistance, 0.0f);
+    lodQuarterRateDistance = std::max(quarterRateDistance, lodHalfRateDistance);
+}
+
+void CPUPhysicsCollisionSystem::writeBackSolverBodies() {
+    for (uint32_t index = 0; index < solverBodyEntities.size(); index++) {
+        if (!solverBodies.isDynamic(index)) {
+            continue;
+        }
+        
+        uint32_t entityId = solverBodyEntities[index];
+        auto* transform = ecsManager->getComponent<TransformComponent>(entityId);
+        auto* physics = ecsManager->getComponent<PhysicsComponent>(entityId);
+        
+        physics->velocity[0] = solverBodies.velocityX[index];
+        physics->velocity[1] = solverBodies.velocityY[index];
+        physics->velocity[2] = solverBodies.velocityZ[index];
+        physics->angularVelocity[0] = solverBodies.angularVelocityX[index];
+        physics->angularVelocity[1] = solverBodies.angularVelocityY[index];
+        physics->angularVelocity[2] = solverBodies.angularVelocityZ[index];
+        transform->position[0] = solverBodies.positionX[index];
+        transform->position[1] = solverBodies.positionY[index];
+        transform->position[2] = solverBodies.positionZ[index];
+        transform->rotation[0] = solverBodies.rotationW[index];
+        transform->rotation[1] = solverBodies.rotationX[index];
+        transform->rotation[2] = solverBodies.rotationY[index];
+        transform->rotation[3] = solverBodies.rotationZ[index];
     }
+}
+
+uint64_t CPUPhysicsCollisionSystem::computeStateHash() const {
+    // FNV-1a over the exact bit patterns, serially in body order
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint32_t word) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (word >> (byte * 8)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+    const std::vector<float>* arrays[] = {
+        &solverBodies.positionX, &solverBodies.positionY, &solverBodies.positionZ,
+        &solverBodies.rotationW, &solverBodies.rotationX, &solverBodies.rotationY, &solverBodies.rotationZ,
+        &solverBodies.velocityX, &solverBodies.velocityY, &solverBodies.velocityZ,
+        &solverBodies.angularVelocityX, &solverBodies.angularVelocityY, &solverBodies.angularVelocityZ
+    };
     
-    // Find the axis with minimum penetration (separation axis)
-    int minAxis = 0;
-    for (int i = 1; i < 3; i++) {
-        if (penetration[i] < penetration[minAxis]) {
-            minAxis = i;
+    for (size_t index = 0; index < solverBodyEntities.size(); index++) {
+        mix(solverBodyEntities[index]);
+        for (const auto* array : arrays) {
+            mix(std::bit_cast<uint32_t>((*array)[index]));
         }
     }
-    
-    collision.penetrationDepth = penetration[minAxis];
-    
-    // Calculate collision normal
-    for (int i = 0; i < 3; i++) {
-        collision.normal[i] = 0.0f;
+    return hash;
+}
+
+void CPUPhysicsCollisionSystem::updateSleepState(float deltaTime, bool checkTimers) {
+    // Contact with an awake body wakes a sleeper for the next step
+    for (const auto& collision : activeCollisions) {
+        bool movingA = solverBodies.motionMask[collision.bodyA] > 0.0f;
+        bool movingB = solverBodies.motionMask[collision.bodyB] > 0.0f;
+        if (movingA == movingB) {
+            continue;
+        }
+        uint32_t sleeper = movingA ? collision.entityB : collision.entityA;
+        auto* physics = ecsManager->getComponent<PhysicsComponent>(sleeper);
+        if (physics->isSleeping) {
+            physics->isSleeping = false;
+            physics->sleepTimer = 0.0f;
+        }
     }
-    collision.normal[minAxis] = (transformA.position[minAxis] > transformB.position[minAxis]) ? 1.0f : -1.0f;
     
-    // Calculate contact point (midpoint of overlapping region)
-    for (int i = 0; i < 3; i++) {
-        collision.contactPoint[i] = (transformA.position[i] + transformB.position[i]) * 0.5f;
+    deferredSleepTime += deltaTime;
+    if (!checkTimers) {
+        return;
     }
     
-    return true;
+    const float linearLimit = sleepLinearSpeed * sleepLinearSpeed;
+    const float angularLimit = sleepAngularSpeed * sleepAngularSpeed;
+    for (uint32_t index = 0; index < solverBodyEntities.size(); index++) {
+        if (solverBodies.motionMask[index] == 0.0f) {
+            continue; // static, asleep, or woken above (it moves from the next step)
+        }
+        
+        float linear = solverBodies.velocityX[index] * solverBodies.velocityX[index] +
+                       solverBodies.velocityY[index] * solverBodies.velocityY[index] +
+                       solverBodies.velocityZ[index] * solverBodies.velocityZ[index];
+        float angular = solverBodies.angularVelocityX[index] * solverBodies.angularVelocityX[index] +
+                        solverBodies.angularVelocityY[index] * solverBodies.angularVelocityY[index] +
+                        solverBodies.angularVelocityZ[index] * solverBodies.angularVelocityZ[index];
+        
+        auto* physics = ecsManager->getComponent<PhysicsComponent>(solverBodyEntities[index]);
+        if (linear > linearLimit || angular > angularLimit) {
+            physics->sleepTimer = 0.0f;
+            continue;
+        }
+        
+        physics->sleepTimer += deferredSleepTime;
+        if (physics->sleepTimer >= sleepDelay) {
+            physics->isSleeping = true;
+            std::fill(physics->velocity, physics->velocity + 3, 0.0f);
+            std::fill(physics->angularVelocity, physics->angularVelocity + 3, 0.0f);
+        }
+    }
+    deferredSleepTime = 0.0f;
 }
 
-void CPUPhysicsCollisionSystem::resolveCollision(const CollisionPair& collision) {
-    separateEntities(collision);
-    applyCollisionImpulse(collision);
+void CPUPhysicsCollisionSystem::setSleepThresholds(float linearSpeed, float angularSpeed, float seconds) {
+    sleepLinearSpeed = std::max(linearSpeed, 0.0f);
+    sleepAngularSpeed = std::max(angularSpeed, 0.0f);
+    sleepDelay = std::max(seconds, 0.0f);
 }
 
-void CPUPhysicsCollisionSystem::separateEntities(const CollisionPair& collision) {
-    auto* transformA = ecsManager->getComponent<TransformComponent>(collision.entityA);
-    auto* transformB = ecsManager->getComponent<TransformComponent>(collision.entityB);
-    auto* physicsA = ecsManager->getComponent<PhysicsComponent>(collision.entityA);
-    auto* physicsB = ecsManager->getComponent<PhysicsComponent>(collision.entityB);
-    
-    if (!transformA || !transformB || !physicsA || !physicsB) {
-        return;
-    }
-    
-    // Calculate separation based on inverse masses
-    float totalInvMass = physicsA->invMass + physicsB->invMass;
-    if (totalInvMass <= 0.0f) {
-        return; // Both static
-    }
+void CPUPhysicsCollisionSystem::setLayerInteractionCallback(
+    std::function<bool(uint32_t, uint32_t)> canLayersInteractCallback) {
+    canLayersInteract = canLayersInteractCallback;
+}
+
+void CPUPhysicsCollisionSystem::setGravity(float x, float y, float z) {
+    gravity.x = x;
+    gravity.y = y;
+    gravity.z = z;
     
-    float separationA = (physicsA->invMass / totalInvMass) * collision.penetrationDepth * 0.5f;
-    float separationB = (physicsB->invMass / totalInvMass) * collision.penetrationDepth * 0.5f;
+    LOG_INFO(LogCategory::PHYSICS, 
+        "Collision system gravity set to (" + 
+        std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
+}
+
+std::vector<uint32_t> CPUPhysicsCollisionSystem::getCollidingEntities(uint32_t entityId) const {
+    std::vector<uint32_t> colliding;
     
-    // Separate entities along collision normal
-    if (!physicsA->isStatic) {
-        for (int i = 0; i < 3; i++) {
-            transformA->position[i] += collision.normal[i] * separationA;
+    for (const auto& collision : activeCollisions) {
+        if (collision.entityA == entityId) {
+            colliding.push_back(collision.entityB);
+        } else if (collision.entityB == entityId) {
+            colliding.push_back(collision.entityA);
         }
     }
     
-    if (!physicsB->isStatic) {
-        for (int i = 0; i < 3; i++) {
-            transformB->position[i] -= collision.normal[i] * separationB;
+    return colliding;
+}
+
+bool CPUPhysicsCollisionSystem::areEntitiesColliding(uint32_t entityA, uint32_t entityB) const {
+    for (const auto& collision : activeCollisions) {
+        if ((collision.entityA == entityA && collision.entityB == entityB) ||
+            (collision.entityA == entityB && collision.entityB == entityA)) {
+            return true;
         }
     }
+    return false;
 }
 
-void CPUPhysicsCollisionSystem::applyCollisionImpulse(const CollisionPair& collision) {
-    auto* physicsA = ecsManager->getComponent<PhysicsComponent>(collision.entityA);
-    auto* physicsB = ecsManager->getComponent<PhysicsComponent>(collision.entityB);
-    
-    if (!physicsA || !physicsB) {
-        return;
+bool CPUPhysicsCollisionSystem::narrowPhaseDetection(uint32_t bodyA, uint32_t bodyB, CollisionPair& collision) const {
+    if (!bodyColliderEnabled[bodyA] || !bodyColliderEnabled[bodyB]) {
+        return false;
     }
     
-    // Calculate relative velocity
-    float relativeVelocity[3];
-    for (int i = 0; i < 3; i++) {
-        relativeVelocity[i] = physicsA->velocity[i] - physicsB->velocity[i];
-    }
+    const float positionA[3] = {solverBodies.positionX[bodyA], solverBodies.positionY[bodyA], solverBodies.positionZ[bodyA]};
+    const float positionB[3] = {solverBodies.positionX[bodyB], solverBodies.positionY[bodyB], solverBodies.positionZ[bodyB]};
+    const float halfExtentsA[3] = {solverBodies.halfExtentX[bodyA], solverBodies.halfExtentY[bodyA], solverBodies.halfExtentZ[bodyA]};
+    const float halfExtentsB[3] = {solverBodies.halfExtentX[bodyB], solverBodies.halfExtentY[bodyB], solverBodies.halfExtentZ[bodyB]};
     
-    // Calculate relative velocity along normal
-    float velAlongNormal = 0.0f;
+    // Check for separation along each axis
+    float penetration[3];
     for (int i = 0; i < 3; i++) {
-        velAlongNormal += relativeVelocity[i] * collision.normal[i];
+        float distance = std::abs(positionA[i] - positionB[i]);
+        float totalExtent = halfExtentsA[i] + halfExtentsB[i];
+        if (distance >= totalExtent) {
+            return false;
+        }
+        penetration[i] = totalExtent - distance;
     }
     
-    // Objects separating, no impulse needed
-    if (velAlongNormal > 0.0f) {
-        return;
+    // Find the axis with minimum penetration (separation axis)
+    int minAxis = 0;
+    for (int i = 1; i < 3; i++) {
+        if (penetration[i] < penetration[minAxis]) {
+            minAxis = i;
+        }
     }
     
-    // Calculate restitution (bounce)
-    float restitution = std::min(physicsA->restitution, physicsB->restitution);
-    
-    // Calculate impulse magnitude
-    float impulseMagnitude = -(1.0f + restitution) * velAlongNormal;
-    impulseMagnitude /= (physicsA->invMass + physicsB->invMass);
+    collision.entityA = solverBodyEntities[bodyA];
+    collision.entityB = solverBodyEntities[bodyB];
+    collision.bodyA = bodyA;
+    collision.bodyB = bodyB;
+    collision.penetrationDepth = penetration[minAxis];
     
-    // Apply impulse
-    if (!physicsA->isStatic) {
-        for (int i = 0; i < 3; i++) {
-            physicsA->velocity[i] += impulseMagnitude * physicsA->invMass * collision.normal[i];
-        }
+    // Calculate collision normal
+    for (int i = 0; i < 3; i++) {
+        collision.normal[i] = 0.0f;
     }
+    collision.normal[minAxis] = (positionA[minAxis] > positionB[minAxis]) ? 1.0f : -1.0f;
     
-    if (!physicsB->isStatic) {
-        for (int i = 0; i < 3; i++) {
-            physicsB->velocity[i] -= impulseMagnitude * physicsB->invMass * collision.normal[i];
-        }
+    // Calculate contact point (midpoint of overlapping region)
+    for (int i = 0; i < 3; i++) {
+        collision.contactPoint[i] = (positionA[i] + positionB[i]) * 0.5f;
     }
+    
+    return true;
 }
 
 float CPUPhysicsCollisionSystem::calculateDistance(const float* posA, const float* posB) const {
@@ -387,37 +842,18 @@ float CPUPhysicsCollisionSystem::calculateDistance(const float* posA, const floa
     return std::sqrt(dx * dx + dy * dy + dz * dz);
 }
 
-bool CPUPhysicsCollisionSystem::canEntitiesCollide(uint32_t entityA, uint32_t entityB) const {
-    // TODO: Implement layer-based filtering when layer components are added
+bool CPUPhysicsCollisionSystem::canBodiesCollide(uint32_t bodyA, uint32_t bodyB) const {
     if (canLayersInteract) {
-        // For now, assume layer 0 for all entities
-        return canLayersInteract(0, 0);
+        return canLayersInteract(bodyLayers[bodyA], bodyLayers[bodyB]);
     }
     return true;
 }
 
-CPUPhysicsCollisionSystem::AABB CPUPhysicsCollisionSystem::calculateAABB(
-    const TransformComponent& transform, const BoxColliderComponent& collider) const {
-    
-    float halfWidth = collider.width * transform.scale[0] * 0.5f;
-    float halfHeight = collider.height * transform.scale[1] * 0.5f;
-    float halfDepth = collider.depth * transform.scale[2] * 0.5f;
-    
-    AABB aabb;
-    aabb.minX = transform.position[0] - halfWidth;
-    aabb.maxX = transform.position[0] + halfWidth;
-    aabb.minY = transform.position[1] - halfHeight;
-    aabb.maxY = transform.position[1] + halfHeight;
-    aabb.minZ = transform.position[2] - halfDepth;
-    aabb.maxZ = transform.position[2] + halfDepth;
-    
-    return aabb;
-}
-
-bool CPUPhysicsCollisionSystem::aabbOverlap(const AABB& a, const AABB& b) const {
-    return (a.minX <= b.maxX && a.maxX >= b.minX) &&
-           (a.minY <= b.maxY && a.maxY >= b.minY) &&
-           (a.minZ <= b.maxZ && a.maxZ >= b.minZ);
+bool CPUPhysicsCollisionSystem::aabbOverlap(uint32_t bodyA, uint32_t bodyB) const {
+    const SolverBodies& b = solverBodies;
+    return (b.aabbMinX[bodyA] <= b.aabbMaxX[bodyB] && b.aabbMaxX[bodyA] >= b.aabbMinX[bodyB]) &&
+           (b.aabbMinY[bodyA] <= b.aabbMaxY[bodyB] && b.aabbMaxY[bodyA] >= b.aabbMinY[bodyB]) &&
+           (b.aabbMinZ[bodyA] <= b.aabbMaxZ[bodyB] && b.aabbMaxZ[bodyA] >= b.aabbMinZ[bodyB]);
 }
 
 } // namespace cpu_physics
\ No newline at end of file
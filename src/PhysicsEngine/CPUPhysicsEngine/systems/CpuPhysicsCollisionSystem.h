@@ -2,10 +2,17 @@
 
 #include "../managers/ECSManager/ECSManager.h"
 #include "../components.h" // For component definitions
+#include "../solver/ContactSolver.h"
+#include "../solver/BodyIntegrator.h"
+#include "../solver/IslandBuilder.h"
+#include "StepBudgetStats.h"
+#include "PhysicsStepStats.h"
 #include <vector>
 #include <memory>
 #include <functional>
 
+class JobSystem;
+
 namespace cpu_physics {
 
 /**
@@ -13,20 +20,33 @@ namespace cpu_physics {
  * 
  * This system operates on entities that have Transform, Physics, and Collider components.
  * It implements:
- * - Broad phase collision detection (spatial partitioning)
+ * - Fused, vectorized integration over contiguous body arrays
+ * - Broad phase collision detection (on the cached world AABBs)
  * - Narrow phase collision detection (shape-specific tests)
- * - Collision response and resolution
+ * - Collision response and resolution (iterative, graph-colored contact solver)
+ * - Island-parallel solving across the job system
  * - Layer-based filtering
+ * - Deterministic mode: bodies are processed in entity-ID order, so results
+ *   are bit-identical for any worker count, and a state hash is kept per step
+ * - Sleeping: bodies that stay slow long enough are put to sleep and woken by contact
+ * - Time budgets: a step given a budget runs fewer solver iterations and
+ *   defers sleep checks when it would otherwise overrun
+ * - Simulation LOD: bodies far from every focus point step every 2nd or 4th
+ *   step with a scaled dt, and are promoted when a faster body touches them
+ * - Continuous collision detection for bodies flagged with
+ *   PhysicsComponent::continuousCollision: swept-AABB time of impact, with a
+ *   sub-step for the rest of the step taken only by the bodies that hit
  */
 class CPUPhysicsCollisionSystem {
 public:
     CPUPhysicsCollisionSystem(std::shared_ptr<ECSManager> ecsManager);
     ~CPUPhysicsCollisionSystem() = default;
     
-    // System update
-    void update(float deltaTime);
+    // System update; budgetMs > 0 lets the step trade accuracy for time
+    void update(float deltaTime, float budgetMs = 0.0f);
     
-    // Collision detection
+    // Collision detection (without integration); resolveCollisions() solves
+    // the contacts found by the last detectCollisions() call
     void detectCollisions(const std::vector<uint32_t>& entities);
     void resolveCollisions(float deltaTime);
     
@@ -39,10 +59,43 @@ public:
     void setGravity(float x, float y, float z);
     void setBroadPhaseEnabled(bool enabled) { broadPhaseEnabled = enabled; }
     void setCollisionResponseEnabled(bool enabled) { collisionResponseEnabled = enabled; }
+    void setSolverIterations(uint32_t iterations) { contactSolver.setIterations(iterations); }
+    void setSolverMode(ContactSolver::SolverMode mode) { contactSolver.setMode(mode); }
+    void setJobSystem(std::shared_ptr<JobSystem> jobs);
+    void setLargeIslandThreshold(size_t constraintCount) { largeIslandThreshold = constraintCount; }
+    void setDeterministic(bool enabled) { deterministic = enabled; }
+    void setSleepingEnabled(bool enabled) { sleepingEnabled = enabled; }
+    void setSleepThresholds(float linearSpeed, float angularSpeed, float seconds);
+    void setMinSolverIterations(uint32_t iterations) { minSolverIterations = iterations > 0 ? iterations : 1; }
+    bool isDeterministic() const { return deterministic; }
+    
+    // Simulation LOD: with focus points set, a body steps at full rate within
+    // halfRateDistance of one, every 2nd step within quarterRateDistance and
+    // every 4th step beyond. weight divides the distance to that point.
+    void addFocusPoint(float x, float y, float z, float weight = 1.0f);
+    void clearFocusPoints() { focusPoints.clear(); }
+    size_t getFocusPointCount() const { return focusPoints.size(); }
+    void setLodDistances(float halfRateDistance, float quarterRateDistance);
+    void setLodPromotionSteps(uint32_t steps) { lodPromotionSteps = steps; }
     
     // Statistics and debugging
     size_t getLastCollisionCount() const { return lastCollisionCount; }
     float getLastUpdateTime() const { return lastUpdateTime; }
+    const ContactSolver& getContactSolver() const { return contactSolver; }
+    size_t getLastIslandCount() const { return islandBuilder.getIslands().size(); }
+    size_t getLastLodSkippedCount() const { return lastLodSkippedCount; } // dynamic bodies not stepped
+    size_t getLastContinuousHitCount() const { return lastContinuousHitCount; } // CCD bodies stopped at an impact
+    
+    // Hash of every body's position, rotation and velocities after the last step
+    // (kept per step in deterministic mode, 0 otherwise)
+    uint64_t getLastStateHash() const { return lastStateHash; }
+    uint64_t computeStateHash() const;
+    
+    // Degradations applied by the last step to stay within its budget
+    const StepBudgetStats& getLastBudgetStats() const { return lastBudgetStats; }
+    
+    // Counters and phase times of the last update() (rigid body fields only)
+    const PhysicsStepStats& getLastStepStats() const { return lastStepStats; }
     
     // Collision queries
     std::vector<uint32_t> getCollidingEntities(uint32_t entityId) const;
@@ -56,6 +109,8 @@ private:
     struct CollisionPair {
         uint32_t entityA;
         uint32_t entityB;
+        uint32_t bodyA; // Solver body indices
+        uint32_t bodyB;
         float penetrationDepth;
         float normal[3]; // Collision normal
         float contactPoint[3]; // Contact point
@@ -64,6 +119,7 @@ private:
     std::vector<CollisionPair> activeCollisions;
     size_t lastCollisionCount = 0;
     float lastUpdateTime = 0.0f;
+    PhysicsStepStats lastStepStats; // filled in while update() runs
     
     // Physics settings
     struct {
@@ -75,43 +131,109 @@ private:
     // System configuration
     bool broadPhaseEnabled = true;
     bool collisionResponseEnabled = true;
+    bool deterministic = false;
+    uint64_t lastStateHash = 0;
+    
+    // Sleeping
+    bool sleepingEnabled = false;
+    float sleepLinearSpeed = 0.1f; // above the contact bias velocity of a resting box
+    float sleepAngularSpeed = 0.1f;
+    float sleepDelay = 0.5f;
+    float deferredSleepTime = 0.0f; // step time not yet seen by the sleep check
+    
+    void updateSleepState(float deltaTime, bool checkTimers);
+    
+    // Time budget: solve cost per iteration, learned from previous steps
+    uint32_t minSolverIterations = 1;
+    float solveMsPerIteration = 0.0f;
+    StepBudgetStats lastBudgetStats;
+    
+    // Simulation LOD
+    struct FocusPoint {
+        float position[3];
+        float weight;
+    };
+    static constexpr uint32_t LOD_MAX_PERIOD = 4;
+    std::vector<FocusPoint> focusPoints;
+    float lodHalfRateDistance = 50.0f;
+    float lodQuarterRateDistance = 100.0f;
+    uint32_t lodPromotionSteps = 8;
+    uint32_t lodStepIndex = 0;
+    size_t lastLodSkippedCount = 0;
+    std::vector<uint8_t> bodyLodSkipped; // dynamic bodies held still this step
+    std::vector<uint8_t> bodyLodPeriod;
+    
+    uint32_t selectLodPeriod(const float* position, PhysicsComponent& physics) const;
+    void promoteLodContacts();
+    
+    // Continuous collision detection: flagged bodies and where they started the step
+    struct ContinuousSweep {
+        uint32_t body;
+        float start[3];
+        float timeOfImpact; // fraction of the step, 1 if nothing was hit
+    };
+    static constexpr float CONTINUOUS_CONTACT_SLOP = 1e-3f; // overlap left at the impact so a contact is found
+    std::vector<ContinuousSweep> continuousSweeps;
+    size_t lastContinuousHitCount = 0;
+    
+    void sweepContinuousBodies();
+    void advanceContinuousBodies(float deltaTime);
+    bool findTimeOfImpact(uint32_t body, const float start[3], const float displacement[3],
+                          float& timeOfImpact, int& hitAxis) const;
+    
+    // Body storage shared by integration, detection and resolution
+    SolverBodies solverBodies;
+    std::vector<uint32_t> solverBodyEntities;
+    std::vector<float> bodyRestitution;
+    std::vector<uint8_t> bodyColliderEnabled;
+    std::vector<uint32_t> bodyLayers;
+    BodyIntegrator integrator;
+    
+    // deltaTime > 0 also applies the simulation LOD for a step of that length
+    void gatherBodies(const std::vector<uint32_t>& entities, float deltaTime = 0.0f);
+    
+    // Collision detection methods (on solver body indices). Rows of the
+    // pair matrix are split into chunks that run on the job system; each
+    // chunk collects its broad phase candidates, then runs the narrow phase on them.
+    static constexpr uint32_t CONTACT_ROWS_PER_CHUNK = 32;
+    size_t parallelContactThreshold = 256;
+    struct ContactChunk {
+        std::vector<std::pair<uint32_t, uint32_t>> candidates;
+        std::vector<CollisionPair> contacts;
+        uint64_t pairsTested = 0;
+        uint64_t layerFilteredPairs = 0;
+        float broadphaseMs = 0.0f;
+        float narrowphaseMs = 0.0f;
+        HardwareCounterValues broadphaseCounters;
+        HardwareCounterValues narrowphaseCounters;
+    };
+    std::vector<ContactChunk> contactChunks;
     
-    // Physics integration
-    void integratePhysics(uint32_t entityId, float deltaTime);
-    void applyGravity(uint32_t entityId, float deltaTime);
-    void updateTransformFromPhysics(uint32_t entityId, float deltaTime);
-    
-    // Collision detection methods
-    std::vector<std::pair<uint32_t, uint32_t>> broadPhaseDetection(const std::vector<uint32_t>& entities);
-    bool narrowPhaseDetection(uint32_t entityA, uint32_t entityB, CollisionPair& collision);
-    bool checkBoxBoxCollision(
-        const TransformComponent& transformA, const BoxColliderComponent& colliderA,
-        const TransformComponent& transformB, const BoxColliderComponent& colliderB,
-        CollisionPair& collision
-    );
+    void findContacts();
+    void findContactsInRows(uint32_t rowBegin, uint32_t rowEnd, ContactChunk& chunk) const;
+    bool narrowPhaseDetection(uint32_t bodyA, uint32_t bodyB, CollisionPair& collision) const;
     
     // Collision resolution
-    void resolveCollision(const CollisionPair& collision);
-    void separateEntities(const CollisionPair& collision);
-    void applyCollisionImpulse(const CollisionPair& collision);
+    ContactSolver contactSolver;
+    std::vector<ContactConstraint> contactConstraints;
+    
+    void buildContactConstraints();
+    void writeBackSolverBodies();
+    
+    // Island pipeline
+    std::shared_ptr<JobSystem> jobSystem;
+    IslandBuilder islandBuilder;
+    std::vector<ContactConstraint> largeIslandConstraints;
+    size_t largeIslandThreshold = 1024;
+    
+    void solveIslands();
+    void solveLargeIsland(const Island& island);
+    void solveIslandBin(size_t bin);
     
     // Utility methods
     float calculateDistance(const float* posA, const float* posB) const;
-    void calculateCollisionNormal(
-        const TransformComponent& transformA, const BoxColliderComponent& colliderA,
-        const TransformComponent& transformB, const BoxColliderComponent& colliderB,
-        float* normal
-    ) const;
-    bool canEntitiesCollide(uint32_t entityA, uint32_t entityB) const;
-    
-    // AABB (Axis-Aligned Bounding Box) helpers
-    struct AABB {
-        float minX, minY, minZ;
-        float maxX, maxY, maxZ;
-    };
-    
-    AABB calculateAABB(const TransformComponent& transform, const BoxColliderComponent& collider) const;
-    bool aabbOverlap(const AABB& a, const AABB& b) const;
+    bool canBodiesCollide(uint32_t bodyA, uint32_t bodyB) const;
+    bool aabbOverlap(uint32_t bodyA, uint32_t bodyB) const;
 };
 
 } // namespace cpu_physics
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../../managers/profilemanager/HardwareCounters.h"
+
+namespace cpu_physics {
+
+/**
+ * Counters and timings of one physics step.
+ *
+ * The collision system fills the rigid body fields, CPUPhysicsEngine adds
+ * its systems and legacy sync, and PhysicsEngine adds the GPU particle
+ * step. Times are wall-clock milliseconds; broadphaseMs and narrowphaseMs
+ * are summed over the threads that ran them.
+ *
+ * The counter fields are only filled while HardwareCounters is enabled.
+ * Broadphase and narrowphase counts are summed over the threads that ran
+ * them; the other phases count the stepping thread.
+ */
+struct PhysicsStepStats {
+    uint64_t stepIndex = 0; // steps recorded by the engine before this one
+
+    // Bodies at the start of the step
+    uint32_t awakeBodies = 0;
+    uint32_t sleepingBodies = 0;
+    uint32_t staticBodies = 0;
+    uint32_t lodSkippedBodies = 0; // awake bodies held still by the simulation LOD
+
+    // Collision detection
+    uint64_t broadphasePairsTested = 0;  // body pairs whose bounds were compared
+    uint64_t broadphasePairsEmitted = 0; // candidate pairs passed to the narrow phase
+    uint64_t layerFilteredPairs = 0;     // overlapping pairs rejected by the layer rules
+    uint32_t narrowphaseContacts = 0;
+
+    // Contact solver
+    uint32_t solverIterations = 0;
+    float solverResidual = 0.0f; // largest contact velocity error left after solving (m/s)
+    uint32_t islands = 0;
+
+    // GPU particles
+    uint32_t particles = 0;
+    float gpuDispatchMs = 0.0f; // submit until the results were back
+    // Not measured yet: the particle upload and download do not copy buffers, so both stay 0
+    uint64_t bytesUploaded = 0;
+    uint64_t bytesDownloaded = 0;
+
+    // Time per phase
+    float gatherMs = 0.0f;
+    float integrateMs = 0.0f;
+    float continuousMs = 0.0f;       // continuous collision sweep and advance
+    float collisionDetectionMs = 0.0f;
+    float broadphaseMs = 0.0f;
+    float narrowphaseMs = 0.0f;
+    float solveMs = 0.0f;
+    float writeBackMs = 0.0f;
+    float sleepMs = 0.0f;
+    float systemsMs = 0.0f;
+    float legacySyncMs = 0.0f;
+    float totalMs = 0.0f;
+
+    // operator new calls inside updatePhysics while AllocationTracker is enabled
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+
+    // CPU counters per phase; gather and write back are the ECS iteration paths
+    HardwareCounterValues gatherCounters;
+    HardwareCounterValues integrateCounters;
+    HardwareCounterValues broadphaseCounters;
+    HardwareCounterValues narrowphaseCounters;
+    HardwareCounterValues solveCounters;
+    HardwareCounterValues writeBackCounters;
+    HardwareCounterValues systemsCounters;
+};
+
+// Distribution of one counter over a stats window
+struct StatPercentiles {
+    double min = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * Rolling window of the most recent step stats.
+ *
+ * Percentiles use the nearest-rank method over the samples in the window
+ * and take any field, e.g. percentile(&PhysicsStepStats::totalMs, 99).
+ */
+class PhysicsStatsHistory {
+public:
+    explicit PhysicsStatsHistory(size_t capacity = 300) { setCapacity(capacity); }
+
+    // Changing the capacity clears the window
+    void setCapacity(size_t capacity) {
+        samples.assign(std::max<size_t>(capacity, 1), PhysicsStepStats{});
+        clear();
+    }
+    size_t getCapacity() const { return samples.size(); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void push(const PhysicsStepStats& stats) {
+        samples[next] = stats;
+        next = (next + 1) % samples.size();
+        count = std::min(count + 1, samples.size());
+    }
+
+    void clear() {
+        next = 0;
+        count = 0;
+    }
+
+    // Sample by age: 0 is the oldest in the window
+    const PhysicsStepStats& at(size_t index) const {
+        return samples[(next + samples.size() - count + index) % samples.size()];
+    }
+    const PhysicsStepStats& latest() const { return at(count - 1); }
+
+    // percent in [0, 100]; 0 when the window is empty
+    template<typename T>
+    double percentile(T PhysicsStepStats::*field, double percent) const {
+        if (count == 0) {
+            return 0.0;
+        }
+        gatherValues(field);
+        size_t index = rankIndex(percent);
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+
+    template<typename T>
+    StatPercentiles summarize(T PhysicsStepStats::*field) const {
+        StatPercentiles result;
+        if (count == 0) {
+            return result;
+        }
+        gatherValues(field);
+        std::sort(values.begin(), values.end());
+        result.min = values.front();
+        result.p50 = values[rankIndex(50.0)];
+        result.p90 = values[rankIndex(90.0)];
+        result.p99 = values[rankIndex(99.0)];
+        result.max = values.back();
+        return result;
+    }
+
+private:
+    std::vector<PhysicsStepStats> samples;
+    size_t next = 0;
+    size_t count = 0;
+    mutable std::vector<double> values; // scratch for percentile queries
+
+    template<typename T>
+    void gatherValues(T PhysicsStepStats::*field) const {
+        values.clear();
+        for (size_t i = 0; i < count; i++) {
+            values.push_back(static_cast<double>(samples[i].*field));
+        }
+    }
+
+    size_t rankIndex(double percent) const {
+        double rank = std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(count));
+        return std::min(count - 1, static_cast<size_t>(std::max(rank, 1.0)) - 1);
+    }
+};
+
+} // namespace cpu_physics
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cpu_physics {
+
+/**
+ * What a time-budgeted step gave up to stay within its budget.
+ *
+ * Degradations are applied in order as the budget tightens: fewer solver
+ * iterations, then deferred sleep checks, then (in PhysicsEngine::update())
+ * dropped substeps.
+ */
+struct StepBudgetStats {
+    float budgetMs = 0.0f;          // 0 when the step ran without a budget
+    float elapsedMs = 0.0f;
+    uint32_t solverIterations = 0;  // iterations actually run (fewest across substeps)
+    bool reducedIterations = false;
+    bool deferredSleepChecks = false;
+    uint32_t droppedSubsteps = 0;
+
+    bool isDegraded() const { return reducedIterations || deferredSleepChecks || droppedSubsteps > 0; }
+};
+
+} // namespace cpu_physics
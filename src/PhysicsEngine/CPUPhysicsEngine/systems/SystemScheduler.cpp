@@ -0,0 +1,152 @@
+#include "SystemScheduler.h"
+#include "../../managers/jobmanager/JobSystem.h"
+#include "../../managers/logmanager/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace cpu_physics {
+
+void SystemScheduler::addSystem(SystemPtr system) {
+    if (!system) {
+        LOG_WARN(LogCategory::PHYSICS, "SystemScheduler: Ignoring null system");
+        return;
+    }
+
+    systems.push_back(std::move(system));
+    graphDirty = true;
+}
+
+bool SystemScheduler::removeSystem(const interfaces::CPUPhysicsSystem* system) {
+    auto it = std::find_if(systems.begin(), systems.end(),
+                           [system](const SystemPtr& candidate) { return candidate.get() == system; });
+    if (it == systems.end()) {
+        return false;
+    }
+
+    systems.erase(it);
+    graphDirty = true;
+    return true;
+}
+
+void SystemScheduler::update(float deltaTime) {
+    if (graphDirty) {
+        rebuildGraph();
+    }
+    if (nodes.empty()) {
+        return;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    if (jobSystem) {
+        for (uint32_t i = 0; i < nodes.size(); i++) {
+            remainingDependencies[i].store(static_cast<uint32_t>(nodes[i].predecessors.size()),
+                                           std::memory_order_relaxed);
+        }
+
+        // Roots start right away; every finished node releases its successors
+        JobCounter counter;
+        for (uint32_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].predecessors.empty()) {
+                jobSystem->run([this, i, deltaTime, &counter]() { runNode(i, deltaTime, &counter); }, &counter);
+            }
+        }
+        jobSystem->wait(counter);
+    } else {
+        // Execution order is a valid topological order
+        for (auto& node : nodes) {
+            node.system->update(deltaTime);
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    lastUpdateTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+const std::vector<SystemScheduler::SystemPtr>& SystemScheduler::getExecutionOrder() {
+    if (graphDirty) {
+        rebuildGraph();
+    }
+    return executionOrder;
+}
+
+bool SystemScheduler::dependsOn(const interfaces::CPUPhysicsSystem* later,
+                                const interfaces::CPUPhysicsSystem* earlier) {
+    if (graphDirty) {
+        rebuildGraph();
+    }
+
+    for (const auto& node : nodes) {
+        if (node.system.get() != later) {
+            continue;
+        }
+        for (uint32_t predecessor : node.predecessors) {
+            if (nodes[predecessor].system.get() == earlier) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SystemScheduler::rebuildGraph() {
+    // Stable sort keeps insertion order within a priority level
+    executionOrder = systems;
+    std::stable_sort(executionOrder.begin(), executionOrder.end(), [](const SystemPtr& a, const SystemPtr& b) {
+        return static_cast<uint32_t>(a->getPriority()) < static_cast<uint32_t>(b->getPriority());
+    });
+
+    nodes.clear();
+    nodes.resize(executionOrder.size());
+    for (size_t i = 0; i < executionOrder.size(); i++) {
+        nodes[i].system = executionOrder[i];
+        nodes[i].readMask = componentMask(executionOrder[i]->getReadComponents());
+        nodes[i].writeMask = componentMask(executionOrder[i]->getWriteComponents());
+    }
+
+    // Edge from every earlier system whose component access conflicts
+    for (uint32_t later = 0; later < nodes.size(); later++) {
+        for (uint32_t earlier = 0; earlier < later; earlier++) {
+            const Node& a = nodes[earlier];
+            const Node& b = nodes[later];
+            bool conflict = (a.writeMask & (b.readMask | b.writeMask)) != 0 ||
+                            (b.writeMask & a.readMask) != 0;
+            if (conflict) {
+                nodes[earlier].successors.push_back(later);
+                nodes[later].predecessors.push_back(earlier);
+            }
+        }
+    }
+
+    remainingDependencies = std::vector<std::atomic<uint32_t>>(nodes.size());
+    graphDirty = false;
+    graphBuildCount++;
+
+    LOG_DEBUG(LogCategory::PHYSICS, "SystemScheduler: Rebuilt dependency graph for {} systems", nodes.size());
+}
+
+void SystemScheduler::runNode(uint32_t node, float deltaTime, JobCounter* counter) {
+    nodes[node].system->update(deltaTime);
+
+    for (uint32_t successor : nodes[node].successors) {
+        if (remainingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            jobSystem->run([this, successor, deltaTime, counter]() { runNode(successor, deltaTime, counter); },
+                           counter);
+        }
+    }
+}
+
+uint64_t SystemScheduler::componentMask(
+    const std::vector<interfaces::CPUPhysicsComponent::ComponentType>& components) {
+    uint64_t mask = 0;
+    for (auto type : components) {
+        // Built-in types map to their value, custom types follow them (sharing the last bit if needed)
+        uint32_t value = static_cast<uint32_t>(type);
+        uint32_t customBase = static_cast<uint32_t>(interfaces::CPUPhysicsComponent::ComponentType::CUSTOM);
+        uint32_t bit = value < customBase ? value : 4 + (value - customBase);
+        mask |= uint64_t(1) << std::min<uint32_t>(bit, 63);
+    }
+    return mask;
+}
+
+} // namespace cpu_physics
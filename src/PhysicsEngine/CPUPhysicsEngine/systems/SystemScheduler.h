@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../interfaces/CPUPhysicsSystem.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+class JobCounter;
+
+namespace cpu_physics {
+
+/**
+ * System Scheduler - Runs CPUPhysicsSystems as a dependency graph
+ *
+ * Systems are ordered by priority (then by the order they were added). A
+ * later system depends on an earlier one when their declared component sets
+ * conflict: one writes a component type the other reads or writes. Systems
+ * without a conflict run concurrently on the job system; priority only
+ * orders systems that conflict.
+ *
+ * The graph is rebuilt lazily on the first update after a system is added
+ * or removed. Each system reports its own wall time through
+ * getLastUpdateTime().
+ */
+class SystemScheduler {
+public:
+    using SystemPtr = std::shared_ptr<interfaces::CPUPhysicsSystem>;
+
+    // System management
+    void addSystem(SystemPtr system);
+    bool removeSystem(const interfaces::CPUPhysicsSystem* system);
+    size_t getSystemCount() const { return systems.size(); }
+
+    void setJobSystem(std::shared_ptr<JobSystem> jobs) { jobSystem = std::move(jobs); }
+
+    // Run every system once, respecting dependencies
+    void update(float deltaTime);
+
+    // Graph inspection (rebuilds the graph if it is out of date)
+    const std::vector<SystemPtr>& getExecutionOrder();
+    bool dependsOn(const interfaces::CPUPhysicsSystem* later, const interfaces::CPUPhysicsSystem* earlier);
+    size_t getGraphBuildCount() const { return graphBuildCount; }
+
+    // Statistics
+    float getLastUpdateTime() const { return lastUpdateTime; }
+
+private:
+    struct Node {
+        SystemPtr system;
+        std::vector<uint32_t> successors;
+        std::vector<uint32_t> predecessors;
+        uint64_t readMask = 0;
+        uint64_t writeMask = 0;
+    };
+
+    std::vector<SystemPtr> systems; // in the order they were added
+    std::shared_ptr<JobSystem> jobSystem;
+
+    // Dependency graph, nodes in execution order
+    bool graphDirty = true;
+    std::vector<Node> nodes;
+    std::vector<SystemPtr> executionOrder;
+    std::vector<std::atomic<uint32_t>> remainingDependencies;
+    size_t graphBuildCount = 0;
+
+    float lastUpdateTime = 0.0f;
+
+    void rebuildGraph();
+    void runNode(uint32_t node, float deltaTime, JobCounter* counter);
+    static uint64_t componentMask(const std::vector<interfaces::CPUPhysicsComponent::ComponentType>& components);
+};
+
+} // namespace cpu_physics
@@ -4,6 +4,7 @@
 #include "components/vulkan/physics/ComputePipeline.h"
 #include "managers/particlemanager/ParticleManager.h"
 #include "../managers/logmanager/Logger.h"
+#include "../managers/profilemanager/Profiler.h"
 #include <iostream>
 
 namespace gpu_physics {
@@ -55,11 +56,27 @@ bool GPUPhysicsEngine::initialize(uint32_t maxParticles) {
         return false;
     }
     
+    // Signalled when a submitted step finishes, so only that work is waited on
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    
+    if (vkCreateFence(vulkanContext->getDevice(), &fenceInfo, nullptr, &computeFence) != VK_SUCCESS) {
+        LOG_ERROR(LogCategory::PHYSICS, "Failed to create compute fence for GPU physics");
+        return false;
+    }
+    
     LOG_INFO(LogCategory::PHYSICS, "GPU Physics System initialized successfully");
     return true;
 }
 
 void GPUPhysicsEngine::cleanup() {
+    waitForStep();
+    
+    if (computeFence != VK_NULL_HANDLE && vulkanContext) {
+        vkDestroyFence(vulkanContext->getDevice(), computeFence, nullptr);
+        computeFence = VK_NULL_HANDLE;
+    }
+    
     if (computeCommandBuffer != VK_NULL_HANDLE && vulkanContext) {
         vkFreeCommandBuffers(vulkanContext->getDevice(), vulkanContext->getCommandPool(), 1, &computeCommandBuffer);
         computeCommandBuffer = VK_NULL_HANDLE;
@@ -104,13 +121,24 @@ size_t GPUPhysicsEngine::getParticleCount() const {
 }
 
 void GPUPhysicsEngine::updatePhysics(float deltaTime) {
-    if (particles.empty() || !vulkanContext || !computePipeline) {
+    submitStep(deltaTime);
+    waitForStep();
+}
+
+void GPUPhysicsEngine::submitStep(float deltaTime) {
+    if (particles.empty() || !vulkanContext || !computePipeline || computeFence == VK_NULL_HANDLE) {
         return;
     }
     
+    // The command buffer is re-recorded below, so the previous step must be done with it
+    waitForStep();
+    
     // Upload particle data to GPU
+    lastBytesUploaded = 0;
     uploadParticlesToGPU();
     
+    PROFILE_SCOPE("gpu dispatch");
+    
     // Record compute command buffer
     recordComputeCommandBuffer();
     
@@ -120,10 +148,30 @@ void GPUPhysicsEngine::updatePhysics(float deltaTime) {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &computeCommandBuffer;
     
-    vkQueueSubmit(vulkanContext->getComputeQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(vulkanContext->getComputeQueue());
+    submitTime = std::chrono::high_resolution_clock::now();
+    if (vkQueueSubmit(vulkanContext->getComputeQueue(), 1, &submitInfo, computeFence) != VK_SUCCESS) {
+        LOG_ERROR(LogCategory::PHYSICS, "Failed to submit GPU physics step");
+        return;
+    }
+    stepPending = true;
+}
+
+void GPUPhysicsEngine::waitForStep() {
+    if (!stepPending) {
+        return;
+    }
+    
+    {
+        PROFILE_SCOPE("gpu wait");
+        VkDevice device = vulkanContext->getDevice();
+        vkWaitForFences(device, 1, &computeFence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device, 1, &computeFence);
+    }
+    stepPending = false;
+    lastDispatchMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - submitTime).count();
     
     // Download updated particle data from GPU
+    lastBytesDownloaded = 0;
     downloadParticlesFromGPU();
 }
 
@@ -140,20 +188,22 @@ void GPUPhysicsEngine::uploadParticlesToGPU() {
     if (!bufferManager || particles.empty()) {
         return;
     }
+    PROFILE_SCOPE("gpu upload");
     
     // This would upload particle data to GPU buffers
     // Implementation depends on BufferManager interface
-    LOG_PHYSICS_INFO("Uploading " + std::to_string(particles.size()) + " particles to GPU");
+    LOG_PHYSICS_INFO("Uploading {} particles to GPU", particles.size());
 }
 
 void GPUPhysicsEngine::downloadParticlesFromGPU() {
     if (!bufferManager || particles.empty()) {
         return;
     }
+    PROFILE_SCOPE("gpu download");
     
     // This would download updated particle data from GPU
     // Implementation depends on BufferManager interface
-    LOG_PHYSICS_INFO("Downloading " + std::to_string(particles.size()) + " particles from GPU");
+    LOG_PHYSICS_INFO("Downloading {} particles from GPU", particles.size());
 }
 
 void GPUPhysicsEngine::recordComputeCommandBuffer() {
@@ -2,6 +2,8 @@
 
 #include "components/Particle.h"
 #include <vulkan/vulkan.h>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -31,12 +33,24 @@ public:
     size_t getParticleCount() const;
     
     // Physics simulation
-    void updatePhysics(float deltaTime);
+    void updatePhysics(float deltaTime); // submitStep() followed by waitForStep()
+    
+    // Split step: submit the compute work, then collect the results once the
+    // fence signals. The caller is free to do other work in between.
+    void submitStep(float deltaTime);
+    void waitForStep();
+    bool isStepPending() const { return stepPending; }
     void setGravity(float x, float y, float z);
     
     // Configuration
     uint32_t getMaxParticles() const { return maxParticles; }
     
+    // Statistics of the last step
+    float getLastDispatchTime() const { return lastDispatchMs; } // submit until the fence signalled (ms)
+    // Bytes copied to and from the particle buffers; 0 until upload/download make real copies
+    uint64_t getLastBytesUploaded() const { return lastBytesUploaded; }
+    uint64_t getLastBytesDownloaded() const { return lastBytesDownloaded; }
+    
     // GPU buffer management
     void uploadParticlesToGPU();
     void downloadParticlesFromGPU();
@@ -53,8 +67,15 @@ private:
     std::shared_ptr<ComputePipeline> computePipeline;
     
     VkCommandBuffer computeCommandBuffer = VK_NULL_HANDLE;
+    VkFence computeFence = VK_NULL_HANDLE;
+    bool stepPending = false;
     uint32_t maxParticles;
     
+    std::chrono::high_resolution_clock::time_point submitTime;
+    float lastDispatchMs = 0.0f;
+    uint64_t lastBytesUploaded = 0;
+    uint64_t lastBytesDownloaded = 0;
+    
     std::vector<Particle> particles;
     
     struct {
@@ -1,6 +1,14 @@
 #include "PhysicsEngine.h"
 #include "CPUPhysicsEngine/CPUPhysicsEngine.h"
 #include "managers/logmanager/Logger.h"
+#include "managers/jobmanager/JobSystem.h"
+#include "managers/profilemanager/AllocationTracker.h"
+#include "managers/profilemanager/Profiler.h"
+#include "managers/metricsmanager/MetricsPage.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 
 // Only include GPU physics if Vulkan is available
 #ifdef VULKAN_AVAILABLE
@@ -8,7 +16,7 @@
 #include "GPUPhysicsEngine/managers/vulkanmanager/VulkanManager.h"
 #endif
 
-PhysicsEngine::PhysicsEngine() {
+PhysicsEngine::PhysicsEngine() : cpuStepCounter(std::make_unique<JobCounter>()) {
     LOG_INFO(LogCategory::PHYSICS, "Initializing Titanium Physics Engine");
 }
 
@@ -45,6 +53,9 @@ bool PhysicsEngine::initialize(uint32_t maxParticles, uint32_t maxRigidBodies) {
     
     // Initialize CPU Physics System for rigidbodies (ECS-based)
     cpuPhysics = std::make_unique<cpu_physics::CPUPhysicsEngine>();
+    if (hostJobSystem) {
+        cpuPhysics->setJobSystem(hostJobSystem);
+    }
     if (!cpuPhysics->initialize(maxRigidBodies)) {
         LOG_ERROR(LogCategory::PHYSICS, "Failed to initialize CPU physics system");
         return false;
@@ -66,6 +77,8 @@ void PhysicsEngine::cleanup() {
     
     LOG_INFO(LogCategory::PHYSICS, "Cleaning up Titanium Physics Engine");
     
+    endStep();
+    
     if (cpuPhysics) {
         cpuPhysics->cleanup();
         cpuPhysics.reset();
@@ -78,26 +91,292 @@ void PhysicsEngine::cleanup() {
     }
 #endif
     
+    previousTransforms.clear();
+    accumulator = 0.0f;
+    interpolationAlpha = 0.0f;
+    
     initialized = false;
     LOG_INFO(LogCategory::PHYSICS, "Titanium Physics Engine cleanup complete");
 }
 
-void PhysicsEngine::updatePhysics(float deltaTime) {
+void PhysicsEngine::updatePhysics(float deltaTime, float budgetMs) {
+    if (!initialized) {
+        return;
+    }
+    PROFILE_SCOPE("PhysicsEngine::updatePhysics");
+    
+    endStep();
+    auto startTime = std::chrono::high_resolution_clock::now();
+    AllocationStep allocationStep;
+    
+#ifdef VULKAN_AVAILABLE
+    // Start GPU physics (particles/fluids) if available
+    if (gpuPhysics) {
+        AllocationPhase allocations("gpu submit");
+        gpuPhysics->submitStep(deltaTime);
+    }
+#endif
+    
+    // Update CPU physics (rigidbodies) while the GPU works
+    if (cpuPhysics) {
+        cpuPhysics->updatePhysics(deltaTime, budgetMs);
+        lastBudgetStats = cpuPhysics->getLastBudgetStats();
+    }
+    
+#ifdef VULKAN_AVAILABLE
+    if (gpuPhysics) {
+        AllocationPhase allocations("gpu wait");
+        gpuPhysics->waitForStep();
+    }
+#endif
+    
+    AllocationCounts allocations = allocationStep.finish();
+    recordStepStats(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count(),
+                    allocations);
+}
+
+void PhysicsEngine::recordStepStats(float totalMs, const AllocationCounts& allocations) {
+    cpu_physics::PhysicsStepStats stats;
+    if (cpuPhysics) {
+        stats = cpuPhysics->getLastStepStats();
+    }
+    stats.stepIndex = recordedSteps++;
+    stats.particles = static_cast<uint32_t>(getParticleCount());
+#ifdef VULKAN_AVAILABLE
+    if (gpuPhysics) {
+        stats.gpuDispatchMs = gpuPhysics->getLastDispatchTime();
+        stats.bytesUploaded = gpuPhysics->getLastBytesUploaded();
+        stats.bytesDownloaded = gpuPhysics->getLastBytesDownloaded();
+    }
+#endif
+    stats.totalMs = totalMs;
+    stats.allocations = allocations.allocations;
+    stats.allocatedBytes = allocations.bytes;
+    
+    lastStepStats = stats;
+    statsHistory.push(stats);
+    if (metricsExporter) {
+        metricsExporter->publish(stats);
+    }
+}
+
+bool PhysicsEngine::enableMetricsExport(const std::string& path) {
+    auto exporter = std::make_unique<MetricsExporter>();
+    if (!exporter->open(path)) {
+        LOG_ERROR(LogCategory::PERFORMANCE, "Failed to open metrics page {}", path);
+        return false;
+    }
+    metricsExporter = std::move(exporter);
+    LOG_INFO(LogCategory::PERFORMANCE, "Publishing step metrics to {}", path);
+    return true;
+}
+
+void PhysicsEngine::disableMetricsExport() {
+    metricsExporter.reset();
+}
+
+void PhysicsEngine::beginStep(float deltaTime) {
     if (!initialized) {
         return;
     }
     
+    // Only one step can be in flight
+    endStep();
+    
 #ifdef VULKAN_AVAILABLE
-    // Update GPU physics (particles/fluids) if available
     if (gpuPhysics) {
-        gpuPhysics->updatePhysics(deltaTime);
+        gpuPhysics->submitStep(deltaTime);
     }
 #endif
     
-    // Update CPU physics (rigidbodies)
     if (cpuPhysics) {
-        cpuPhysics->updatePhysics(deltaTime);
+        auto jobs = cpuPhysics->getJobSystem();
+        if (jobs) {
+            cpu_physics::CPUPhysicsEngine* cpu = cpuPhysics.get();
+            jobs->run([cpu, deltaTime]() { cpu->updatePhysics(deltaTime); }, cpuStepCounter.get());
+        } else {
+            cpuPhysics->updatePhysics(deltaTime);
+        }
     }
+    
+    stepInFlight = true;
+}
+
+void PhysicsEngine::endStep() {
+    if (!stepInFlight) {
+        return;
+    }
+    
+    // The waiting thread helps run the CPU step's jobs
+    if (cpuPhysics) {
+        auto jobs = cpuPhysics->getJobSystem();
+        if (jobs) {
+            jobs->wait(*cpuStepCounter);
+        }
+    }
+    
+#ifdef VULKAN_AVAILABLE
+    if (gpuPhysics) {
+        gpuPhysics->waitForStep();
+    }
+#endif
+    
+    stepInFlight = false;
+    // Pipelined steps run on a job and are not allocation-tracked
+    recordStepStats(cpuPhysics ? cpuPhysics->getLastStepStats().totalMs : 0.0f, AllocationCounts{});
+}
+
+uint32_t PhysicsEngine::update(float frameTime, float budgetMs) {
+    if (!initialized) {
+        return 0;
+    }
+    PROFILE_SCOPE("PhysicsEngine::update");
+    
+    endStep();
+    accumulator += std::max(frameTime, 0.0f);
+    
+    uint32_t substeps = static_cast<uint32_t>(accumulator / fixedTimestep);
+    if (substeps > maxSubsteps) {
+        // Drop the time we cannot catch up on instead of spiralling
+        LOG_WARN(LogCategory::PERFORMANCE, "Physics fell behind, dropping {} substeps", substeps - maxSubsteps);
+        substeps = maxSubsteps;
+        accumulator = fixedTimestep * static_cast<float>(maxSubsteps);
+    }
+    
+    auto frameStart = std::chrono::high_resolution_clock::now();
+    auto elapsedMs = [&frameStart]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count();
+    };
+    
+    cpu_physics::StepBudgetStats frameStats;
+    frameStats.budgetMs = budgetMs;
+    
+    uint32_t taken = 0;
+    for (uint32_t step = 0; step < substeps; step++) {
+        // Last degradation: stop early when the next substep is predicted not to fit
+        float remainingMs = budgetMs - elapsedMs();
+        bool lastSubstep = step + 1 == substeps ||
+                           (budgetMs > 0.0f && substepMsEstimate > 0.0f && remainingMs < 2.0f * substepMsEstimate);
+        
+        // Only the state before the last substep is needed for interpolation
+        if (lastSubstep) {
+            capturePreviousTransforms();
+        }
+        
+        // Remaining substeps share what is left; the first always runs, at the cheapest setting if need be
+        float substepBudgetMs = 0.0f;
+        if (budgetMs > 0.0f) {
+            substepBudgetMs = std::max(lastSubstep ? remainingMs : remainingMs / static_cast<float>(substeps - step),
+                                       std::numeric_limits<float>::min());
+        }
+        
+        float substepStartMs = elapsedMs();
+        updatePhysics(fixedTimestep, substepBudgetMs);
+        accumulator -= fixedTimestep;
+        taken++;
+        
+        float substepMs = elapsedMs() - substepStartMs;
+        substepMsEstimate = substepMsEstimate > 0.0f ? substepMsEstimate * 0.75f + substepMs * 0.25f : substepMs;
+        
+        const auto& substepStats = lastBudgetStats;
+        frameStats.solverIterations = taken == 1 ? substepStats.solverIterations
+                                                 : std::min(frameStats.solverIterations, substepStats.solverIterations);
+        frameStats.reducedIterations |= substepStats.reducedIterations;
+        frameStats.deferredSleepChecks |= substepStats.deferredSleepChecks;
+        
+        if (lastSubstep) {
+            break;
+        }
+    }
+    
+    if (taken < substeps) {
+        // Dropped substeps give up their time, like substeps beyond maxSubsteps
+        frameStats.droppedSubsteps = substeps - taken;
+        accumulator -= fixedTimestep * static_cast<float>(frameStats.droppedSubsteps);
+        LOG_DEBUG(LogCategory::PERFORMANCE, "Physics budget of {:.3f} ms exceeded, dropping {} substeps",
+                  budgetMs, frameStats.droppedSubsteps);
+    }
+    frameStats.elapsedMs = elapsedMs();
+    lastBudgetStats = frameStats;
+    
+    accumulator = std::max(accumulator, 0.0f);
+    interpolationAlpha = std::min(accumulator / fixedTimestep, 1.0f);
+    return taken;
+}
+
+void PhysicsEngine::setFixedTimestep(float stepSeconds) {
+    if (stepSeconds <= 0.0f) {
+        LOG_WARN(LogCategory::PHYSICS, "Ignoring non-positive fixed timestep");
+        return;
+    }
+    
+    fixedTimestep = stepSeconds;
+    accumulator = std::min(accumulator, fixedTimestep);
+    LOG_INFO(LogCategory::PHYSICS, "Fixed timestep set to " + std::to_string(stepSeconds) + "s (" +
+             std::to_string(1.0f / stepSeconds) + " Hz)");
+}
+
+bool PhysicsEngine::getInterpolatedTransform(uint32_t bodyId, float position[3], float rotation[4]) const {
+    if (!cpuPhysics) {
+        return false;
+    }
+    
+    const auto* transform = cpuPhysics->getECSManager()->getTransformComponent(bodyId);
+    if (!transform) {
+        return false;
+    }
+    
+    auto previousIt = std::lower_bound(previousTransforms.begin(), previousTransforms.end(), bodyId,
+                                       [](const InterpolationState& state, uint32_t id) { return state.entityId < id; });
+    if (previousIt == previousTransforms.end() || previousIt->entityId != bodyId) {
+        // Body created since the last step, nothing to blend from
+        std::copy(transform->position, transform->position + 3, position);
+        std::copy(transform->rotation, transform->rotation + 4, rotation);
+        return true;
+    }
+    
+    const InterpolationState& previous = *previousIt;
+    float alpha = interpolationAlpha;
+    for (int i = 0; i < 3; i++) {
+        position[i] = previous.position[i] + (transform->position[i] - previous.position[i]) * alpha;
+    }
+    
+    // Normalized lerp along the shorter arc
+    float dot = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        dot += previous.rotation[i] * transform->rotation[i];
+    }
+    float sign = dot < 0.0f ? -1.0f : 1.0f;
+    float lengthSquared = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        rotation[i] = previous.rotation[i] + (sign * transform->rotation[i] - previous.rotation[i]) * alpha;
+        lengthSquared += rotation[i] * rotation[i];
+    }
+    if (lengthSquared > 0.0f) {
+        float invLength = 1.0f / std::sqrt(lengthSquared);
+        for (int i = 0; i < 4; i++) {
+            rotation[i] *= invLength;
+        }
+    }
+    return true;
+}
+
+void PhysicsEngine::capturePreviousTransforms() {
+    previousTransforms.clear();
+    if (!cpuPhysics) {
+        return;
+    }
+    
+    AllocationPhase allocations("interpolation");
+    cpuPhysics->getECSManager()->forEachTransformComponent(
+        [this](uint32_t entityId, const cpu_physics::TransformComponent& transform) {
+            InterpolationState& state = previousTransforms.emplace_back();
+            state.entityId = entityId;
+            std::copy(transform.position, transform.position + 3, state.position);
+            std::copy(transform.rotation, transform.rotation + 4, state.rotation);
+        });
+    std::sort(previousTransforms.begin(), previousTransforms.end(),
+              [](const InterpolationState& a, const InterpolationState& b) { return a.entityId < b.entityId; });
 }
 
 void PhysicsEngine::setGravity(float x, float y, float z) {
@@ -156,9 +435,8 @@ uint32_t PhysicsEngine::createRigidBody(float x, float y, float z, float width,
     uint32_t bodyId = cpuPhysics->createRigidBody(x, y, z, width, height, depth, mass, layer);
     
     if (bodyId != 0) {
-        LOG_INFO(LogCategory::RIGIDBODY, "Created rigidbody " + std::to_string(bodyId) + 
-                 " at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + 
-                 ") with dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ", " + std::to_string(depth) + ")");
+        LOG_INFO(LogCategory::RIGIDBODY, "Created rigidbody {} at ({}, {}, {}) with dimensions ({}, {}, {})",
+                 bodyId, x, y, z, width, height, depth);
     }
     
     return bodyId;
@@ -171,7 +449,7 @@ bool PhysicsEngine::removeRigidBody(uint32_t bodyId) {
     
     bool success = cpuPhysics->removeRigidBody(bodyId);
     if (success) {
-        LOG_INFO(LogCategory::RIGIDBODY, "Removed rigidbody " + std::to_string(bodyId));
+        LOG_INFO(LogCategory::RIGIDBODY, "Removed rigidbody {}", bodyId);
     }
     
     return success;
@@ -185,6 +463,14 @@ cpu_physics::RigidBodyComponent* PhysicsEngine::getRigidBody(uint32_t bodyId) {
     return cpuPhysics->getRigidBody(bodyId);
 }
 
+bool PhysicsEngine::setContinuousCollision(uint32_t bodyId, bool enabled) {
+    if (!cpuPhysics) {
+        return false;
+    }
+    
+    return cpuPhysics->setContinuousCollision(bodyId, enabled);
+}
+
 // Layer system for collision filtering
 uint32_t PhysicsEngine::createPhysicsLayer(const std::string& name) {
     if (!cpuPhysics) {
@@ -2,6 +2,10 @@
 
 #include <memory>
 #include <vector>
+#include <string>
+#include <cstdint>
+#include "CPUPhysicsEngine/systems/StepBudgetStats.h"
+#include "CPUPhysicsEngine/systems/PhysicsStepStats.h"
 
 // Forward declarations
 #ifdef VULKAN_AVAILABLE
@@ -10,6 +14,11 @@ namespace gpu_physics {
 }
 #endif
 
+class JobSystem;
+class JobCounter;
+class MetricsExporter;
+struct AllocationCounts;
+
 namespace cpu_physics {
     class CPUPhysicsEngine;
     class RigidBodyComponent;
@@ -21,6 +30,11 @@ namespace cpu_physics {
  * This is the main orchestrator for the titanium-physics system that manages:
  * - GPU physics for particles and fluid simulations (when Vulkan is available)
  * - CPU physics for complex rigidbody operations with ECS architecture
+ * - Fixed-timestep scheduling with substepping and render interpolation
+ * - Asynchronous stepping that overlaps the GPU and CPU work with the caller
+ * - Time budgets that degrade accuracy instead of overrunning the frame
+ * - Per-step statistics with a rolling history for telemetry
+ * - An optional shared-memory metrics page for external monitors
  */
 class PhysicsEngine {
 public:
@@ -29,13 +43,49 @@ public:
     
     // Initialization
     bool initialize(uint32_t maxParticles = 1024, uint32_t maxRigidBodies = 512);
+    // Run CPU physics on a host-provided job system (call before initialize)
+    void setJobSystem(std::shared_ptr<JobSystem> jobs) { hostJobSystem = std::move(jobs); }
     void cleanup();
     bool isInitialized() const { return initialized; }
     
     // Physics simulation
-    void updatePhysics(float deltaTime);
+    void updatePhysics(float deltaTime, float budgetMs = 0.0f); // Single step of exactly deltaTime
+    
+    // Asynchronous step: beginStep() submits the GPU particle step, starts the CPU
+    // rigid body step on the job system and returns right away; endStep() blocks
+    // until both are done. Bodies must not be read or changed in between.
+    void beginStep(float deltaTime);
+    void endStep();
+    bool isStepInFlight() const { return stepInFlight; }
     void setGravity(float x, float y, float z);
     
+    // Fixed-timestep scheduling: accumulates frame time and runs whole substeps,
+    // returns the number of substeps taken this frame. With budgetMs > 0 the
+    // substeps share the budget: each may cut solver iterations and defer sleep
+    // checks, and substeps predicted not to fit are dropped.
+    uint32_t update(float frameTime, float budgetMs = 0.0f);
+    void setFixedTimestep(float stepSeconds);
+    void setSimulationRate(float hertz) { setFixedTimestep(1.0f / hertz); }
+    float getFixedTimestep() const { return fixedTimestep; }
+    // Degradations applied during the last update() (or updatePhysics()) call
+    const cpu_physics::StepBudgetStats& getLastBudgetStats() const { return lastBudgetStats; }
+    void setMaxSubsteps(uint32_t substeps) { maxSubsteps = substeps > 0 ? substeps : 1; }
+    uint32_t getMaxSubsteps() const { return maxSubsteps; }
+    
+    // Counters and phase times of the last completed step, and of the steps before it
+    const cpu_physics::PhysicsStepStats& getLastStepStats() const { return lastStepStats; }
+    const cpu_physics::PhysicsStatsHistory& getStatsHistory() const { return statsHistory; }
+    void setStatsHistorySize(size_t steps) { statsHistory.setCapacity(steps); }
+    // Publishes every step's stats to a memory-mapped file read by titanium-top
+    bool enableMetricsExport(const std::string& path);
+    void disableMetricsExport();
+    bool isMetricsExportEnabled() const { return metricsExporter != nullptr; }
+    
+    // Fraction of a step left in the accumulator, used to blend the last two states
+    float getInterpolationAlpha() const { return interpolationAlpha; }
+    // Transform blended between the previous and current step for rendering
+    bool getInterpolatedTransform(uint32_t bodyId, float position[3], float rotation[4]) const;
+    
     // GPU Physics (Particles/Fluids) Interface - only available with Vulkan
     bool addParticle(float x, float y, float z, float vx = 0.0f, float vy = 0.0f, float vz = 0.0f, float mass = 1.0f);
     size_t getParticleCount() const;
@@ -44,6 +94,7 @@ public:
     uint32_t createRigidBody(float x, float y, float z, float width, float height, float depth, float mass = 1.0f, uint32_t layer = 0);
     bool removeRigidBody(uint32_t bodyId);
     cpu_physics::RigidBodyComponent* getRigidBody(uint32_t bodyId);
+    bool setContinuousCollision(uint32_t bodyId, bool enabled); // for fast bodies that would tunnel
     
     // Layer system for collision filtering
     uint32_t createPhysicsLayer(const std::string& name);
@@ -63,10 +114,43 @@ private:
     std::unique_ptr<gpu_physics::GPUPhysicsEngine> gpuPhysics;
 #endif
     std::unique_ptr<cpu_physics::CPUPhysicsEngine> cpuPhysics;
+    std::shared_ptr<JobSystem> hostJobSystem;
+    
+    // Asynchronous step state
+    bool stepInFlight = false;
+    std::unique_ptr<JobCounter> cpuStepCounter;
     
     struct {
         float x = 0.0f;
         float y = -9.81f;
         float z = 0.0f;
     } gravity;
+    
+    // Fixed-timestep state
+    float fixedTimestep = 1.0f / 60.0f;
+    uint32_t maxSubsteps = 4;
+    float accumulator = 0.0f;
+    float interpolationAlpha = 0.0f;
+    
+    // Time budget state
+    float substepMsEstimate = 0.0f; // running average of one substep's wall time
+    cpu_physics::StepBudgetStats lastBudgetStats;
+    
+    // Step statistics
+    uint64_t recordedSteps = 0;
+    cpu_physics::PhysicsStepStats lastStepStats;
+    cpu_physics::PhysicsStatsHistory statsHistory;
+    std::unique_ptr<MetricsExporter> metricsExporter;
+    
+    void recordStepStats(float totalMs, const AllocationCounts& allocations);
+    struct InterpolationState {
+        uint32_t entityId;
+        float position[3];
+        float rotation[4];
+    };
+    // One entry per body at the last capture, sorted by entity ID; the capacity is reused across frames,
+    // so it is bounded by the most bodies alive at once rather than by the entity IDs handed out
+    std::vector<InterpolationState> previousTransforms;
+    
+    void capturePreviousTransforms();
 };
\ No newline at end of file
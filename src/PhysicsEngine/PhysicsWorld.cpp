@@ -0,0 +1,115 @@
+#include "PhysicsWorld.h"
+#include "CPUPhysicsEngine/CPUPhysicsEngine.h"
+#include "managers/logmanager/Logger.h"
+#include "managers/jobmanager/JobSystem.h"
+
+SharedPhysicsResources::SharedPhysicsResources(uint32_t workerCount)
+    : jobSystem(std::make_shared<JobSystem>(workerCount)) {
+}
+
+SharedPhysicsResources::SharedPhysicsResources(std::shared_ptr<JobSystem> jobs)
+    : jobSystem(std::move(jobs)) {
+    if (!jobSystem) {
+        jobSystem = std::make_shared<JobSystem>();
+    }
+}
+
+PhysicsWorld::PhysicsWorld(std::shared_ptr<SharedPhysicsResources> resources)
+    : resources(std::move(resources)) {
+    if (!this->resources) {
+        this->resources = std::make_shared<SharedPhysicsResources>();
+    }
+}
+
+PhysicsWorld::~PhysicsWorld() {
+    cleanup();
+}
+
+bool PhysicsWorld::initialize(uint32_t maxRigidBodies) {
+    if (initialized) {
+        return true;
+    }
+
+    cpuPhysics = std::make_unique<cpu_physics::CPUPhysicsEngine>();
+    cpuPhysics->setJobSystem(resources->getJobSystem());
+    if (!cpuPhysics->initialize(maxRigidBodies)) {
+        LOG_ERROR(LogCategory::PHYSICS, "Failed to initialize physics world");
+        cpuPhysics.reset();
+        return false;
+    }
+
+    stepCount = 0;
+    initialized = true;
+    return true;
+}
+
+void PhysicsWorld::cleanup() {
+    if (!initialized) {
+        return;
+    }
+
+    cpuPhysics->cleanup();
+    cpuPhysics.reset();
+    initialized = false;
+}
+
+void PhysicsWorld::step(float deltaTime) {
+    if (!initialized) {
+        return;
+    }
+
+    cpuPhysics->updatePhysics(deltaTime);
+    stepCount++;
+}
+
+void PhysicsWorld::setGravity(float x, float y, float z) {
+    if (cpuPhysics) {
+        cpuPhysics->setGravity(x, y, z);
+    }
+}
+
+void PhysicsWorld::setDeterministic(bool enabled) {
+    if (cpuPhysics) {
+        cpuPhysics->setDeterministic(enabled);
+    }
+}
+
+uint64_t PhysicsWorld::getStateHash() const {
+    return cpuPhysics ? cpuPhysics->getLastStateHash() : 0;
+}
+
+uint32_t PhysicsWorld::createRigidBody(float x, float y, float z, float width, float height, float depth, float mass, uint32_t layer) {
+    if (!cpuPhysics) {
+        LOG_ERROR(LogCategory::PHYSICS, "Physics world not initialized, cannot create rigidbody");
+        return 0;
+    }
+    return cpuPhysics->createRigidBody(x, y, z, width, height, depth, mass, layer);
+}
+
+bool PhysicsWorld::removeRigidBody(uint32_t bodyId) {
+    return cpuPhysics ? cpuPhysics->removeRigidBody(bodyId) : false;
+}
+
+uint32_t PhysicsWorld::createPhysicsLayer(const std::string& name) {
+    return cpuPhysics ? cpuPhysics->createLayer(name) : 0;
+}
+
+bool PhysicsWorld::setLayerInteraction(uint32_t layer1, uint32_t layer2, bool canInteract) {
+    return cpuPhysics ? cpuPhysics->setLayerInteraction(layer1, layer2, canInteract) : false;
+}
+
+void PhysicsWorld::stepWorlds(const std::vector<PhysicsWorld*>& worlds, float deltaTime) {
+    if (worlds.empty()) {
+        return;
+    }
+
+    // Each world's own parallel stages nest inside its job
+    auto jobs = worlds.front()->resources->getJobSystem();
+    JobCounter counter;
+    for (PhysicsWorld* world : worlds) {
+        if (world) {
+            jobs->run([world, deltaTime]() { world->step(deltaTime); }, &counter);
+        }
+    }
+    jobs->wait(counter);
+}
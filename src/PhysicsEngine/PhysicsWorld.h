@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class JobSystem;
+
+namespace cpu_physics {
+    class CPUPhysicsEngine;
+}
+
+/**
+ * Shared Physics Resources - Process-wide state pooled across worlds
+ *
+ * Holds the resources every world can use without owning: the job system
+ * whose threads step all worlds. Nothing in here changes once it is created,
+ * so any number of worlds can use it from any thread.
+ */
+class SharedPhysicsResources {
+public:
+    // workerCount == 0 selects hardware_concurrency() - 1 background threads
+    explicit SharedPhysicsResources(uint32_t workerCount = 0);
+    explicit SharedPhysicsResources(std::shared_ptr<JobSystem> jobs);
+
+    std::shared_ptr<JobSystem> getJobSystem() const { return jobSystem; }
+
+private:
+    std::shared_ptr<JobSystem> jobSystem;
+};
+
+/**
+ * Physics World - One independent rigid body simulation
+ *
+ * Owns all per-simulation state (entities, layers, gravity, registered
+ * systems) and borrows the shared resources, so a process can host many
+ * worlds - one per match instance on a dedicated server - without a thread
+ * pool each. Worlds never touch each other's state, which lets stepWorlds()
+ * advance them concurrently on the shared job system.
+ */
+class PhysicsWorld {
+public:
+    explicit PhysicsWorld(std::shared_ptr<SharedPhysicsResources> resources);
+    ~PhysicsWorld();
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    bool initialize(uint32_t maxRigidBodies = 512);
+    void cleanup();
+    bool isInitialized() const { return initialized; }
+
+    // Simulation
+    void step(float deltaTime);
+    void setGravity(float x, float y, float z);
+    uint64_t getStepCount() const { return stepCount; }
+    
+    // Lockstep support: bit-identical stepping and a state hash per step to compare replicas
+    void setDeterministic(bool enabled);
+    uint64_t getStateHash() const;
+
+    // Rigid bodies and layers
+    uint32_t createRigidBody(float x, float y, float z, float width, float height, float depth, float mass = 1.0f, uint32_t layer = 0);
+    bool removeRigidBody(uint32_t bodyId);
+    uint32_t createPhysicsLayer(const std::string& name);
+    bool setLayerInteraction(uint32_t layer1, uint32_t layer2, bool canInteract);
+
+    cpu_physics::CPUPhysicsEngine* getCPUPhysics() const { return cpuPhysics.get(); }
+    const std::shared_ptr<SharedPhysicsResources>& getResources() const { return resources; }
+
+    // Steps every world by deltaTime, one job per world, and returns when all are done.
+    // Worlds stepped together should share one SharedPhysicsResources.
+    static void stepWorlds(const std::vector<PhysicsWorld*>& worlds, float deltaTime);
+
+private:
+    std::shared_ptr<SharedPhysicsResources> resources;
+    std::unique_ptr<cpu_physics::CPUPhysicsEngine> cpuPhysics;
+    bool initialized = false;
+    uint64_t stepCount = 0;
+};
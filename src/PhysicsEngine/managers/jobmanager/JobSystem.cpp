@@ -0,0 +1,287 @@
+#include "JobSystem.h"
+#include "../logmanager/Logger.h"
+#include "../profilemanager/AllocationTracker.h"
+#include <algorithm>
+
+namespace {
+
+// Worker identity of the current thread, so jobs pushed from a worker go to its own deque
+thread_local JobSystem* currentSystem = nullptr;
+thread_local uint32_t currentWorker = 0;
+
+} // namespace
+
+/**
+ * Mutex-guarded ring-buffer deque. The buffer only grows, so a steady
+ * workload does not allocate once the queues have warmed up.
+ */
+struct JobSystem::JobQueue {
+    struct Entry {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    std::mutex mutex;
+    std::vector<Entry> ring;
+    size_t head = 0;
+    size_t count = 0;
+
+    void pushBack(Job&& job, JobCounter* counter) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == ring.size()) {
+            grow();
+        }
+        Entry& entry = ring[(head + count) % ring.size()];
+        entry.job = std::move(job);
+        entry.counter = counter;
+        count++;
+    }
+
+    // Owner side (LIFO, the most recently pushed job is still hot in cache)
+    bool popBack(Entry& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) {
+            return false;
+        }
+        count--;
+        out = std::move(ring[(head + count) % ring.size()]);
+        return true;
+    }
+
+    // Thief side (FIFO, the oldest job tends to be the largest piece of work)
+    bool popFront(Entry& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) {
+            return false;
+        }
+        out = std::move(ring[head]);
+        head = (head + 1) % ring.size();
+        count--;
+        return true;
+    }
+
+private:
+    void grow() {
+        std::vector<Entry> larger(std::max<size_t>(64, ring.size() * 2));
+        for (size_t i = 0; i < count; i++) {
+            larger[i] = std::move(ring[(head + i) % ring.size()]);
+        }
+        ring.swap(larger);
+        head = 0;
+    }
+};
+
+// Shared state of one parallelFor() call; helpers claim batches from nextIndex
+struct JobSystem::ParallelForState {
+    const RangeFunction* func;
+    size_t count;
+    size_t batchSize;
+    std::atomic<size_t> nextIndex{0};
+
+    void runBatches() {
+        while (true) {
+            size_t begin = nextIndex.fetch_add(batchSize, std::memory_order_relaxed);
+            if (begin >= count) {
+                break;
+            }
+            (*func)(begin, std::min(begin + batchSize, count));
+        }
+    }
+};
+
+JobCounter::~JobCounter() {
+    // The thread that finished the last job may still hold the lock
+    std::lock_guard<std::mutex> lock(continuationMutex);
+}
+
+JobSystem::JobSystem(uint32_t workerCount) : JobSystem(workerCount, nullptr) {}
+
+JobSystem::JobSystem(uint32_t workerCount, ThreadLauncher launcher) {
+    if (workerCount == 0 && !launcher) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    this->workerCount = workerCount;
+
+    for (uint32_t i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    start(launcher);
+
+    LOG_INFO(LogCategory::PHYSICS, "Created job system with " + std::to_string(workerCount) + " workers" +
+             (launcher ? " on host threads" : ""));
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+        wakeCondition.notify_all();
+        loopsFinished.wait(lock, [this]() { return runningLoops == 0; });
+    }
+
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void JobSystem::start(const ThreadLauncher& launcher) {
+    runningLoops = workerCount;
+    for (uint32_t i = 0; i < workerCount; i++) {
+        auto loop = [this, i]() { workerLoop(i); };
+        if (launcher) {
+            launcher(loop);
+        } else {
+            threads.emplace_back(loop);
+        }
+    }
+}
+
+void JobSystem::run(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    push(std::move(job), counter);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, Job job, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+        if (!dependency.isDone()) {
+            dependency.continuations.push_back(std::move(job));
+            dependency.continuationCounters.push_back(counter);
+            return;
+        }
+    }
+    push(std::move(job), counter);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!tryRunJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t minBatchSize, const RangeFunction& func) {
+    if (count == 0) {
+        return;
+    }
+
+    // Aim for a few batches per thread so uneven batches still balance out
+    size_t threadCount = workerCount + 1;
+    size_t batchSize = std::max<size_t>(std::max<size_t>(minBatchSize, 1),
+                                        (count + threadCount * 4 - 1) / (threadCount * 4));
+    size_t batchCount = (count + batchSize - 1) / batchSize;
+
+    // Not worth waking anyone up
+    if (workerCount == 0 || batchCount == 1) {
+        func(0, count);
+        return;
+    }
+
+    ParallelForState state;
+    state.func = &func;
+    state.count = count;
+    state.batchSize = batchSize;
+
+    // Helpers allocate on behalf of the caller's tracked phase, if any
+    int allocationPhase = AllocationTracker::getThreadPhase();
+
+    JobCounter counter;
+    size_t helpers = std::min<size_t>(workerCount, batchCount - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        run([&state, allocationPhase]() {
+            AllocationPhaseHandoff handoff(allocationPhase);
+            state.runBatches();
+        }, &counter);
+    }
+
+    // The calling thread helps out, then keeps running jobs until the helpers are done
+    state.runBatches();
+    wait(counter);
+}
+
+void JobSystem::workerLoop(uint32_t workerIndex) {
+    currentSystem = this;
+    currentWorker = workerIndex;
+
+    while (true) {
+        if (tryRunJob()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() {
+            return stopping.load() || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping.load() && queuedJobs.load(std::memory_order_acquire) <= 0) {
+            break;
+        }
+    }
+
+    currentSystem = nullptr;
+
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    runningLoops--;
+    loopsFinished.notify_all();
+}
+
+void JobSystem::push(Job job, JobCounter* counter) {
+    uint32_t queueIndex = (currentSystem == this) ? currentWorker : workerCount;
+    queues[queueIndex]->pushBack(std::move(job), counter);
+    queuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this wake-up after a worker's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeCondition.notify_one();
+}
+
+bool JobSystem::tryRunJob() {
+    JobQueue::Entry entry;
+    bool isWorker = (currentSystem == this);
+    uint32_t self = isWorker ? currentWorker : workerCount;
+
+    bool found = isWorker ? queues[self]->popBack(entry) : queues[self]->popFront(entry);
+    for (uint32_t offset = 1; !found && offset <= workerCount; offset++) {
+        found = queues[(self + offset) % (workerCount + 1)]->popFront(entry);
+    }
+    if (!found) {
+        return false;
+    }
+
+    queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+    entry.job();
+    finishJob(entry.counter);
+    return true;
+}
+
+void JobSystem::finishJob(JobCounter* counter) {
+    if (!counter) {
+        return;
+    }
+
+    std::vector<Job> released;
+    std::vector<JobCounter*> releasedCounters;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        released.swap(counter->continuations);
+        releasedCounters.swap(counter->continuationCounters);
+    }
+
+    // The counter may be destroyed from here on
+    for (size_t i = 0; i < released.size(); i++) {
+        push(std::move(released[i]), releasedCounters[i]);
+    }
+}
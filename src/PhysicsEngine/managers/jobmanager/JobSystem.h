@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * Counts outstanding jobs. A counter reaches zero once every job scheduled
+ * against it has finished; JobSystem::wait() blocks on that and
+ * JobSystem::runAfter() uses it as a dependency.
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    ~JobCounter();
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> pending{0};
+
+    // Jobs waiting for this counter to reach zero
+    std::mutex continuationMutex;
+    std::vector<std::function<void()>> continuations;
+    std::vector<JobCounter*> continuationCounters;
+};
+
+/**
+ * Work-stealing job scheduler shared by the CPU physics stages.
+ *
+ * Each worker owns a deque: it pushes and pops its own jobs at the back and
+ * steals from the front of the other workers' deques when it runs dry. Jobs
+ * submitted from threads outside the system go to a shared injection queue.
+ * Threads that wait on a counter keep executing jobs, so nested
+ * parallelFor() calls from inside jobs cannot deadlock.
+ *
+ * Worker threads are created by the system, or run on a host application's
+ * own thread pool through a ThreadLauncher.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeFunction = std::function<void(size_t, size_t)>;
+
+    // Host thread pool hook: called once per worker with a loop that must be
+    // run on one of the host's threads. The loop returns when the system is destroyed.
+    using ThreadLauncher = std::function<void(std::function<void()>)>;
+
+    // workerCount == 0 selects hardware_concurrency() - 1 background threads
+    explicit JobSystem(uint32_t workerCount = 0);
+    JobSystem(uint32_t workerCount, ThreadLauncher launcher);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Number of worker threads (threads that wait also execute jobs)
+    uint32_t getWorkerCount() const { return workerCount; }
+
+    // Schedule a job; counter (if any) is incremented now and decremented when it finishes
+    void run(Job job, JobCounter* counter = nullptr);
+
+    // Schedule a job that starts once dependency reaches zero
+    void runAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+
+    // Execute jobs until counter reaches zero
+    void wait(JobCounter& counter);
+
+    // Invoke func(begin, end) over [0, count) and block until every range is done.
+    // The grain is max(minBatchSize, count / (4 * threads)); pass 0 for automatic sizing.
+    void parallelFor(size_t count, size_t minBatchSize, const RangeFunction& func);
+
+private:
+    struct JobQueue;
+    struct ParallelForState;
+
+    uint32_t workerCount = 0;
+    std::vector<std::unique_ptr<JobQueue>> queues; // one per worker plus the injection queue
+    std::vector<std::thread> threads;
+
+    std::atomic<int64_t> queuedJobs{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    // Worker loops still running (own threads or host threads)
+    uint32_t runningLoops = 0;
+    std::condition_variable loopsFinished;
+
+    void start(const ThreadLauncher& launcher);
+    void workerLoop(uint32_t workerIndex);
+    void push(Job job, JobCounter* counter);
+    bool tryRunJob();
+    void finishJob(JobCounter* counter);
+};
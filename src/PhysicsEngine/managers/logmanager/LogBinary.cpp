@@ -0,0 +1,179 @@
+#include "LogBinary.h"
+#include "LogFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Buffered records are written out once they reach this size
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+} // namespace
+
+bool BinaryLogWriter::open(const std::string& filename) {
+    close();
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    return static_cast<bool>(file);
+}
+
+void BinaryLogWriter::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+    buffer.clear();
+    stringIds.clear();
+}
+
+void BinaryLogWriter::write(uint64_t timestamp, LogLevel level, LogCategory category, LogRecordKind kind,
+                            const char* format, const std::string& payload) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    if (kind == LogRecordKind::TEXT || !format) {
+        uint32_t length = static_cast<uint32_t>(payload.size());
+        put(BinaryLogRecordType::TEXT);
+        put(timestamp);
+        put(static_cast<uint8_t>(level));
+        put(static_cast<uint8_t>(category));
+        put(length);
+        buffer.append(payload);
+    } else {
+        uint32_t id = internString(format);
+        uint16_t size = static_cast<uint16_t>(std::min<size_t>(payload.size(), std::numeric_limits<uint16_t>::max()));
+        put(kind == LogRecordKind::METRIC ? BinaryLogRecordType::METRIC : BinaryLogRecordType::FORMAT);
+        put(timestamp);
+        put(static_cast<uint8_t>(level));
+        put(static_cast<uint8_t>(category));
+        put(id);
+        put(size);
+        buffer.append(payload.data(), size);
+    }
+
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void BinaryLogWriter::flush() {
+    if (file.is_open() && !buffer.empty()) {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.flush();
+    }
+    buffer.clear();
+}
+
+uint32_t BinaryLogWriter::internString(const char* text) {
+    auto it = stringIds.find(text);
+    if (it != stringIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(stringIds.size());
+    stringIds.emplace(text, id);
+
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(std::strlen(text), std::numeric_limits<uint16_t>::max()));
+    put(BinaryLogRecordType::STRING);
+    put(id);
+    put(length);
+    buffer.append(text, length);
+    return id;
+}
+
+std::string BinaryLogEntry::text() const {
+    switch (kind) {
+        case LogRecordKind::FORMAT:
+            return LogArguments::format(format.c_str(), payload.data(), payload.size());
+        case LogRecordKind::METRIC:
+            return LogArguments::formatMetric(format.c_str(), payload.data(), payload.size());
+        default:
+            return payload;
+    }
+}
+
+bool BinaryLogReader::open(const std::string& filename) {
+    file.open(filename, std::ios::binary);
+    strings.clear();
+    damaged = false;
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(BinaryLogWriter::MAGIC)];
+    uint32_t version = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, BinaryLogWriter::MAGIC, sizeof(magic)) != 0 ||
+        !get(version) || version != BinaryLogWriter::VERSION) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool BinaryLogReader::next(BinaryLogEntry& entry) {
+    for (;;) {
+        BinaryLogRecordType type;
+        if (!get(type)) {
+            return false; // clean end of file
+        }
+
+        uint8_t level = 0;
+        uint8_t category = 0;
+        bool ok = true;
+        switch (type) {
+            case BinaryLogRecordType::STRING: {
+                uint32_t id = 0;
+                uint16_t length = 0;
+                std::string text;
+                ok = get(id) && get(length) && getBytes(text, length) && id == strings.size();
+                if (ok) {
+                    strings.push_back(std::move(text));
+                    continue;
+                }
+                break;
+            }
+            case BinaryLogRecordType::TEXT: {
+                uint32_t length = 0;
+                ok = get(entry.timestamp) && get(level) && get(category) && get(length) &&
+                     getBytes(entry.payload, length);
+                entry.kind = LogRecordKind::TEXT;
+                entry.format.clear();
+                break;
+            }
+            case BinaryLogRecordType::FORMAT:
+            case BinaryLogRecordType::METRIC: {
+                uint32_t id = 0;
+                uint16_t size = 0;
+                ok = get(entry.timestamp) && get(level) && get(category) && get(id) && get(size) &&
+                     id < strings.size() && getBytes(entry.payload, size);
+                if (ok) {
+                    entry.kind = type == BinaryLogRecordType::METRIC ? LogRecordKind::METRIC : LogRecordKind::FORMAT;
+                    entry.format = strings[id];
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok) {
+            damaged = true;
+            return false;
+        }
+        entry.level = static_cast<LogLevel>(level);
+        entry.category = static_cast<LogCategory>(category);
+        return true;
+    }
+}
+
+bool BinaryLogReader::getBytes(std::string& bytes, size_t length) {
+    bytes.resize(length);
+    return length == 0 || static_cast<bool>(file.read(bytes.data(), static_cast<std::streamsize>(length)));
+}
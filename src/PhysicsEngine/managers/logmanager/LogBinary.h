@@ -0,0 +1,99 @@
+#pragma once
+
+#include "LogRing.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Binary log file format.
+ *
+ * A file starts with the magic "TLOG" and a uint32 version, followed by
+ * records that each begin with a one-byte BinaryLogRecordType. Values are
+ * stored in host byte order.
+ *
+ *   STRING  uint32 id, uint16 length, bytes
+ *   TEXT    uint64 timestamp, uint8 level, uint8 category, uint32 length, bytes
+ *   FORMAT  uint64 timestamp, uint8 level, uint8 category, uint32 string id,
+ *           uint16 size, arguments as encoded by LogArguments
+ *   METRIC  as FORMAT; the string is the metric name and the arguments one value
+ *
+ * A format string or metric name is written as a STRING record the first
+ * time it is used; later records refer to it by id alone, so a message costs
+ * its raw argument bytes plus a 20-byte header and is never formatted.
+ */
+enum class BinaryLogRecordType : uint8_t {
+    STRING = 1,
+    TEXT = 2,
+    FORMAT = 3,
+    METRIC = 4
+};
+
+class BinaryLogWriter {
+public:
+    static constexpr char MAGIC[4] = {'T', 'L', 'O', 'G'};
+    static constexpr uint32_t VERSION = 1;
+
+    // Truncates the file and writes the header
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    // Buffers one message; format must be the same pointer for every use of a string
+    void write(uint64_t timestamp, LogLevel level, LogCategory category, LogRecordKind kind,
+               const char* format, const std::string& payload);
+
+    // Writes buffered records through to the file
+    void flush();
+
+private:
+    std::ofstream file;
+    std::string buffer;
+    std::unordered_map<const char*, uint32_t> stringIds;
+
+    uint32_t internString(const char* text);
+
+    template<typename T>
+    void put(const T& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+};
+
+// One message read back from a binary log
+struct BinaryLogEntry {
+    uint64_t timestamp = 0;
+    LogLevel level{};
+    LogCategory category{};
+    LogRecordKind kind = LogRecordKind::TEXT;
+    std::string format;  // format string or metric name
+    std::string payload; // text, or encoded arguments
+
+    // The message as the text sinks print it
+    std::string text() const;
+};
+
+class BinaryLogReader {
+public:
+    // False if the file cannot be read or is not a binary log
+    bool open(const std::string& filename);
+
+    // Next message; false at the end of the file or at a damaged record (see isDamaged())
+    bool next(BinaryLogEntry& entry);
+
+    bool isDamaged() const { return damaged; }
+    size_t getStringCount() const { return strings.size(); }
+
+private:
+    std::ifstream file;
+    std::vector<std::string> strings; // indexed by id
+    bool damaged = false;
+
+    template<typename T>
+    bool get(T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+    bool getBytes(std::string& bytes, size_t length);
+};
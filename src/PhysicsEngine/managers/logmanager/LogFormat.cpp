@@ -0,0 +1,137 @@
+#include "LogFormat.h"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// Reads the next encoded argument and appends it; false once the data runs out
+bool appendArgument(std::string& output, const char*& cursor, const char* end, int precision) {
+    if (cursor >= end) {
+        return false;
+    }
+
+    auto type = static_cast<LogArguments::Type>(*cursor++);
+    auto read = [&cursor, end](void* value, size_t bytes) {
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            return false;
+        }
+        std::memcpy(value, cursor, bytes);
+        cursor += bytes;
+        return true;
+    };
+
+    char number[64];
+    switch (type) {
+        case LogArguments::Type::BOOL: {
+            uint8_t value = 0;
+            if (!read(&value, sizeof(value))) return false;
+            output += value ? "true" : "false";
+            return true;
+        }
+        case LogArguments::Type::INT: {
+            int64_t value = 0;
+            if (!read(&value, sizeof(value))) return false;
+            output.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+            return true;
+        }
+        case LogArguments::Type::UINT: {
+            uint64_t value = 0;
+            if (!read(&value, sizeof(value))) return false;
+            output.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+            return true;
+        }
+        case LogArguments::Type::FLOAT:
+        case LogArguments::Type::DOUBLE: {
+            double value = 0.0;
+            if (type == LogArguments::Type::FLOAT) {
+                float single = 0.0f;
+                if (!read(&single, sizeof(single))) return false;
+                value = single;
+                if (precision < 0) {
+                    // Shortest text that reads back as the same float, like std::format
+                    output.append(number, std::to_chars(number, number + sizeof(number), single).ptr);
+                    return true;
+                }
+            } else if (!read(&value, sizeof(value))) {
+                return false;
+            }
+            if (precision < 0) {
+                output.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+            } else {
+                int length = std::snprintf(number, sizeof(number), "%.*f", precision, value);
+                output.append(number, static_cast<size_t>(std::max(length, 0)));
+            }
+            return true;
+        }
+        case LogArguments::Type::STRING: {
+            uint16_t length = 0;
+            if (!read(&length, sizeof(length)) || static_cast<size_t>(end - cursor) < length) return false;
+            output.append(cursor, length);
+            cursor += length;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+std::string LogArguments::format(const char* format, const char* arguments, size_t size) {
+    std::string output;
+    output.reserve(std::strlen(format) + size);
+    const char* cursor = arguments;
+    const char* end = arguments + size;
+
+    for (const char* c = format; *c; c++) {
+        if (c[0] == '{' && c[1] == '{') {
+            output += '{';
+            c++;
+        } else if (c[0] == '}' && c[1] == '}') {
+            output += '}';
+            c++;
+        } else if (c[0] == '{') {
+            // Placeholder: "{}" or "{:.N}" / "{:.Nf}"
+            const char* close = std::strchr(c, '}');
+            if (!close) {
+                output += c;
+                break;
+            }
+            int precision = -1;
+            if (c[1] == ':' && c[2] == '.') {
+                precision = std::atoi(c + 3);
+            }
+            if (!appendArgument(output, cursor, end, precision)) {
+                output += "{?}";
+            }
+            c = close;
+        } else {
+            output += *c;
+        }
+    }
+    return output;
+}
+
+std::string LogArguments::formatMetric(const char* name, const char* arguments, size_t size) {
+    std::string output = name;
+    output += '=';
+    const char* cursor = arguments;
+    if (!appendArgument(output, cursor, arguments + size, -1)) {
+        output += '?';
+    }
+    return output;
+}
+
+std::vector<LogArguments::Decoded> LogArguments::decode(const char* arguments, size_t size) {
+    std::vector<Decoded> decoded;
+    const char* cursor = arguments;
+    const char* end = arguments + size;
+    while (cursor < end) {
+        Decoded argument{static_cast<Type>(*cursor), std::string()};
+        if (!appendArgument(argument.text, cursor, end, -1)) {
+            break;
+        }
+        decoded.push_back(std::move(argument));
+    }
+    return decoded;
+}
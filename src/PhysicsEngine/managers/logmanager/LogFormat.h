@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Deferred log formatting.
+ *
+ * Producers capture a format string (which must outlive the program, i.e. be
+ * a literal) and encode its arguments as tagged raw bytes; the writer thread
+ * turns them into text only when the message is emitted. Format strings use
+ * std::format-style placeholders: "{}" for the next argument, "{:.3f}" /
+ * "{:.2}" for a float with fixed precision, and "{{" / "}}" for braces.
+ */
+class LogArguments {
+public:
+    enum class Type : uint8_t {
+        BOOL = 1,
+        INT = 2,    // int64
+        UINT = 3,   // uint64
+        FLOAT = 4,  // float
+        DOUBLE = 5,
+        STRING = 6  // uint16 length + bytes
+    };
+
+    static constexpr size_t CAPACITY = 1024;
+
+    // Encoded size so far; arguments that do not fit are dropped (strings are cut)
+    size_t size() const { return used; }
+    const char* data() const { return buffer; }
+
+    template<typename... Args>
+    void encode(const Args&... args) {
+        (add(args), ...);
+    }
+
+    // Text for format with the encoded arguments substituted
+    static std::string format(const char* format, const char* arguments, size_t size);
+
+    // Text for a metric record: "name=value"
+    static std::string formatMetric(const char* name, const char* arguments, size_t size);
+
+    // Each encoded argument as plain text (strings unquoted), e.g. for structured output
+    struct Decoded {
+        Type type;
+        std::string text;
+    };
+    static std::vector<Decoded> decode(const char* arguments, size_t size);
+
+private:
+    char buffer[CAPACITY];
+    size_t used = 0;
+
+    void put(Type type, const void* value, size_t bytes) {
+        if (used + 1 + bytes > CAPACITY) {
+            return;
+        }
+        buffer[used++] = static_cast<char>(type);
+        std::memcpy(buffer + used, value, bytes);
+        used += bytes;
+    }
+
+    void addString(const char* text, size_t length) {
+        if (used + 3 > CAPACITY) {
+            return;
+        }
+        uint16_t stored = static_cast<uint16_t>(std::min(length, CAPACITY - used - 3));
+        buffer[used++] = static_cast<char>(Type::STRING);
+        std::memcpy(buffer + used, &stored, sizeof(stored));
+        used += sizeof(stored);
+        std::memcpy(buffer + used, text, stored);
+        used += stored;
+    }
+
+    template<typename T>
+    void add(const T& value) {
+        using Value = std::decay_t<T>;
+        if constexpr (std::is_same_v<Value, bool>) {
+            uint8_t stored = value ? 1 : 0;
+            put(Type::BOOL, &stored, sizeof(stored));
+        } else if constexpr (std::is_enum_v<Value>) {
+            add(static_cast<std::underlying_type_t<Value>>(value));
+        } else if constexpr (std::is_integral_v<Value> && std::is_signed_v<Value>) {
+            int64_t stored = value;
+            put(Type::INT, &stored, sizeof(stored));
+        } else if constexpr (std::is_integral_v<Value>) {
+            uint64_t stored = value;
+            put(Type::UINT, &stored, sizeof(stored));
+        } else if constexpr (std::is_same_v<Value, float>) {
+            put(Type::FLOAT, &value, sizeof(value));
+        } else if constexpr (std::is_floating_point_v<Value>) {
+            double stored = static_cast<double>(value);
+            put(Type::DOUBLE, &stored, sizeof(stored));
+        } else if constexpr (std::is_same_v<Value, const char*> || std::is_same_v<Value, char*>) {
+            // Also taken for char arrays (string literals); the copy decays them so the null check is meaningful
+            const char* text = value;
+            addString(text ? text : "(null)", text ? std::strlen(text) : 6);
+        } else if constexpr (std::is_convertible_v<const Value&, std::string_view>) {
+            std::string_view view = value;
+            addString(view.data(), view.size());
+        } else {
+            static_assert(sizeof(Value) == 0, "Unsupported log argument type");
+        }
+    }
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum class LogLevel;
+enum class LogCategory;
+
+// What a record's payload holds
+enum class LogRecordKind : uint8_t {
+    TEXT = 0,   // message text
+    FORMAT = 1, // arguments for the format string, encoded by LogArguments
+    METRIC = 2  // one LogArguments-encoded value; format is the metric name
+};
+
+/**
+ * Fixed-size log record as written by a producer thread.
+ *
+ * The payload is the message text, or the arguments encoded by LogArguments
+ * for a format string or metric. A payload longer than one record continues in the
+ * records that follow it in the same ring; every part but the last has
+ * `continued` set.
+ */
+struct LogRecord {
+    static constexpr size_t PAYLOAD_SIZE = 224;
+
+    uint64_t timestamp = 0; // nanoseconds since the system clock epoch
+    const char* format = nullptr; // static format string or metric name, nullptr for text
+    LogRecordKind kind = LogRecordKind::TEXT;
+    LogLevel level{};
+    LogCategory category{};
+    uint16_t length = 0;    // bytes used in text
+    bool continued = false;
+    char text[PAYLOAD_SIZE];
+};
+
+/**
+ * Lock-free single-producer, single-consumer ring of log records.
+ *
+ * Each logging thread owns one ring and is its only producer; the logger's
+ * writer thread is the only consumer. Head and tail live on separate cache
+ * lines so the two sides do not false-share.
+ */
+class LogRing {
+public:
+    // capacity is rounded up to a power of two
+    explicit LogRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        records = std::make_unique<LogRecord[]>(size);
+    }
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer: record to fill, or nullptr when the ring is full; commit() publishes it
+    LogRecord* reserve() {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead > mask) {
+                return nullptr;
+            }
+        }
+        return &records[position & mask];
+    }
+
+    void commit() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer: oldest published record, or nullptr when empty; release() frees it
+    const LogRecord* peek() const {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &records[position & mask];
+    }
+
+    void release() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool isEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    // Set when the owning thread exits; the writer drops the ring once it is empty
+    std::atomic<bool> retired{false};
+
+private:
+    std::unique_ptr<LogRecord[]> records;
+    size_t mask = 0;
+
+    alignas(64) std::atomic<size_t> tail{0}; // producer
+    size_t cachedHead = 0;                   // producer's last view of head
+    alignas(64) std::atomic<size_t> head{0}; // consumer
+};
@@ -1,28 +1,72 @@
 #include "Logger.h"
+#include "LogBinary.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+// Set once the thread's ring is gone; later messages from the thread are written directly
+thread_local bool threadRingReleased = false;
+
+// Keeps the calling thread's ring registered and retires it when the thread exits
+struct ThreadRingHolder {
+    std::shared_ptr<LogRing> ring;
+    
+    ~ThreadRingHolder() {
+        threadRingReleased = true;
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRingHolder threadRingHolder;
+
+uint64_t nowNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
 
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
 }
 
+Logger::Logger() {
+    writerThread = std::thread([this]() { writerLoop(); });
+}
+
 Logger::~Logger() {
+    asyncEnabled.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopping = true;
+    }
+    writerWake.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join(); // drains every ring first
+    }
+    
     if (logFile && logFile->is_open()) {
         logFile->close();
     }
+    if (binaryFile) {
+        binaryFile->close();
+    }
 }
 
 void Logger::setLogLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    minLogLevel = level;
+    minLogLevel.store(level, std::memory_order_relaxed);
 }
 
 void Logger::enableCategory(LogCategory category, bool enabled) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    categoryEnabled[static_cast<int>(category)] = enabled;
+    categoryEnabled[static_cast<int>(category)].store(enabled, std::memory_order_relaxed);
 }
 
 void Logger::disableCategory(LogCategory category) {
@@ -30,6 +74,7 @@ void Logger::disableCategory(LogCategory category) {
 }
 
 void Logger::setOutputFile(const std::string& filename) {
+    flush(); // queued messages go to the file they were logged for
     std::lock_guard<std::mutex> lock(logMutex);
     
     if (logFile && logFile->is_open()) {
@@ -43,6 +88,29 @@ void Logger::setOutputFile(const std::string& filename) {
     }
 }
 
+void Logger::closeOutputFile() {
+    flush();
+    std::lock_guard<std::mutex> lock(logMutex);
+    logFile.reset();
+}
+
+void Logger::setBinaryOutputFile(const std::string& filename) {
+    flush();
+    std::lock_guard<std::mutex> lock(logMutex);
+    
+    binaryFile = std::make_unique<BinaryLogWriter>();
+    if (!binaryFile->open(filename)) {
+        std::cerr << "Failed to open binary log file: " << filename << std::endl;
+        binaryFile.reset();
+    }
+}
+
+void Logger::closeBinaryOutputFile() {
+    flush();
+    std::lock_guard<std::mutex> lock(logMutex);
+    binaryFile.reset(); // closing writes out its buffer
+}
+
 void Logger::enableConsoleOutput(bool enabled) {
     std::lock_guard<std::mutex> lock(logMutex);
     consoleOutput = enabled;
@@ -53,22 +121,250 @@ void Logger::enableTimestamps(bool enabled) {
     timestampsEnabled = enabled;
 }
 
+void Logger::setAsync(bool enabled) {
+    // Messages queued so far are written before the mode changes
+    if (!enabled) {
+        flush();
+    }
+    asyncEnabled.store(enabled, std::memory_order_release);
+}
+
 void Logger::log(LogLevel level, LogCategory category, const std::string& message) {
-    if (!shouldLog(level, category)) {
+    if (!isEnabled(level, category)) {
         return;
     }
     
+    uint64_t timestamp = nowNanoseconds();
+    if (asyncEnabled.load(std::memory_order_acquire) && !threadRingReleased) {
+        enqueue(level, category, LogRecordKind::TEXT, nullptr, message.data(), message.size(), timestamp);
+    } else {
+        writeMessage({timestamp, LogRecordKind::TEXT, nullptr, level, category, message});
+    }
+}
+
+void Logger::logEncoded(LogLevel level, LogCategory category, LogRecordKind kind, const char* format,
+                        const LogArguments& arguments) {
+    uint64_t timestamp = nowNanoseconds();
+    if (asyncEnabled.load(std::memory_order_acquire) && !threadRingReleased) {
+        enqueue(level, category, kind, format, arguments.data(), arguments.size(), timestamp);
+    } else {
+        writeMessage({timestamp, kind, format, level, category, std::string(arguments.data(), arguments.size())});
+    }
+}
+
+void Logger::flush() {
+    if (asyncEnabled.load(std::memory_order_acquire) && writerThread.joinable()) {
+        std::unique_lock<std::mutex> lock(writerMutex);
+        uint64_t ticket = ++flushRequested;
+        writerWake.notify_one();
+        flushDone.wait(lock, [this, ticket]() { return flushCompleted >= ticket || stopping; });
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(logMutex);
+    flushOutputs();
+}
+
+void Logger::flushOutputs() {
+    std::cout.flush();
+    if (logFile && logFile->is_open()) {
+        logFile->flush();
+    }
+    if (binaryFile) {
+        binaryFile->flush();
+    }
+}
+
+LogRing& Logger::threadRing() {
+    if (!threadRingHolder.ring) {
+        threadRingHolder.ring = std::make_shared<LogRing>(threadBufferCapacity.load(std::memory_order_relaxed));
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(threadRingHolder.ring);
+    }
+    return *threadRingHolder.ring;
+}
+
+void Logger::enqueue(LogLevel level, LogCategory category, LogRecordKind kind, const char* format,
+                     const char* payload, size_t size, uint64_t timestamp) {
+    LogRing& ring = threadRing();
+    
+    // A message that cannot fit in the ring even when empty is cut to the ring's size
+    size_t partCount = std::max<size_t>(1, (size + LogRecord::PAYLOAD_SIZE - 1) / LogRecord::PAYLOAD_SIZE);
+    partCount = std::min(partCount, ring.capacity());
+    
+    size_t offset = 0;
+    for (size_t part = 0; part < partCount; part++) {
+        LogRecord* record = ring.reserve();
+        while (!record) {
+            if (part == 0 && overflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy::DROP) {
+                droppedMessages.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // Blocking, or finishing a message already partly queued: wait for the writer
+            writerWake.notify_one();
+            std::this_thread::yield();
+            record = ring.reserve();
+        }
+        
+        size_t length = std::min(size - offset, LogRecord::PAYLOAD_SIZE);
+        record->timestamp = timestamp;
+        record->format = format;
+        record->kind = kind;
+        record->level = level;
+        record->category = category;
+        record->length = static_cast<uint16_t>(length);
+        record->continued = part + 1 < partCount;
+        std::memcpy(record->text, payload + offset, length);
+        ring.commit();
+        offset += length;
+    }
+}
+
+void Logger::writeMessage(PendingMessage message) {
+    std::vector<PendingMessage> single;
+    single.push_back(std::move(message));
+    writeBatch(single, 0);
+    
+    std::lock_guard<std::mutex> lock(logMutex);
+    flushOutputs();
+}
+
+void Logger::writerLoop() {
+    std::vector<PendingMessage> batch;
+    uint64_t droppedReported = 0;
+    
+    for (;;) {
+        uint64_t flushTicket;
+        bool exiting;
+        {
+            std::unique_lock<std::mutex> lock(writerMutex);
+            writerWake.wait_for(lock, std::chrono::milliseconds(5),
+                                [this]() { return stopping || flushRequested > flushCompleted; });
+            flushTicket = flushRequested;
+            exiting = stopping;
+        }
+        
+        // Drain until empty so a flush covers everything queued before it
+        while (drainRings(batch)) {
+            uint64_t dropped = droppedMessages.load(std::memory_order_relaxed);
+            writeBatch(batch, dropped - droppedReported);
+            droppedReported = dropped;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(logMutex);
+            flushOutputs();
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            flushCompleted = std::max(flushCompleted, flushTicket);
+        }
+        flushDone.notify_all();
+        
+        if (exiting) {
+            return;
+        }
+    }
+}
+
+bool Logger::drainRings(std::vector<PendingMessage>& batch) {
+    batch.clear();
+    
+    std::vector<std::shared_ptr<LogRing>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        // Rings of exited threads go once they are empty (retired is set after their last record)
+        rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<LogRing>& ring) {
+            return ring->retired.load(std::memory_order_acquire) && ring->isEmpty();
+        }), rings.end());
+        snapshot = rings;
+    }
+    
+    for (const auto& ring : snapshot) {
+        // Bounded per pass so one busy thread cannot starve the others
+        for (size_t taken = 0; taken < ring->capacity(); taken++) {
+            const LogRecord* record = ring->peek();
+            if (!record) {
+                break;
+            }
+            PendingMessage message{record->timestamp, record->kind, record->format, record->level,
+                                   record->category, std::string(record->text, record->length)};
+            bool continued = record->continued;
+            ring->release();
+            
+            // The rest of the message follows in the same ring; its producer may still be writing it
+            while (continued) {
+                const LogRecord* part;
+                while (!(part = ring->peek())) {
+                    std::this_thread::yield();
+                }
+                message.payload.append(part->text, part->length);
+                continued = part->continued;
+                ring->release();
+            }
+            batch.push_back(std::move(message));
+        }
+    }
+    
+    // Threads' rings are each in order; merge them by time
+    std::stable_sort(batch.begin(), batch.end(), [](const PendingMessage& a, const PendingMessage& b) {
+        return a.timestamp < b.timestamp;
+    });
+    return !batch.empty();
+}
+
+void Logger::writeBatch(std::vector<PendingMessage>& batch, uint64_t droppedSinceLastBatch) {
     std::lock_guard<std::mutex> lock(logMutex);
     
-    std::string formattedMessage = formatMessage(level, category, message);
+    if (droppedSinceLastBatch > 0) {
+        batch.insert(batch.begin(), PendingMessage{batch.front().timestamp, LogRecordKind::TEXT, nullptr,
+                                                   LogLevel::WARN, LogCategory::GENERAL,
+                                                   std::to_string(droppedSinceLastBatch) +
+                                                       " log messages dropped (buffer full)"});
+    }
     
-    if (consoleOutput) {
-        std::cout << formattedMessage << std::endl;
+    // The binary log takes the raw records; text is only built when a text sink wants it
+    if (binaryFile) {
+        for (const auto& message : batch) {
+            binaryFile->write(message.timestamp, message.level, message.category, message.kind, message.format,
+                              message.payload);
+        }
     }
     
-    if (logFile && logFile->is_open()) {
-        *logFile << formattedMessage << std::endl;
-        logFile->flush();
+    bool textFile = logFile && logFile->is_open();
+    if (!consoleOutput && !textFile) {
+        return;
+    }
+    
+    std::string output;
+    output.reserve(batch.size() * 96);
+    for (const auto& message : batch) {
+        switch (message.kind) {
+            case LogRecordKind::FORMAT:
+                output += formatMessage(message.level, message.category,
+                                        LogArguments::format(message.format, message.payload.data(),
+                                                             message.payload.size()),
+                                        message.timestamp);
+                break;
+            case LogRecordKind::METRIC:
+                output += formatMessage(message.level, message.category,
+                                        LogArguments::formatMetric(message.format, message.payload.data(),
+                                                                   message.payload.size()),
+                                        message.timestamp);
+                break;
+            default:
+                output += formatMessage(message.level, message.category, message.payload, message.timestamp);
+                break;
+        }
+        output += '\n';
+    }
+    
+    if (consoleOutput) {
+        std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+    }
+    if (textFile) {
+        logFile->write(output.data(), static_cast<std::streamsize>(output.size()));
     }
 }
 
@@ -117,48 +413,48 @@ void Logger::logPerformance(LogLevel level, const std::string& message) {
 }
 
 void Logger::logFrameTime(float frameTime) {
-    std::ostringstream oss;
-    oss << "Frame time: " << std::fixed << std::setprecision(3) << frameTime * 1000.0f << "ms";
-    logPerformance(LogLevel::DEBUG, oss.str());
+    logMetric(LogLevel::DEBUG, LogCategory::PERFORMANCE, "frame_time_ms", frameTime * 1000.0f);
 }
 
 void Logger::logCollisionCount(uint32_t collisionCount) {
-    std::ostringstream oss;
-    oss << "Active collisions: " << collisionCount;
-    logCollision(LogLevel::DEBUG, oss.str());
+    logMetric(LogLevel::DEBUG, LogCategory::PERFORMANCE, "active_collisions", collisionCount);
 }
 
 void Logger::logParticleCount(uint32_t particleCount) {
-    std::ostringstream oss;
-    oss << "Active particles: " << particleCount;
-    logParticles(LogLevel::DEBUG, oss.str());
+    logMetric(LogLevel::DEBUG, LogCategory::PARTICLES, "active_particles", particleCount);
 }
 
 void Logger::logRigidBodyCount(uint32_t rigidBodyCount) {
-    std::ostringstream oss;
-    oss << "Active rigid bodies: " << rigidBodyCount;
-    logRigidBody(LogLevel::DEBUG, oss.str());
+    logMetric(LogLevel::DEBUG, LogCategory::RIGIDBODY, "active_rigid_bodies", rigidBodyCount);
 }
 
-bool Logger::shouldLog(LogLevel level, LogCategory category) const {
-    return (level >= minLogLevel) && categoryEnabled[static_cast<int>(category)];
+std::string Logger::formatMessage(LogLevel level, LogCategory category, const std::string& message,
+                                  uint64_t timestamp) const {
+    return formatLine(level, category, message, timestamp, timestampsEnabled);
 }
 
-std::string Logger::formatMessage(LogLevel level, LogCategory category, const std::string& message) const {
-    std::ostringstream oss;
+std::string Logger::formatLine(LogLevel level, LogCategory category, const std::string& message,
+                               uint64_t timestamp, bool withTimestamp) {
+    std::string formatted;
+    formatted.reserve(message.size() + 40);
     
-    if (timestampsEnabled) {
-        oss << "[" << getCurrentTimestamp() << "] ";
+    if (withTimestamp) {
+        formatted += '[';
+        formatted += formatTimestamp(timestamp);
+        formatted += "] ";
     }
     
-    oss << "[" << logLevelToString(level) << "] ";
-    oss << "[" << logCategoryToString(category) << "] ";
-    oss << message;
+    formatted += '[';
+    formatted += logLevelToString(level);
+    formatted += "] [";
+    formatted += logCategoryToString(category);
+    formatted += "] ";
+    formatted += message;
     
-    return oss.str();
+    return formatted;
 }
 
-std::string Logger::logLevelToString(LogLevel level) const {
+std::string Logger::logLevelToString(LogLevel level) {
     switch (level) {
         case LogLevel::TRACE: return "TRACE";
         case LogLevel::DEBUG: return "DEBUG";
@@ -169,7 +465,7 @@ std::string Logger::logLevelToString(LogLevel level) const {
     }
 }
 
-std::string Logger::logCategoryToString(LogCategory category) const {
+std::string Logger::logCategoryToString(LogCategory category) {
     switch (category) {
         case LogCategory::GENERAL:     return "GENERAL   ";
         case LogCategory::PHYSICS:     return "PHYSICS   ";
@@ -182,15 +478,25 @@ std::string Logger::logCategoryToString(LogCategory category) const {
     }
 }
 
-std::string Logger::getCurrentTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+std::string Logger::formatTimestamp(uint64_t timestamp) {
+    // One-entry cache per thread: consecutive messages almost always share the second
+    static thread_local std::time_t cachedSecond = -1;
+    static thread_local char cachedClock[16] = {};
     
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t), "%H:%M:%S");
-    oss << "." << std::setfill('0') << std::setw(3) << ms.count();
+    std::time_t second = static_cast<std::time_t>(timestamp / 1000000000ull);
+    if (second != cachedSecond) {
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &second);
+#else
+        localtime_r(&second, &local);
+#endif
+        std::strftime(cachedClock, sizeof(cachedClock), "%H:%M:%S", &local);
+        cachedSecond = second;
+    }
     
-    return oss.str();
+    char formatted[24];
+    std::snprintf(formatted, sizeof(formatted), "%s.%03u", cachedClock,
+                  static_cast<unsigned>((timestamp / 1000000ull) % 1000));
+    return formatted;
 }
\ No newline at end of file
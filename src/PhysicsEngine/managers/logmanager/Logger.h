@@ -4,6 +4,21 @@
 #include <memory>
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "LogFormat.h"
+#include "LogRing.h"
+#include "../profilemanager/Profiler.h"
+
+class BinaryLogWriter;
+
+// Levels below this are compiled out of the LOG_* macros (0 = TRACE ... 4 = ERROR)
+#ifndef TITANIUM_LOG_MIN_LEVEL
+#define TITANIUM_LOG_MIN_LEVEL 0
+#endif
 
 enum class LogLevel {
     TRACE = 0,
@@ -23,6 +38,34 @@ enum class LogCategory {
     PERFORMANCE = 6
 };
 
+// What a logging thread does when its ring buffer is full
+enum class LogOverflowPolicy {
+    DROP = 0,  // discard the message and count it (never waits)
+    BLOCK = 1  // wait for the writer thread to make room
+};
+
+/**
+ * Process-wide logger.
+ *
+ * In asynchronous mode (the default) log() never takes a lock or touches a
+ * stream: the message is copied into fixed-size records in a lock-free ring
+ * owned by the calling thread, and a background writer thread formats the
+ * records of all threads in timestamp order and writes them in batches.
+ * flush() blocks until everything logged before it has been written, for
+ * shutdown and crash paths. Synchronous mode formats and writes on the
+ * calling thread, flushing after every message.
+ *
+ * The LOG_* macros check the level and category before evaluating their
+ * arguments, so a disabled message costs two relaxed loads. Given a format
+ * string and arguments (LOG_INFO(category, "Created body {} at {}", id, x))
+ * only the raw argument values are captured; the text is built on the
+ * writer thread.
+ *
+ * Besides the text sinks (console and file) messages can go to a binary log
+ * (setBinaryOutputFile) that stores format string ids and raw argument bytes
+ * instead of text; titanium-logdecode turns it back into text or JSON.
+ * logMetric() records a named number that the binary log keeps typed.
+ */
 class Logger {
 public:
     static Logger& getInstance();
@@ -32,11 +75,62 @@ public:
     void enableCategory(LogCategory category, bool enabled = true);
     void disableCategory(LogCategory category);
     void setOutputFile(const std::string& filename);
+    void closeOutputFile();
+    void setBinaryOutputFile(const std::string& filename); // replaces any previous binary log
+    void closeBinaryOutputFile();
     void enableConsoleOutput(bool enabled = true);
     void enableTimestamps(bool enabled = true);
     
+    // Asynchronous backend
+    void setAsync(bool enabled);
+    bool isAsync() const { return asyncEnabled.load(std::memory_order_acquire); }
+    void setOverflowPolicy(LogOverflowPolicy policy) { overflowPolicy.store(policy, std::memory_order_relaxed); }
+    void setThreadBufferCapacity(size_t records) { threadBufferCapacity.store(records, std::memory_order_relaxed); } // for threads that have not logged yet
+    uint64_t getDroppedMessageCount() const { return droppedMessages.load(std::memory_order_relaxed); }
+    void flush();
+    
+    // Cheap enough to call before building a message
+    bool isEnabled(LogLevel level, LogCategory category) const {
+        return level >= minLogLevel.load(std::memory_order_relaxed) &&
+               categoryEnabled[static_cast<int>(category)].load(std::memory_order_relaxed);
+    }
+    
     // Logging functions
     void log(LogLevel level, LogCategory category, const std::string& message);
+    
+    // Deferred formatting; format must be a string literal (it is kept by pointer)
+    template<typename... Args>
+    void logFormat(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+        if (!isEnabled(level, category)) {
+            return;
+        }
+        LogArguments arguments;
+        arguments.encode(args...);
+        logEncoded(level, category, LogRecordKind::FORMAT, format, arguments);
+    }
+    
+    // Named numeric value, written as "name=value" by the text sinks; name must be a string literal
+    template<typename T>
+    void logMetric(LogLevel level, LogCategory category, const char* name, T value) {
+        static_assert(std::is_arithmetic_v<T>, "Metrics are numbers");
+        if (!isEnabled(level, category)) {
+            return;
+        }
+        LogArguments arguments;
+        arguments.encode(value);
+        logEncoded(level, category, LogRecordKind::METRIC, name, arguments);
+    }
+    
+    // Used by the LOG_* macros: a lone message is logged as is, anything more is a format
+    template<typename Message, typename... Args>
+    void emit(LogLevel level, LogCategory category, const Message& message, const Args&... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            log(level, category, message);
+        } else {
+            logFormat(level, category, message, args...);
+        }
+    }
+
     void trace(LogCategory category, const std::string& message);
     void debug(LogCategory category, const std::string& message);
     void info(LogCategory category, const std::string& message);
@@ -56,36 +150,91 @@ public:
     void logCollisionCount(uint32_t collisionCount);
     void logParticleCount(uint32_t particleCount);
     void logRigidBodyCount(uint32_t rigidBodyCount);
+    
+    // Text sink layout, shared with the binary log decoder
+    static std::string formatLine(LogLevel level, LogCategory category, const std::string& message,
+                                  uint64_t timestamp, bool withTimestamp);
+    static std::string logLevelToString(LogLevel level);
+    static std::string logCategoryToString(LogCategory category);
 
 private:
-    Logger() = default;
+    Logger();
     ~Logger();
     
-    bool shouldLog(LogLevel level, LogCategory category) const;
-    std::string formatMessage(LogLevel level, LogCategory category, const std::string& message) const;
-    std::string logLevelToString(LogLevel level) const;
-    std::string logCategoryToString(LogCategory category) const;
-    std::string getCurrentTimestamp() const;
+    std::string formatMessage(LogLevel level, LogCategory category, const std::string& message,
+                              uint64_t timestamp) const;
+    static std::string formatTimestamp(uint64_t timestamp);
     
-    LogLevel minLogLevel = LogLevel::INFO;
-    bool categoryEnabled[7] = {true, true, true, true, true, true, true}; // All categories enabled by default
+    std::atomic<LogLevel> minLogLevel{LogLevel::INFO};
+    std::atomic<bool> categoryEnabled[7] = {true, true, true, true, true, true, true}; // All categories enabled by default
     bool consoleOutput = true;
     bool timestampsEnabled = true;
     
     std::unique_ptr<std::ofstream> logFile;
-    mutable std::mutex logMutex;
+    std::unique_ptr<BinaryLogWriter> binaryFile;
+    mutable std::mutex logMutex; // output configuration and streams
+    
+    // Asynchronous backend
+    struct PendingMessage {
+        uint64_t timestamp;
+        LogRecordKind kind;
+        const char* format;
+        LogLevel level;
+        LogCategory category;
+        std::string payload; // text, or encoded arguments for format / metric
+    };
+    
+    std::atomic<bool> asyncEnabled{true};
+    std::atomic<LogOverflowPolicy> overflowPolicy{LogOverflowPolicy::DROP};
+    std::atomic<uint64_t> droppedMessages{0};
+    std::atomic<size_t> threadBufferCapacity{512};
+    
+    std::mutex ringsMutex; // ring registration
+    std::vector<std::shared_ptr<LogRing>> rings;
+    
+    std::thread writerThread;
+    std::mutex writerMutex;
+    std::condition_variable writerWake;
+    std::condition_variable flushDone;
+    bool stopping = false;
+    uint64_t flushRequested = 0;
+    uint64_t flushCompleted = 0;
+    
+    LogRing& threadRing();
+    void logEncoded(LogLevel level, LogCategory category, LogRecordKind kind, const char* format,
+                    const LogArguments& arguments);
+    void enqueue(LogLevel level, LogCategory category, LogRecordKind kind, const char* format, const char* payload,
+                 size_t size, uint64_t timestamp);
+    void writeMessage(PendingMessage message);
+    void flushOutputs(); // caller holds logMutex
+    void writerLoop();
+    bool drainRings(std::vector<PendingMessage>& batch);
+    void writeBatch(std::vector<PendingMessage>& batch, uint64_t droppedSinceLastBatch);
 };
 
-// Convenience macros
-#define LOG_TRACE(category, message) Logger::getInstance().trace(category, message)
-#define LOG_DEBUG(category, message) Logger::getInstance().debug(category, message)
-#define LOG_INFO(category, message) Logger::getInstance().info(category, message)
-#define LOG_WARN(category, message) Logger::getInstance().warn(category, message)
-#define LOG_ERROR(category, message) Logger::getInstance().error(category, message)
+// Convenience macros: arguments are only evaluated when the message is enabled,
+// and levels below TITANIUM_LOG_MIN_LEVEL are removed at compile time. Enabled
+// messages are profiled as "log", building the message included
+#define TITANIUM_LOG(level, category, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= TITANIUM_LOG_MIN_LEVEL) { \
+            Logger& titaniumLogger = Logger::getInstance(); \
+            if (titaniumLogger.isEnabled(level, category)) { \
+                PROFILE_SCOPE("log"); \
+                titaniumLogger.emit(level, category, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_TRACE(category, ...) TITANIUM_LOG(LogLevel::TRACE, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) TITANIUM_LOG(LogLevel::DEBUG, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) TITANIUM_LOG(LogLevel::INFO, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) TITANIUM_LOG(LogLevel::WARN, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) TITANIUM_LOG(LogLevel::ERROR, category, __VA_ARGS__)
 
-#define LOG_PHYSICS_INFO(message) Logger::getInstance().logPhysics(LogLevel::INFO, message)
-#define LOG_COLLISION_INFO(message) Logger::getInstance().logCollision(LogLevel::INFO, message)
-#define LOG_RIGIDBODY_INFO(message) Logger::getInstance().logRigidBody(LogLevel::INFO, message)
-#define LOG_PARTICLES_INFO(message) Logger::getInstance().logParticles(LogLevel::INFO, message)
-#define LOG_VULKAN_INFO(message) Logger::getInstance().logVulkan(LogLevel::INFO, message)
-#define LOG_PERFORMANCE_INFO(message) Logger::getInstance().logPerformance(LogLevel::INFO, message)
\ No newline at end of file
+#define LOG_PHYSICS_INFO(...) LOG_INFO(LogCategory::PHYSICS, __VA_ARGS__)
+#define LOG_COLLISION_INFO(...) LOG_INFO(LogCategory::COLLISION, __VA_ARGS__)
+#define LOG_RIGIDBODY_INFO(...) LOG_INFO(LogCategory::RIGIDBODY, __VA_ARGS__)
+#define LOG_PARTICLES_INFO(...) LOG_INFO(LogCategory::PARTICLES, __VA_ARGS__)
+#define LOG_VULKAN_INFO(...) LOG_INFO(LogCategory::VULKAN, __VA_ARGS__)
+#define LOG_PERFORMANCE_INFO(...) LOG_INFO(LogCategory::PERFORMANCE, __VA_ARGS__)
@@ -0,0 +1,163 @@
+#include "MetricsPage.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+uint64_t wallClockNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+bool MetricsExporter::open(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    std::cerr << "Metrics export is not supported on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create metrics file: " << filename << std::endl;
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(sizeof(MetricsPageLayout))) != 0) {
+        std::cerr << "Failed to size metrics file: " << filename << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, sizeof(MetricsPageLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map metrics file: " << filename << std::endl;
+        return false;
+    }
+
+    // The truncated file is zero-filled; construct the atomics in place
+    page = static_cast<MetricsPageLayout*>(mapping);
+    new (&page->writerActive) std::atomic<uint32_t>(1);
+    new (&page->sequence) std::atomic<uint64_t>(0);
+    page->version = MetricsPageLayout::VERSION;
+    page->statsSize = static_cast<uint32_t>(sizeof(cpu_physics::PhysicsStepStats));
+    page->writerPid = static_cast<uint64_t>(::getpid());
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(page->magic, MetricsPageLayout::MAGIC, sizeof(page->magic));
+
+    path = filename;
+    published = 0;
+    return true;
+#endif
+}
+
+void MetricsExporter::close() {
+    if (!page) {
+        return;
+    }
+#ifndef _WIN32
+    page->writerActive.store(0, std::memory_order_release);
+    ::munmap(page, sizeof(MetricsPageLayout));
+#endif
+    page = nullptr;
+    path.clear();
+}
+
+void MetricsExporter::publish(const cpu_physics::PhysicsStepStats& stats) {
+    if (!page) {
+        return;
+    }
+    MetricsSnapshot snapshot;
+    snapshot.publishTime = wallClockNanoseconds();
+    snapshot.stats = stats;
+
+    // Single writer: odd while the copy is in progress, even once it is complete
+    uint64_t sequence = page->sequence.load(std::memory_order_relaxed);
+    page->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&page->snapshot, &snapshot, sizeof(snapshot));
+    page->sequence.store(sequence + 2, std::memory_order_release);
+    published++;
+}
+
+bool MetricsReader::open(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    std::cerr << "Metrics export is not supported on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MetricsPageLayout)) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, sizeof(MetricsPageLayout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    page = static_cast<const MetricsPageLayout*>(mapping);
+    bool valid = std::memcmp(page->magic, MetricsPageLayout::MAGIC, sizeof(page->magic)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valid || page->version != MetricsPageLayout::VERSION ||
+        page->statsSize != sizeof(cpu_physics::PhysicsStepStats)) {
+        close();
+        return false;
+    }
+    return true;
+#endif
+}
+
+void MetricsReader::close() {
+    if (!page) {
+        return;
+    }
+#ifndef _WIN32
+    ::munmap(const_cast<MetricsPageLayout*>(page), sizeof(MetricsPageLayout));
+#endif
+    page = nullptr;
+}
+
+bool MetricsReader::read(MetricsSnapshot& snapshot, int attempts) const {
+    if (!page) {
+        return false;
+    }
+    for (int attempt = 0; attempt < attempts; attempt++) {
+        uint64_t before = page->sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false; // nothing published yet
+        }
+        if (before & 1) {
+            std::this_thread::yield(); // the writer is mid-copy
+            continue;
+        }
+        std::memcpy(&snapshot, &page->snapshot, sizeof(snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page->sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MetricsReader::isWriterActive() const {
+    return page && page->writerActive.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t MetricsReader::getWriterPid() const {
+    return page ? page->writerPid : 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../../CPUPhysicsEngine/systems/PhysicsStepStats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// What the writer publishes each step, copied in one piece
+struct MetricsSnapshot {
+    uint64_t publishTime = 0; // nanoseconds since the Unix epoch
+    cpu_physics::PhysicsStepStats stats;
+};
+
+/**
+ * Fixed layout of a live metrics file.
+ *
+ * The header is written once when the file is created; magic is stored
+ * last so a reader never accepts a half-written header. The snapshot is
+ * guarded by a seqlock: sequence is odd while the writer copies a new
+ * snapshot in and even once it is complete, so a reader that sees the same
+ * even value before and after its copy has a consistent step. Values are
+ * stored in host byte order, and statsSize lets a reader refuse a page
+ * written by a build with a different PhysicsStepStats.
+ */
+struct MetricsPageLayout {
+    static constexpr char MAGIC[8] = {'T', 'I', 'M', 'E', 'T', 'R', 'I', 'C'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t statsSize;
+    uint64_t writerPid;
+    std::atomic<uint32_t> writerActive; // cleared when the writer closes the page
+
+    alignas(64) std::atomic<uint64_t> sequence; // 0 until the first snapshot
+    MetricsSnapshot snapshot;
+};
+
+// The page is shared between processes, so its atomics must not need a lock
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::is_trivially_copyable_v<MetricsSnapshot>);
+
+/**
+ * Publishes step statistics to a memory-mapped file for external monitors
+ * such as titanium-top. Publishing is one memcpy between two sequence
+ * stores; there are no system calls after open(). Only one process
+ * should write a given file. POSIX only.
+ */
+class MetricsExporter {
+public:
+    MetricsExporter() = default;
+    ~MetricsExporter() { close(); }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Creates (or truncates) the file and maps it; /dev/shm keeps it off the disk on Linux
+    bool open(const std::string& path);
+    // Marks the page inactive and unmaps it; the file is left for readers
+    void close();
+    bool isOpen() const { return page != nullptr; }
+    const std::string& getPath() const { return path; }
+
+    void publish(const cpu_physics::PhysicsStepStats& stats);
+    uint64_t getPublishedCount() const { return published; }
+
+private:
+    MetricsPageLayout* page = nullptr;
+    std::string path;
+    uint64_t published = 0;
+};
+
+// Reads the snapshots of a live metrics file
+class MetricsReader {
+public:
+    MetricsReader() = default;
+    ~MetricsReader() { close(); }
+
+    MetricsReader(const MetricsReader&) = delete;
+    MetricsReader& operator=(const MetricsReader&) = delete;
+
+    // False if the file cannot be mapped or was not written by a matching build
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return page != nullptr; }
+
+    // Latest complete snapshot; false before the first publish or if the writer
+    // kept overwriting it for every attempt
+    bool read(MetricsSnapshot& snapshot, int attempts = 64) const;
+
+    bool isWriterActive() const;
+    uint64_t getWriterPid() const;
+
+private:
+    const MetricsPageLayout* page = nullptr;
+};
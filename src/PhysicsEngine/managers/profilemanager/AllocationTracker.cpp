@@ -0,0 +1,207 @@
+#include "AllocationTracker.h"
+#include "../logmanager/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace {
+
+// Phase of allocations made inside a step but outside any AllocationPhase
+const char* const STEP_PHASE = "updatePhysics";
+
+} // namespace
+
+const AllocationTracker::Phase* AllocationTracker::StepReport::find(const char* name) const {
+    for (size_t i = 0; i < phaseCount; i++) {
+        if (std::strcmp(phases[i].name, name) == 0) {
+            return &phases[i];
+        }
+    }
+    return nullptr;
+}
+
+AllocationTracker& AllocationTracker::getInstance() {
+    static AllocationTracker instance;
+    return instance;
+}
+
+AllocationTracker::StepReport AllocationTracker::getLastStep() const {
+    std::lock_guard<std::mutex> lock(reportMutex);
+    return lastStep;
+}
+
+int AllocationTracker::phaseIndex(const char* name) {
+    // Literals with the same text may have different addresses in different translation units
+    size_t count = phaseCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        const char* known = phaseNames[i].load(std::memory_order_relaxed);
+        if (known == name || std::strcmp(known, name) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    count = phaseCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(phaseNames[i].load(std::memory_order_relaxed), name) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    if (count == MAX_PHASES) {
+        return 0; // table full: the step phase takes the rest
+    }
+    phaseNames[count].store(name, std::memory_order_relaxed);
+    phaseCount.store(count + 1, std::memory_order_release);
+    return static_cast<int>(count);
+}
+
+void AllocationTracker::beginStep() {
+    size_t count = phaseCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        phaseAllocations[i].store(0, std::memory_order_relaxed);
+        phaseBytes[i].store(0, std::memory_order_relaxed);
+    }
+    threadPhase = phaseIndex(STEP_PHASE);
+}
+
+AllocationCounts AllocationTracker::endStep() {
+    threadPhase = -1;
+
+    StepReport report;
+    report.phaseCount = phaseCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < report.phaseCount; i++) {
+        Phase& phase = report.phases[i];
+        phase.name = phaseNames[i].load(std::memory_order_relaxed);
+        phase.counts.allocations = phaseAllocations[i].load(std::memory_order_relaxed);
+        phase.counts.bytes = phaseBytes[i].load(std::memory_order_relaxed);
+        report.total.allocations += phase.counts.allocations;
+        report.total.bytes += phase.counts.bytes;
+    }
+    {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        report.step = trackedSteps++;
+        lastStep = report;
+    }
+
+    if (report.total.allocations > 0 && getZeroAllocationCheck() == ZeroAllocationCheck::REPORT) {
+        violations.fetch_add(1, std::memory_order_relaxed);
+        std::string phases;
+        for (size_t i = 0; i < report.phaseCount; i++) {
+            const Phase& phase = report.phases[i];
+            if (phase.counts.allocations > 0) {
+                phases += ' ';
+                phases += phase.name;
+                phases += '=';
+                phases += std::to_string(phase.counts.allocations);
+            }
+        }
+        LOG_WARN(LogCategory::PERFORMANCE, "Step expected to allocate nothing made {} allocations ({} bytes):{}",
+                 report.total.allocations, report.total.bytes, phases);
+    }
+    return report.total;
+}
+
+void AllocationTracker::record(int phase, size_t size) {
+    phaseAllocations[phase].fetch_add(1, std::memory_order_relaxed);
+    phaseBytes[phase].fetch_add(size, std::memory_order_relaxed);
+
+    if (getZeroAllocationCheck() == ZeroAllocationCheck::ABORT) {
+        // Nothing here may allocate
+        threadPhase = -1;
+        std::fputs("Allocation in a physics step expected to allocate nothing, phase: ", stderr);
+        std::fputs(phaseNames[phase].load(std::memory_order_relaxed), stderr);
+        std::fputs("\n", stderr);
+        std::abort();
+    }
+}
+
+#if TITANIUM_ALLOCATION_TRACKING
+
+// Replacement global allocation functions: every form of new counts and then
+// defers to malloc (aligned_alloc for over-aligned types); every delete frees
+
+namespace {
+
+void* allocate(size_t size) {
+    AllocationTracker::recordAllocation(size);
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(size_t size, std::align_val_t alignment) {
+    AllocationTracker::recordAllocation(size);
+    size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+    size_t rounded = (std::max<size_t>(size, 1) + align - 1) / align * align;
+#ifdef _WIN32
+    void* memory = _aligned_malloc(rounded, align);
+#else
+    void* memory = std::aligned_alloc(align, rounded);
+#endif
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void deallocateAligned(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { deallocateAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { deallocateAligned(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { deallocateAligned(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { deallocateAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { deallocateAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { deallocateAligned(memory); }
+
+#endif
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+// The global operator new is replaced (and allocations counted) unless TITANIUM_ALLOCATION_TRACKING is 0
+#ifndef TITANIUM_ALLOCATION_TRACKING
+#define TITANIUM_ALLOCATION_TRACKING 1
+#endif
+
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// What a tracked step does when it allocates while zero allocations are expected
+enum class ZeroAllocationCheck {
+    OFF,
+    REPORT, // count the step in getViolationCount() and log the phases that allocated
+    ABORT   // print the phase and abort inside the offending allocation, so a debugger or core dump has its stack
+};
+
+/**
+ * Counts operator new calls made while a physics step is being tracked.
+ *
+ * PhysicsEngine::updatePhysics opens an AllocationStep; inside it every
+ * allocation on the stepping thread, and on job system workers running the
+ * step's parallelFor ranges, is added to the innermost AllocationPhase of
+ * its thread ("updatePhysics" outside any phase). Allocations made by other
+ * threads, or through malloc directly, are not seen. Disabled (the default),
+ * an allocation costs one thread-local load on top of malloc.
+ *
+ * With a zero-allocation check enabled, a steady-state step (enable the
+ * check after warming up) that allocates anything is reported or aborts.
+ */
+class AllocationTracker {
+public:
+    static constexpr size_t MAX_PHASES = 32;
+
+    struct Phase {
+        const char* name = nullptr;
+        AllocationCounts counts;
+    };
+
+    // Counts of the last tracked step, per phase in order of first use
+    struct StepReport {
+        uint64_t step = 0; // tracked steps before this one
+        AllocationCounts total;
+        Phase phases[MAX_PHASES];
+        size_t phaseCount = 0;
+
+        const Phase* find(const char* name) const;
+    };
+
+    static AllocationTracker& getInstance();
+
+    // False when operator new is not replaced (TITANIUM_ALLOCATION_TRACKING=0)
+    static constexpr bool isAvailable() { return TITANIUM_ALLOCATION_TRACKING != 0; }
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool value) { enabled.store(value && isAvailable(), std::memory_order_relaxed); }
+
+    void setZeroAllocationCheck(ZeroAllocationCheck check) { zeroCheck.store(check, std::memory_order_relaxed); }
+    ZeroAllocationCheck getZeroAllocationCheck() const { return zeroCheck.load(std::memory_order_relaxed); }
+    uint64_t getViolationCount() const { return violations.load(std::memory_order_relaxed); }
+
+    // Copy of the last finished step (tracked steps do not overlap)
+    StepReport getLastStep() const;
+
+    // Used by operator new and the scopes
+    static void recordAllocation(size_t size) {
+        if (threadPhase >= 0) {
+            getInstance().record(threadPhase, size);
+        }
+    }
+    static int getThreadPhase() { return threadPhase; }
+    static void setThreadPhase(int phase) { threadPhase = phase; }
+    int phaseIndex(const char* name);
+    void beginStep();
+    AllocationCounts endStep();
+
+private:
+    AllocationTracker() = default;
+
+    static inline std::atomic<bool> enabled{false};
+    // Phase the calling thread's allocations go to; -1 while its allocations are not tracked
+    static inline thread_local int threadPhase = -1;
+
+    std::atomic<ZeroAllocationCheck> zeroCheck{ZeroAllocationCheck::OFF};
+    std::atomic<uint64_t> violations{0};
+
+    // Phase table of the step in progress; names are only appended, under phaseMutex
+    std::atomic<const char*> phaseNames[MAX_PHASES] = {};
+    std::atomic<uint64_t> phaseAllocations[MAX_PHASES] = {};
+    std::atomic<uint64_t> phaseBytes[MAX_PHASES] = {};
+    std::atomic<size_t> phaseCount{0};
+    std::mutex phaseMutex;
+
+    mutable std::mutex reportMutex;
+    StepReport lastStep;
+    uint64_t trackedSteps = 0;
+
+    void record(int phase, size_t size);
+};
+
+// Tracks the calling thread's allocations until the end of the block (PhysicsEngine::updatePhysics)
+class AllocationStep {
+public:
+    AllocationStep() {
+        if (AllocationTracker::isEnabled() && AllocationTracker::getThreadPhase() < 0) {
+            active = true;
+            AllocationTracker::getInstance().beginStep();
+        }
+    }
+
+    ~AllocationStep() { finish(); }
+
+    // Stops tracking early; the step's totals (zero if it was not tracked)
+    AllocationCounts finish() {
+        if (active) {
+            active = false;
+            totals = AllocationTracker::getInstance().endStep();
+        }
+        return totals;
+    }
+
+    AllocationStep(const AllocationStep&) = delete;
+    AllocationStep& operator=(const AllocationStep&) = delete;
+
+private:
+    bool active = false;
+    AllocationCounts totals;
+};
+
+// Attributes the calling thread's tracked allocations to name until the end of the block
+class AllocationPhase {
+public:
+    // name must be a string literal (it is kept by pointer)
+    explicit AllocationPhase(const char* name) : previous(AllocationTracker::getThreadPhase()) {
+        if (previous >= 0) {
+            AllocationTracker::setThreadPhase(AllocationTracker::getInstance().phaseIndex(name));
+        }
+    }
+
+    ~AllocationPhase() { AllocationTracker::setThreadPhase(previous); }
+
+    AllocationPhase(const AllocationPhase&) = delete;
+    AllocationPhase& operator=(const AllocationPhase&) = delete;
+
+private:
+    int previous;
+};
+
+// Runs the block under another thread's phase, e.g. a worker executing part of a tracked step
+class AllocationPhaseHandoff {
+public:
+    explicit AllocationPhaseHandoff(int phase) : previous(AllocationTracker::getThreadPhase()) {
+        AllocationTracker::setThreadPhase(phase);
+    }
+
+    ~AllocationPhaseHandoff() { AllocationTracker::setThreadPhase(previous); }
+
+    AllocationPhaseHandoff(const AllocationPhaseHandoff&) = delete;
+    AllocationPhaseHandoff& operator=(const AllocationPhaseHandoff&) = delete;
+
+private:
+    int previous;
+};
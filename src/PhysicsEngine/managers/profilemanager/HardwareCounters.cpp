@@ -0,0 +1,175 @@
+#include "HardwareCounters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+
+struct CounterDefinition {
+    uint32_t type;
+    uint64_t config;
+    uint32_t mask;
+    uint64_t HardwareCounterValues::*field;
+};
+
+// The first one leads the group; without it nothing is counted
+const CounterDefinition COUNTERS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, COUNTER_CYCLES, &HardwareCounterValues::cycles},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, COUNTER_INSTRUCTIONS, &HardwareCounterValues::instructions},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+     COUNTER_L1D_MISSES, &HardwareCounterValues::l1dMisses},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, COUNTER_LLC_MISSES, &HardwareCounterValues::llcMisses},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, COUNTER_BRANCH_MISSES, &HardwareCounterValues::branchMisses},
+};
+constexpr size_t COUNTER_COUNT = sizeof(COUNTERS) / sizeof(COUNTERS[0]);
+
+// The calling thread's counter group, closed when the thread exits
+struct ThreadCounters {
+    int fds[COUNTER_COUNT] = {-1, -1, -1, -1, -1};
+    const CounterDefinition* order[COUNTER_COUNT] = {}; // group read order
+    size_t opened = 0;
+    bool attempted = false;
+    int error = 0; // errno of the group leader
+
+    ~ThreadCounters() {
+        for (size_t i = 0; i < opened; i++) {
+            ::close(fds[i]);
+        }
+    }
+
+    bool open() {
+        attempted = true;
+        for (const CounterDefinition& counter : COUNTERS) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = counter.type;
+            attr.config = counter.config;
+            attr.exclude_kernel = 1; // allowed at perf_event_paranoid 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.disabled = opened == 0 ? 1 : 0; // the leader starts the whole group
+            int groupFd = opened == 0 ? -1 : fds[0];
+            int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+            if (fd < 0) {
+                if (opened == 0) {
+                    error = errno;
+                    return false;
+                }
+                continue; // this CPU lacks the event; count the rest
+            }
+            fds[opened] = fd;
+            order[opened] = &counter;
+            opened++;
+        }
+        ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+    }
+
+    uint32_t mask() const {
+        uint32_t bits = 0;
+        for (size_t i = 0; i < opened; i++) {
+            bits |= order[i]->mask;
+        }
+        return bits;
+    }
+};
+
+thread_local ThreadCounters threadCounters;
+
+ThreadCounters* threadGroup() {
+    if (!threadCounters.attempted) {
+        threadCounters.open();
+    }
+    return threadCounters.opened > 0 ? &threadCounters : nullptr;
+}
+
+#endif
+
+} // namespace
+
+HardwareCounters& HardwareCounters::getInstance() {
+    static HardwareCounters instance;
+    return instance;
+}
+
+bool HardwareCounters::setEnabled(bool value) {
+    if (!value) {
+        enabled.store(false, std::memory_order_relaxed);
+        return true;
+    }
+#ifdef __linux__
+    ThreadCounters* group = threadGroup();
+    std::lock_guard<std::mutex> lock(reasonMutex);
+    if (!group) {
+        int error = threadCounters.error;
+        if (error == ENOENT || error == EOPNOTSUPP) {
+            unavailableReason = "no hardware performance counters (virtual machine or container without a PMU)";
+        } else if (error == EACCES || error == EPERM) {
+            unavailableReason = "perf_event_open not permitted (see /proc/sys/kernel/perf_event_paranoid)";
+        } else if (error == ENOSYS) {
+            unavailableReason = "perf_event_open not supported by the kernel";
+        } else {
+            unavailableReason = std::string("perf_event_open failed: ") + std::strerror(error);
+        }
+        availableCounters.store(0, std::memory_order_relaxed);
+        enabled.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    unavailableReason.clear();
+    availableCounters.store(group->mask(), std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_relaxed);
+    return true;
+#else
+    std::lock_guard<std::mutex> lock(reasonMutex);
+    unavailableReason = "hardware counters are only read on Linux";
+    return false;
+#endif
+}
+
+std::string HardwareCounters::getUnavailableReason() const {
+    std::lock_guard<std::mutex> lock(reasonMutex);
+    return unavailableReason;
+}
+
+bool HardwareCounters::read(HardwareCounterValues& values) {
+    values = HardwareCounterValues{};
+    if (!isEnabled()) {
+        return false;
+    }
+#ifdef __linux__
+    ThreadCounters* group = threadGroup();
+    if (!group) {
+        return false;
+    }
+    // PERF_FORMAT_GROUP layout: count, time enabled, time running, then one value per counter
+    uint64_t buffer[3 + COUNTER_COUNT];
+    ssize_t size = ::read(group->fds[0], buffer, sizeof(buffer));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buffer[0] > group->opened) {
+        return false;
+    }
+    uint64_t timeEnabled = buffer[1];
+    uint64_t timeRunning = buffer[2];
+    for (uint64_t i = 0; i < buffer[0]; i++) {
+        uint64_t count = buffer[3 + i];
+        // Scale when the kernel had to multiplex the group with other events
+        if (timeRunning > 0 && timeRunning < timeEnabled) {
+            count = static_cast<uint64_t>(static_cast<double>(count) * static_cast<double>(timeEnabled) /
+                                          static_cast<double>(timeRunning));
+        }
+        values.*(group->order[i]->field) = count;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
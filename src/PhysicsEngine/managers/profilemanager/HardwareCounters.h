@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Counts of one measured region; counters that could not be opened stay zero
+struct HardwareCounterValues {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t l1dMisses = 0;    // L1 data cache read misses
+    uint64_t llcMisses = 0;    // last level cache misses
+    uint64_t branchMisses = 0;
+
+    // Instructions per cycle, 0 when nothing was counted
+    double ipc() const { return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0; }
+
+    HardwareCounterValues& operator+=(const HardwareCounterValues& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        l1dMisses += other.l1dMisses;
+        llcMisses += other.llcMisses;
+        branchMisses += other.branchMisses;
+        return *this;
+    }
+};
+
+// Bits of HardwareCounters::getAvailableCounters()
+enum HardwareCounterMask : uint32_t {
+    COUNTER_CYCLES = 1u << 0,
+    COUNTER_INSTRUCTIONS = 1u << 1,
+    COUNTER_L1D_MISSES = 1u << 2,
+    COUNTER_LLC_MISSES = 1u << 3,
+    COUNTER_BRANCH_MISSES = 1u << 4,
+};
+
+/**
+ * CPU performance counters of the calling thread (Linux perf_event_open).
+ *
+ * Each thread opens its own counter group the first time it reads while the
+ * counters are enabled, counting user space only. Counters are unavailable
+ * off Linux, without a PMU (most VMs and containers) or when
+ * kernel.perf_event_paranoid forbids them; setEnabled(true) then returns
+ * false, stays disabled and keeps the reason. Counters the CPU lacks are
+ * left out of the group and read as zero.
+ */
+class HardwareCounters {
+public:
+    static HardwareCounters& getInstance();
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    // Enabling opens the counters on the calling thread; false when they cannot be read
+    bool setEnabled(bool value);
+
+    uint32_t getAvailableCounters() const { return availableCounters.load(std::memory_order_relaxed); }
+    std::string getUnavailableReason() const;
+
+    // Counts of the calling thread so far; false while disabled or if the thread has no counters
+    bool read(HardwareCounterValues& values);
+
+private:
+    HardwareCounters() = default;
+
+    static inline std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> availableCounters{0};
+
+    mutable std::mutex reasonMutex;
+    std::string unavailableReason;
+};
+
+// Adds the calling thread's counts over the enclosing block to target while the counters are enabled
+class CounterScope {
+public:
+    explicit CounterScope(HardwareCounterValues& counterTarget) : target(counterTarget) {
+        active = HardwareCounters::isEnabled() && HardwareCounters::getInstance().read(begin);
+    }
+
+    ~CounterScope() {
+        HardwareCounterValues end;
+        if (active && HardwareCounters::getInstance().read(end)) {
+            target.cycles += delta(begin.cycles, end.cycles);
+            target.instructions += delta(begin.instructions, end.instructions);
+            target.l1dMisses += delta(begin.l1dMisses, end.l1dMisses);
+            target.llcMisses += delta(begin.llcMisses, end.llcMisses);
+            target.branchMisses += delta(begin.branchMisses, end.branchMisses);
+        }
+    }
+
+    CounterScope(const CounterScope&) = delete;
+    CounterScope& operator=(const CounterScope&) = delete;
+
+private:
+    // Multiplexed counts are scaled estimates and can step backwards
+    static uint64_t delta(uint64_t from, uint64_t to) { return to > from ? to - from : 0; }
+
+    HardwareCounterValues& target;
+    HardwareCounterValues begin;
+    bool active = false;
+};
@@ -0,0 +1,312 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+/**
+ * Lock-free single-producer, single-consumer ring of profile events. The
+ * owning thread pushes; the profiler drains under its capture mutex.
+ */
+class ProfileEventBuffer {
+public:
+    ProfileEventBuffer(size_t capacity, uint32_t threadIndex) : thread(threadIndex) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        events = std::make_unique<ProfileEvent[]>(size);
+    }
+
+    bool push(const ProfileEvent& event) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        events[position & mask] = event;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drain(std::vector<ProfileEvent>& output) {
+        size_t position = head.load(std::memory_order_relaxed);
+        size_t end = tail.load(std::memory_order_acquire);
+        for (; position != end; position++) {
+            output.push_back(events[position & mask]);
+        }
+        head.store(position, std::memory_order_release);
+    }
+
+    bool isEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    const uint32_t thread;
+    std::atomic<bool> retired{false}; // set when the owning thread exits
+
+private:
+    std::unique_ptr<ProfileEvent[]> events;
+    size_t mask = 0;
+
+    alignas(64) std::atomic<size_t> tail{0}; // producer
+    alignas(64) std::atomic<size_t> head{0}; // consumer
+};
+
+namespace {
+
+thread_local bool threadBufferReleased = false;
+
+// Keeps the calling thread's buffer registered and retires it when the thread exits
+struct ThreadBufferHolder {
+    std::shared_ptr<ProfileEventBuffer> buffer;
+
+    ~ThreadBufferHolder() {
+        threadBufferReleased = true;
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferHolder threadBufferHolder;
+
+// Scope tree under construction; children are owned so parents can be referenced while they grow
+struct BuildNode {
+    const char* name = nullptr;
+    uint64_t calls = 0;
+    uint64_t total = 0;
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    uint64_t max = 0;
+    std::vector<std::unique_ptr<BuildNode>> children;
+
+    BuildNode& child(const char* childName) {
+        for (auto& existing : children) {
+            if (existing->name == childName || std::strcmp(existing->name, childName) == 0) {
+                return *existing;
+            }
+        }
+        children.push_back(std::make_unique<BuildNode>());
+        children.back()->name = childName;
+        return *children.back();
+    }
+
+    ProfileNode toProfileNode() const {
+        ProfileNode node;
+        node.name = name ? name : "";
+        node.calls = calls;
+        node.totalMs = static_cast<double>(total) * 1e-6;
+        node.minMs = calls > 0 ? static_cast<double>(min) * 1e-6 : 0.0;
+        node.maxMs = static_cast<double>(max) * 1e-6;
+        node.children.reserve(children.size());
+        for (const auto& child : children) {
+            node.children.push_back(child->toProfileNode());
+        }
+        return node;
+    }
+};
+
+void appendJsonString(std::string& output, const char* text) {
+    output += '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            output += '\\';
+            output += *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+            output += escaped;
+        } else {
+            output += *c;
+        }
+    }
+    output += '"';
+}
+
+} // namespace
+
+const ProfileNode* ProfileNode::find(const std::string& path) const {
+    const ProfileNode* node = this;
+    size_t start = 0;
+    while (node && start <= path.size()) {
+        size_t end = path.find('/', start);
+        std::string part = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        const ProfileNode* next = nullptr;
+        for (const auto& child : node->children) {
+            if (child.name == part) {
+                next = &child;
+                break;
+            }
+        }
+        node = next;
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return node;
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+ProfileEventBuffer& Profiler::threadBuffer() {
+    if (!threadBufferHolder.buffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        threadBufferHolder.buffer = std::make_shared<ProfileEventBuffer>(
+            threadBufferCapacity.load(std::memory_order_relaxed), nextThreadIndex++);
+        buffers.push_back(threadBufferHolder.buffer);
+    }
+    return *threadBufferHolder.buffer;
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end, uint32_t depth) {
+    if (threadBufferReleased) {
+        return; // the thread is exiting
+    }
+    ProfileEventBuffer& buffer = threadBuffer();
+    if (!buffer.push(ProfileEvent{name, begin, end, buffer.thread, depth})) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    uint32_t thread = threadBuffer().thread;
+    std::lock_guard<std::mutex> lock(captureMutex);
+    for (auto& entry : threadNames) {
+        if (entry.first == thread) {
+            entry.second = name;
+            return;
+        }
+    }
+    threadNames.emplace_back(thread, name);
+}
+
+void Profiler::collect() {
+    std::vector<std::shared_ptr<ProfileEventBuffer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        snapshot = buffers;
+        // Buffers of exited threads go once they are empty (retired is set after their last event)
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const auto& buffer) {
+            return buffer->retired.load(std::memory_order_acquire) && buffer->isEmpty();
+        }), buffers.end());
+    }
+    for (const auto& buffer : snapshot) {
+        buffer->drain(captured);
+    }
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(captureMutex);
+    collect();
+    captured.clear();
+    droppedEvents.store(0, std::memory_order_relaxed);
+}
+
+std::vector<ProfileEvent> Profiler::getEvents() {
+    std::lock_guard<std::mutex> lock(captureMutex);
+    collect();
+
+    // By thread, then outer scopes before the scopes they contain
+    std::stable_sort(captured.begin(), captured.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+        if (a.thread != b.thread) {
+            return a.thread < b.thread;
+        }
+        if (a.begin != b.begin) {
+            return a.begin < b.begin;
+        }
+        return a.depth < b.depth;
+    });
+    return captured;
+}
+
+ProfileNode Profiler::getAggregateTree() {
+    std::vector<ProfileEvent> events = getEvents();
+
+    BuildNode root;
+    struct Open {
+        BuildNode* node;
+        uint64_t end;
+    };
+    std::vector<Open> open;
+    uint32_t currentThread = std::numeric_limits<uint32_t>::max();
+
+    for (const ProfileEvent& event : events) {
+        if (event.thread != currentThread) {
+            open.clear();
+            currentThread = event.thread;
+        }
+        // The parent is the innermost open scope that still contains this one; a parent that
+        // had not finished when the capture was read is missing, and its children move up
+        while (!open.empty() && (open.size() > event.depth || open.back().end < event.end)) {
+            open.pop_back();
+        }
+
+        BuildNode& node = (open.empty() ? root : *open.back().node).child(event.name);
+        uint64_t duration = event.end - event.begin;
+        node.calls++;
+        node.total += duration;
+        node.min = std::min(node.min, duration);
+        node.max = std::max(node.max, duration);
+        open.push_back({&node, event.end});
+    }
+
+    return root.toProfileNode();
+}
+
+std::string Profiler::getChromeTrace() {
+    std::vector<ProfileEvent> events = getEvents();
+    std::vector<std::pair<uint32_t, std::string>> names;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        names = threadNames;
+    }
+
+    uint64_t origin = std::numeric_limits<uint64_t>::max();
+    for (const ProfileEvent& event : events) {
+        origin = std::min(origin, event.begin);
+    }
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    char number[96];
+    for (const auto& [thread, name] : names) {
+        json += first ? "" : ",";
+        first = false;
+        std::snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                      thread);
+        json += number;
+        appendJsonString(json, name.c_str());
+        json += "}}";
+    }
+    for (const ProfileEvent& event : events) {
+        json += first ? "" : ",";
+        first = false;
+        json += "{\"name\":";
+        appendJsonString(json, event.name);
+        // Microseconds with nanosecond precision
+        std::snprintf(number, sizeof(number), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                      static_cast<double>(event.begin - origin) * 1e-3,
+                      static_cast<double>(event.end - event.begin) * 1e-3, event.thread);
+        json += number;
+    }
+    json += "]}";
+    return json;
+}
+
+bool Profiler::exportChromeTrace(const std::string& filename) {
+    std::ofstream file(filename, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << getChromeTrace();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Profiling scopes are compiled in unless TITANIUM_PROFILING is 0
+#ifndef TITANIUM_PROFILING
+#define TITANIUM_PROFILING 1
+#endif
+
+class ProfileEventBuffer;
+
+// One completed profiling scope
+struct ProfileEvent {
+    const char* name = nullptr;
+    uint64_t begin = 0;  // nanoseconds on the steady clock
+    uint64_t end = 0;
+    uint32_t thread = 0; // profiler-assigned thread index
+    uint32_t depth = 0;  // scopes already open on the thread when this one began
+};
+
+// Timings of one scope at one place in the scope hierarchy
+struct ProfileNode {
+    std::string name;
+    uint64_t calls = 0;
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    std::vector<ProfileNode> children;
+
+    double averageMs() const { return calls > 0 ? totalMs / static_cast<double>(calls) : 0.0; }
+
+    // Descendant by scope names separated by '/', e.g. "PhysicsEngine::updatePhysics/integrate"
+    const ProfileNode* find(const std::string& path) const;
+};
+
+/**
+ * Process-wide hierarchical profiler.
+ *
+ * PROFILE_SCOPE("name") times the rest of the enclosing block. While the
+ * profiler is disabled (the default) a scope costs one relaxed load; while
+ * enabled it appends one event to a lock-free buffer owned by the calling
+ * thread. Events are collected from the thread buffers whenever the capture
+ * is read, so long captures should be read (or cleared) regularly: a full
+ * thread buffer drops new events and counts them.
+ *
+ * The capture can be exported as Chrome trace JSON (chrome://tracing,
+ * ui.perfetto.dev) or aggregated into a call tree with per-scope
+ * min/avg/max. Scopes that run on job system workers are roots of their
+ * worker thread's tree.
+ */
+class Profiler {
+public:
+    static Profiler& getInstance();
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+    // For threads that have not recorded yet
+    void setThreadBufferCapacity(size_t events) { threadBufferCapacity.store(events, std::memory_order_relaxed); }
+    uint64_t getDroppedEventCount() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+    // Name shown for the calling thread in traces
+    void setThreadName(const std::string& name);
+
+    // Capture
+    void clear();
+    std::vector<ProfileEvent> getEvents();
+    ProfileNode getAggregateTree();
+    std::string getChromeTrace();
+    bool exportChromeTrace(const std::string& filename);
+
+    // Used by ProfileScope
+    void record(const char* name, uint64_t begin, uint64_t end, uint32_t depth);
+    static uint64_t now();
+
+private:
+    Profiler() = default;
+
+    static inline std::atomic<bool> enabled{false};
+    std::atomic<size_t> threadBufferCapacity{16384};
+    std::atomic<uint64_t> droppedEvents{0};
+
+    std::mutex buffersMutex; // buffer registration
+    std::vector<std::shared_ptr<ProfileEventBuffer>> buffers;
+    uint32_t nextThreadIndex = 0;
+
+    std::mutex captureMutex; // collected events and thread names
+    std::vector<ProfileEvent> captured;
+    std::vector<std::pair<uint32_t, std::string>> threadNames;
+
+    ProfileEventBuffer& threadBuffer();
+    void collect(); // caller holds captureMutex
+};
+
+// Times the enclosing block; see PROFILE_SCOPE
+class ProfileScope {
+public:
+    // name must be a string literal (it is kept by pointer)
+    explicit ProfileScope(const char* scopeName) {
+        if (Profiler::isEnabled()) {
+            name = scopeName;
+            depth = openScopes++;
+            begin = Profiler::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (name) {
+            openScopes--;
+            Profiler::getInstance().record(name, begin, Profiler::now(), depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    static inline thread_local uint32_t openScopes = 0;
+
+    const char* name = nullptr;
+    uint64_t begin = 0;
+    uint32_t depth = 0;
+};
+
+#if TITANIUM_PROFILING
+#define TITANIUM_PROFILE_CONCAT_INNER(a, b) a##b
+#define TITANIUM_PROFILE_CONCAT(a, b) TITANIUM_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope TITANIUM_PROFILE_CONCAT(titaniumProfileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+/**
+ * Bounded lock-free multi-producer, single-consumer queue.
+ *
+ * Any number of threads push; one thread pops. Each slot carries a sequence
+ * number, so producers claim slots with a single fetch-add and never wait on
+ * each other, and the consumer sees entries in the order their slots were
+ * claimed. push() fails instead of blocking when the queue is full.
+ */
+template<typename T>
+class CommandQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit CommandQueue(size_t capacity = 4096) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        slots = std::make_unique<Slot[]>(size);
+        for (size_t i = 0; i < size; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Any thread
+    bool push(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // full
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool pop(T& value) {
+        Slot& slot = slots[head & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != head + 1) {
+            return false; // empty, or the producer has not finished writing
+        }
+        value = slot.value;
+        slot.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};
+    alignas(CACHE_LINE) size_t head = 0;
+};
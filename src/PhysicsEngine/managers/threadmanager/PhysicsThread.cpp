@@ -0,0 +1,196 @@
+#include "PhysicsThread.h"
+#include "../../PhysicsEngine.h"
+#include "../../CPUPhysicsEngine/CPUPhysicsEngine.h"
+#include "../logmanager/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+PhysicsThread::PhysicsThread(PhysicsEngine& engine, size_t commandCapacity)
+    : engine(engine), commands(commandCapacity) {
+}
+
+PhysicsThread::~PhysicsThread() {
+    stop();
+}
+
+void PhysicsThread::start() {
+    if (running.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    thread = std::thread(&PhysicsThread::threadLoop, this);
+    LOG_INFO(LogCategory::PHYSICS, "Physics thread started at " +
+             std::to_string(1.0f / engine.getFixedTimestep()) + " Hz");
+}
+
+void PhysicsThread::stop() {
+    if (!running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    thread.join();
+    LOG_INFO(LogCategory::PHYSICS, "Physics thread stopped after " + std::to_string(getStepCount()) + " steps");
+}
+
+void PhysicsThread::stepOnce() {
+    if (isRunning()) {
+        LOG_WARN(LogCategory::PHYSICS, "PhysicsThread: stepOnce() ignored while the thread is running");
+        return;
+    }
+    step();
+}
+
+PhysicsThread::BodyHandle PhysicsThread::createRigidBody(float x, float y, float z, float width, float height,
+                                                         float depth, float mass, uint32_t layer) {
+    Command command;
+    command.type = CommandType::CREATE_BODY;
+    command.handle = nextHandle.fetch_add(1, std::memory_order_relaxed);
+    command.layer = layer;
+    const float values[7] = {x, y, z, width, height, depth, mass};
+    std::copy(values, values + 7, command.values);
+    return enqueue(command) ? command.handle : 0;
+}
+
+bool PhysicsThread::removeRigidBody(BodyHandle handle) {
+    Command command;
+    command.type = CommandType::REMOVE_BODY;
+    command.handle = handle;
+    return enqueue(command);
+}
+
+bool PhysicsThread::setVelocity(BodyHandle handle, float vx, float vy, float vz) {
+    Command command;
+    command.type = CommandType::SET_VELOCITY;
+    command.handle = handle;
+    command.values[0] = vx;
+    command.values[1] = vy;
+    command.values[2] = vz;
+    return enqueue(command);
+}
+
+bool PhysicsThread::setPosition(BodyHandle handle, float x, float y, float z) {
+    Command command;
+    command.type = CommandType::SET_POSITION;
+    command.handle = handle;
+    command.values[0] = x;
+    command.values[1] = y;
+    command.values[2] = z;
+    return enqueue(command);
+}
+
+bool PhysicsThread::setGravity(float x, float y, float z) {
+    Command command;
+    command.type = CommandType::SET_GRAVITY;
+    command.values[0] = x;
+    command.values[1] = y;
+    command.values[2] = z;
+    return enqueue(command);
+}
+
+bool PhysicsThread::enqueue(const Command& command) {
+    if (commands.push(command)) {
+        return true;
+    }
+
+    // Not logged: a full queue drops commands in bursts, one message each would flood the log;
+    // the caller sees false and getDroppedCommandCount() keeps the total
+    droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PhysicsThread::applyCommands() {
+    Command command;
+    while (commands.pop(command)) {
+        applyCommand(command);
+    }
+}
+
+void PhysicsThread::applyCommand(const Command& command) {
+    if (command.type == CommandType::SET_GRAVITY) {
+        engine.setGravity(command.values[0], command.values[1], command.values[2]);
+        return;
+    }
+
+    if (command.type == CommandType::CREATE_BODY) {
+        const float* v = command.values;
+        uint32_t entityId = engine.createRigidBody(v[0], v[1], v[2], v[3], v[4], v[5], v[6], command.layer);
+        if (handleEntities.size() <= command.handle) {
+            handleEntities.resize(command.handle + 1, 0);
+        }
+        handleEntities[command.handle] = entityId;
+        return;
+    }
+
+    uint32_t entityId = command.handle < handleEntities.size() ? handleEntities[command.handle] : 0;
+    if (entityId == 0) {
+        return; // body failed to create or was already removed
+    }
+
+    auto ecsManager = engine.getCPUPhysics()->getECSManager();
+    switch (command.type) {
+        case CommandType::REMOVE_BODY:
+            engine.removeRigidBody(entityId);
+            handleEntities[command.handle] = 0;
+            break;
+        case CommandType::SET_VELOCITY:
+            if (auto* physics = ecsManager->getPhysicsComponent(entityId)) {
+                std::copy(command.values, command.values + 3, physics->velocity);
+                physics->isSleeping = false;
+            }
+            break;
+        case CommandType::SET_POSITION:
+            if (auto* transform = ecsManager->getTransformComponent(entityId)) {
+                std::copy(command.values, command.values + 3, transform->position);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void PhysicsThread::step() {
+    applyCommands();
+    engine.updatePhysics(engine.getFixedTimestep());
+    stepCount.fetch_add(1, std::memory_order_relaxed);
+    publishSnapshot();
+}
+
+void PhysicsThread::publishSnapshot() {
+    PhysicsSnapshot& snapshot = snapshots.back();
+    snapshot.stepIndex = stepCount.load(std::memory_order_relaxed);
+    snapshot.bodies.resize(handleEntities.size());
+
+    auto ecsManager = engine.getCPUPhysics()->getECSManager();
+    for (size_t handle = 0; handle < handleEntities.size(); handle++) {
+        PhysicsSnapshot::Body& body = snapshot.bodies[handle];
+        const auto* transform = handleEntities[handle] != 0 ? ecsManager->getTransformComponent(handleEntities[handle])
+                                                            : nullptr;
+        body.alive = transform != nullptr;
+        if (transform) {
+            std::copy(transform->position, transform->position + 3, body.position);
+            std::copy(transform->rotation, transform->rotation + 4, body.rotation);
+        }
+    }
+
+    snapshots.publish();
+}
+
+void PhysicsThread::threadLoop() {
+    using Clock = std::chrono::steady_clock;
+    auto stepDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(engine.getFixedTimestep()));
+    auto nextStep = Clock::now();
+
+    while (running.load(std::memory_order_acquire)) {
+        step();
+
+        nextStep += stepDuration;
+        auto now = Clock::now();
+        if (now > nextStep + stepDuration * engine.getMaxSubsteps()) {
+            // Too far behind to catch up; run at whatever rate we can manage
+            LOG_WARN(LogCategory::PERFORMANCE, "Physics thread fell behind, resetting its clock");
+            nextStep = now;
+        }
+        std::this_thread::sleep_until(nextStep);
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CommandQueue.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class PhysicsEngine;
+
+/**
+ * Transforms of every body at the end of one physics step, as seen by readers
+ * of a PhysicsThread. Bodies are indexed by their handle.
+ */
+struct PhysicsSnapshot {
+    struct Body {
+        float position[3] = {0.0f, 0.0f, 0.0f};
+        float rotation[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+        bool alive = false;
+    };
+
+    uint64_t stepIndex = 0;       // steps taken when this snapshot was published
+    std::vector<Body> bodies;     // by handle; handle 0 is never used
+
+    const Body* getBody(uint32_t handle) const {
+        return handle < bodies.size() && bodies[handle].alive ? &bodies[handle] : nullptr;
+    }
+};
+
+/**
+ * Physics Thread - Runs a PhysicsEngine on its own thread at a fixed rate
+ *
+ * While the thread owns the engine, other threads never touch it directly:
+ * - Writes (body creation and removal, velocity and position changes,
+ *   gravity) are pushed as commands onto a lock-free MPSC queue from any
+ *   thread and applied in order at the start of the next step
+ * - Reads go through a triple-buffered PhysicsSnapshot published after each
+ *   step, so a reader always gets the latest complete step without locks
+ *
+ * Bodies created through the queue are identified by handles that are
+ * returned immediately, before the physics thread has created them.
+ * Snapshots have a single reader (normally the render thread).
+ */
+class PhysicsThread {
+public:
+    using BodyHandle = uint32_t; // 0 is invalid
+
+    // engine must be initialized; commandCapacity bounds the commands queued between steps
+    explicit PhysicsThread(PhysicsEngine& engine, size_t commandCapacity = 4096);
+    ~PhysicsThread();
+
+    PhysicsThread(const PhysicsThread&) = delete;
+    PhysicsThread& operator=(const PhysicsThread&) = delete;
+
+    // Thread control: steps at the engine's fixed timestep until stop()
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    // Drain commands, take one step and publish (only while the thread is stopped)
+    void stepOnce();
+
+    // Commands, callable from any thread; false (or handle 0) when the queue is full
+    BodyHandle createRigidBody(float x, float y, float z, float width, float height, float depth,
+                               float mass = 1.0f, uint32_t layer = 0);
+    bool removeRigidBody(BodyHandle handle);
+    bool setVelocity(BodyHandle handle, float vx, float vy, float vz);
+    bool setPosition(BodyHandle handle, float x, float y, float z);
+    bool setGravity(float x, float y, float z);
+
+    // Reader thread: latest published snapshot, valid until the next call
+    const PhysicsSnapshot& acquireSnapshot() { return snapshots.acquire(); }
+
+    // Statistics
+    uint64_t getStepCount() const { return stepCount.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCommandCount() const { return droppedCommands.load(std::memory_order_relaxed); }
+
+private:
+    enum class CommandType : uint8_t {
+        CREATE_BODY,
+        REMOVE_BODY,
+        SET_VELOCITY,
+        SET_POSITION,
+        SET_GRAVITY
+    };
+
+    struct Command {
+        CommandType type = CommandType::SET_GRAVITY;
+        BodyHandle handle = 0;
+        uint32_t layer = 0;
+        float values[7] = {};
+    };
+
+    PhysicsEngine& engine;
+    CommandQueue<Command> commands;
+    TripleBuffer<PhysicsSnapshot> snapshots;
+
+    std::atomic<uint32_t> nextHandle{1};
+    std::atomic<uint64_t> droppedCommands{0};
+    std::atomic<uint64_t> stepCount{0};
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    // Physics thread only
+    std::vector<uint32_t> handleEntities; // entity ID by handle, 0 once removed
+
+    bool enqueue(const Command& command);
+    void applyCommands();
+    void applyCommand(const Command& command);
+    void step();
+    void publishSnapshot();
+    void threadLoop();
+};
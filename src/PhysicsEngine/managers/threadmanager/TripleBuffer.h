@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Lock-free triple buffer between one writer and one reader.
+ *
+ * The writer fills its back buffer and publishes it; the reader always gets
+ * the most recently published buffer. The two sides swap buffers through a
+ * single atomic "middle" slot, so neither waits for the other and the reader
+ * can never see a buffer the writer is still changing. Intermediate frames
+ * the reader did not pick up are skipped.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: buffer to fill for the next publish()
+    T& back() { return buffers[backIndex]; }
+
+    // Writer: make back() visible to the reader and start on a new back buffer
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | FRESH), std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    // Reader: latest published buffer (unchanged if nothing new was published)
+    const T& acquire() {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & INDEX_MASK;
+        }
+        return buffers[frontIndex];
+    }
+
+    // Reader: true when a publish() happened since the last acquire()
+    bool hasNewData() const { return (middle.load(std::memory_order_acquire) & FRESH) != 0; }
+
+private:
+    static constexpr uint8_t FRESH = 0x4;
+    static constexpr uint8_t INDEX_MASK = 0x3;
+
+    T buffers[3];
+    uint8_t backIndex = 0;              // writer only
+    std::atomic<uint8_t> middle{1};     // shared
+    uint8_t frontIndex = 2;             // reader only
+};
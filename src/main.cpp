@@ -153,6 +153,9 @@ int main(int argc, char* argv[]) {
     // Set gravity
     physicsEngine.setGravity(0.0f, -9.81f, 0.0f);
     
+    // Simulate at 30 Hz and interpolate transforms for the 60 FPS frame loop
+    physicsEngine.setSimulationRate(30.0f);
+    
     std::cout << "\nStarting physics simulation..." << std::endl;
     std::cout << "Press Ctrl+C to stop the simulation" << std::endl;
     std::cout << "\nSimulation Statistics:" << std::endl;
@@ -168,11 +171,8 @@ int main(int argc, char* argv[]) {
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
         
-        // Clamp delta time to prevent large jumps
-        deltaTime = std::min(deltaTime, 0.016f); // Max 16ms
-        
-        // Update physics
-        physicsEngine.updatePhysics(deltaTime);
+        // Update physics in fixed substeps; the scheduler caps the catch-up work
+        physicsEngine.update(deltaTime);
         
         totalTime += deltaTime;
         frameCount++;
@@ -186,9 +186,10 @@ int main(int argc, char* argv[]) {
             int activeBodies = 0;
             
             for (auto bodyId : dynamicBodies) {
-                auto* body = physicsEngine.getRigidBody(bodyId);
-                if (body) {
-                    float height = body->transform.position[1];
+                float position[3];
+                float rotation[4];
+                if (physicsEngine.getInterpolatedTransform(bodyId, position, rotation)) {
+                    float height = position[1];
                     avgHeight += height;
                     minHeight = std::min(minHeight, height);
                     maxHeight = std::max(maxHeight, height);
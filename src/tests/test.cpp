@@ -1,11 +1,62 @@
 #include "../tests/components/tests/TestManager.h"
 #include "../PhysicsEngine/managers/logmanager/Logger.h"
+#include "../PhysicsEngine/managers/logmanager/LogBinary.h"
 #include "../PhysicsEngine/CPUPhysicsEngine/CPUPhysicsEngine.h"
 #include "../PhysicsEngine/PhysicsEngine.h"
+#include "../PhysicsEngine/PhysicsWorld.h"
+#include "../PhysicsEngine/CPUPhysicsEngine/solver/ContactSolver.h"
+#include "../PhysicsEngine/CPUPhysicsEngine/solver/IslandBuilder.h"
+#include "../PhysicsEngine/CPUPhysicsEngine/solver/BodyIntegrator.h"
+#include "../PhysicsEngine/CPUPhysicsEngine/ensemble/BatchedWorlds.h"
+#include "../PhysicsEngine/CPUPhysicsEngine/systems/BaseCPUPhysicsSystem.h"
+#include "../PhysicsEngine/managers/jobmanager/JobSystem.h"
+#include "../PhysicsEngine/managers/threadmanager/PhysicsThread.h"
+#include "../PhysicsEngine/managers/profilemanager/AllocationTracker.h"
+#include "../PhysicsEngine/managers/profilemanager/HardwareCounters.h"
+#include "../PhysicsEngine/managers/profilemanager/Profiler.h"
+#include "../PhysicsEngine/managers/metricsmanager/MetricsPage.h"
 #include <memory>
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using ComponentType = cpu_physics::interfaces::CPUPhysicsComponent::ComponentType;
+
+// Minimal system with declared component access, used by the scheduler test
+class ScriptedTestSystem : public cpu_physics::BaseCPUPhysicsSystem {
+public:
+    ScriptedTestSystem(std::shared_ptr<cpu_physics::ECSManager> ecs, const char* name, Priority priority,
+                       std::vector<ComponentType> reads, std::vector<ComponentType> writes,
+                       std::function<void()> body)
+        : BaseCPUPhysicsSystem(ecs), name(name), priority(priority), reads(reads), writes(writes), body(body) {}
+
+    SystemType getType() const override { return SystemType::CUSTOM; }
+    const char* getName() const override { return name; }
+    Priority getPriority() const override { return priority; }
+    std::vector<ComponentType> getRequiredComponents() const override { return reads; }
+    std::vector<ComponentType> getOptionalComponents() const override { return {}; }
+    std::vector<ComponentType> getWriteComponents() const override { return writes; }
+
+protected:
+    void updateInternal(float) override { body(); }
+    void processEntity(cpu_physics::interfaces::CPUPhysicsEntity*, float) override {}
+
+private:
+    const char* name;
+    Priority priority;
+    std::vector<ComponentType> reads;
+    std::vector<ComponentType> writes;
+    std::function<void()> body;
+};
 
 // Simple consolidated test framework that doesn't depend on complex test classes
 class SimpleTestFramework {
@@ -104,6 +155,1538 @@ public:
                 std::cout << "✗ FAILED: Logger functionality - " << e.what() << std::endl;
             }
             
+            // Test 7: Constraint graph coloring
+            std::cout << "\n[Test 7] Constraint graph coloring..." << std::endl;
+            totalTests++;
+            try {
+                // A row of boxes resting on one shared static ground, each touching its neighbour
+                const float velocity[3] = {0.0f, 0.0f, 0.0f};
+                const float position[3] = {0.0f, 0.0f, 0.0f};
+                cpu_physics::SolverBodies bodies;
+                uint32_t ground = bodies.add(velocity, position, 0.0f);
+                std::vector<uint32_t> boxes;
+                for (int i = 0; i < 100; i++) {
+                    boxes.push_back(bodies.add(velocity, position, 1.0f));
+                }
+                
+                std::vector<cpu_physics::ContactConstraint> constraints;
+                for (size_t i = 0; i < boxes.size(); i++) {
+                    cpu_physics::ContactConstraint groundContact;
+                    groundContact.bodyA = boxes[i];
+                    groundContact.bodyB = ground;
+                    constraints.push_back(groundContact);
+                    if (i + 1 < boxes.size()) {
+                        cpu_physics::ContactConstraint neighbourContact;
+                        neighbourContact.bodyA = boxes[i];
+                        neighbourContact.bodyB = boxes[i + 1];
+                        constraints.push_back(neighbourContact);
+                    }
+                }
+                
+                cpu_physics::ConstraintColoring coloring;
+                coloring.build(constraints, bodies);
+                
+                // The shared static ground must not force a color per box
+                assert(coloring.getColorCount() <= 3);
+                assert(coloring.getOverflowRange().first == coloring.getOverflowRange().second);
+                
+                const auto& order = coloring.getOrder();
+                assert(order.size() == constraints.size());
+                for (size_t color = 0; color < coloring.getColorCount(); color++) {
+                    auto [begin, end] = coloring.getColorRange(color);
+                    std::set<uint32_t> usedBodies;
+                    for (size_t i = begin; i < end; i++) {
+                        const auto& constraint = constraints[order[i]];
+                        for (uint32_t body : {constraint.bodyA, constraint.bodyB}) {
+                            if (bodies.isDynamic(body)) {
+                                assert(usedBodies.insert(body).second);
+                            }
+                        }
+                    }
+                }
+                std::cout << "✓ PASSED: Constraint graph coloring" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Constraint graph coloring - " << e.what() << std::endl;
+            }
+            
+            // Test 8: Parallel colored solve matches serial solve
+            std::cout << "\n[Test 8] Parallel contact solver..." << std::endl;
+            totalTests++;
+            try {
+                // 100x100 grid of falling boxes on a static ground, 4-connected: ~30k contacts
+                const int gridSize = 100;
+                const float position[3] = {0.0f, 0.0f, 0.0f};
+                cpu_physics::SolverBodies bodies;
+                const float groundVelocity[3] = {0.0f, 0.0f, 0.0f};
+                uint32_t ground = bodies.add(groundVelocity, position, 0.0f);
+                for (int i = 0; i < gridSize * gridSize; i++) {
+                    const float velocity[3] = {0.01f * (i % 7), -1.0f - 0.001f * i, 0.02f * (i % 3)};
+                    bodies.add(velocity, position, 1.0f / (1.0f + (i % 5)));
+                }
+                
+                std::vector<cpu_physics::ContactConstraint> constraints;
+                auto addContact = [&constraints](uint32_t a, uint32_t b, int axis) {
+                    cpu_physics::ContactConstraint constraint;
+                    constraint.bodyA = a;
+                    constraint.bodyB = b;
+                    constraint.normal[axis] = 1.0f;
+                    constraint.penetrationDepth = 0.01f;
+                    constraint.restitution = 0.3f;
+                    constraints.push_back(constraint);
+                };
+                for (int y = 0; y < gridSize; y++) {
+                    for (int x = 0; x < gridSize; x++) {
+                        uint32_t body = 1 + y * gridSize + x;
+                        addContact(body, ground, 1);
+                        if (x + 1 < gridSize) addContact(body + 1, body, 0);
+                        if (y + 1 < gridSize) addContact(body + gridSize, body, 2);
+                    }
+                }
+                assert(constraints.size() > 10000);
+                
+                cpu_physics::SolverBodies serialBodies = bodies;
+                auto serialConstraints = constraints;
+                cpu_physics::ContactSolver serialSolver;
+                serialSolver.solve(serialBodies, serialConstraints);
+                
+                cpu_physics::ContactSolver parallelSolver;
+                parallelSolver.setJobSystem(std::make_shared<JobSystem>(4));
+                parallelSolver.solve(bodies, constraints);
+                
+                // Colors never share a dynamic body, so thread count must not change the result
+                assert(parallelSolver.getLastColorCount() == serialSolver.getLastColorCount());
+                for (size_t i = 0; i < bodies.size(); i++) {
+                    assert(bodies.velocityX[i] == serialBodies.velocityX[i]);
+                    assert(bodies.velocityY[i] == serialBodies.velocityY[i]);
+                    assert(bodies.velocityZ[i] == serialBodies.velocityZ[i]);
+                    assert(bodies.positionY[i] == serialBodies.positionY[i]);
+                }
+                // Ground contacts must have stopped the fall
+                assert(bodies.velocityY[1] >= -1e-4f);
+                std::cout << "✓ PASSED: Parallel contact solver" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Parallel contact solver - " << e.what() << std::endl;
+            }
+            
+            // Test 9: SIMD solver mode matches scalar mode
+            std::cout << "\n[Test 9] SIMD contact solver..." << std::endl;
+            totalTests++;
+            try {
+                // A tower of boxes on a static ground plus a few side contacts, enough for partial batches
+                const float position[3] = {0.0f, 0.0f, 0.0f};
+                const float groundVelocity[3] = {0.0f, 0.0f, 0.0f};
+                cpu_physics::SolverBodies bodies;
+                uint32_t ground = bodies.add(groundVelocity, position, 0.0f);
+                for (int i = 0; i < 1001; i++) {
+                    const float velocity[3] = {0.05f * (i % 4), -2.0f + 0.003f * i, -0.01f * (i % 9)};
+                    bodies.add(velocity, position, 1.0f / (1.0f + (i % 3)));
+                }
+                
+                std::vector<cpu_physics::ContactConstraint> constraints;
+                for (uint32_t body = 1; body < bodies.size(); body++) {
+                    cpu_physics::ContactConstraint constraint;
+                    constraint.bodyA = body;
+                    constraint.bodyB = (body % 10 == 1) ? ground : body - 1;
+                    constraint.normal[1] = 1.0f;
+                    constraint.penetrationDepth = 0.02f;
+                    constraint.restitution = 0.5f;
+                    constraints.push_back(constraint);
+                }
+                
+                cpu_physics::SolverBodies scalarBodies = bodies;
+                auto scalarConstraints = constraints;
+                cpu_physics::ContactSolver scalarSolver;
+                scalarSolver.setIterations(8);
+                scalarSolver.solve(scalarBodies, scalarConstraints);
+                
+                cpu_physics::ContactSolver simdSolver;
+                simdSolver.setIterations(8);
+                simdSolver.setMode(cpu_physics::ContactSolver::SolverMode::SIMD);
+                simdSolver.setJobSystem(std::make_shared<JobSystem>(2));
+                simdSolver.setParallelBatchThreshold(64);
+                simdSolver.solve(bodies, constraints);
+                
+                for (size_t i = 0; i < bodies.size(); i++) {
+                    assert(std::abs(bodies.velocityX[i] - scalarBodies.velocityX[i]) < 1e-5f);
+                    assert(std::abs(bodies.velocityY[i] - scalarBodies.velocityY[i]) < 1e-5f);
+                    assert(std::abs(bodies.velocityZ[i] - scalarBodies.velocityZ[i]) < 1e-5f);
+                }
+                for (size_t i = 0; i < constraints.size(); i++) {
+                    assert(std::abs(constraints[i].accumulatedImpulse - scalarConstraints[i].accumulatedImpulse) < 1e-5f);
+                }
+                assert(bodies.velocityX[0] == 0.0f && bodies.velocityY[0] == 0.0f);
+                std::cout << "✓ PASSED: SIMD contact solver" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: SIMD contact solver - " << e.what() << std::endl;
+            }
+            
+            // Test 10: Island building and bin packing
+            std::cout << "\n[Test 10] Island builder..." << std::endl;
+            totalTests++;
+            try {
+                // Ten stacks of five boxes on one static ground, plus three resting bodies
+                const float zero[3] = {0.0f, 0.0f, 0.0f};
+                cpu_physics::SolverBodies bodies;
+                uint32_t ground = bodies.add(zero, zero, 0.0f);
+                std::vector<cpu_physics::ContactConstraint> constraints;
+                for (int stack = 0; stack < 10; stack++) {
+                    for (int level = 0; level < 5; level++) {
+                        uint32_t body = bodies.add(zero, zero, 1.0f);
+                        cpu_physics::ContactConstraint constraint;
+                        constraint.bodyA = body;
+                        constraint.bodyB = (level == 0) ? ground : body - 1;
+                        constraints.push_back(constraint);
+                    }
+                }
+                for (int i = 0; i < 3; i++) {
+                    bodies.add(zero, zero, 1.0f);
+                }
+                
+                // The shared static ground must not merge the stacks
+                cpu_physics::IslandBuilder builder;
+                builder.build(bodies, constraints);
+                const auto& islands = builder.getIslands();
+                assert(islands.size() == 13);
+                std::vector<int> bodyIsland(bodies.size(), -1);
+                for (size_t i = 0; i < islands.size(); i++) {
+                    for (uint32_t b = 0; b < islands[i].bodyCount; b++) {
+                        uint32_t body = builder.getBodyOrder()[islands[i].bodyBegin + b];
+                        assert(bodyIsland[body] == -1);
+                        bodyIsland[body] = static_cast<int>(i);
+                    }
+                    for (uint32_t c = 0; c < islands[i].constraintCount; c++) {
+                        const auto& constraint = constraints[builder.getConstraintOrder()[islands[i].constraintBegin + c]];
+                        assert(bodyIsland[constraint.bodyA] == static_cast<int>(i));
+                    }
+                }
+                assert(bodyIsland[ground] == -1);
+                
+                // Bins are balanced by constraint count
+                builder.packBins(4, 100);
+                assert(builder.getBinCount() == 4);
+                assert(builder.getLargeIslands().empty());
+                size_t minLoad = SIZE_MAX, maxLoad = 0, packed = 0;
+                for (size_t bin = 0; bin < builder.getBinCount(); bin++) {
+                    size_t load = 0;
+                    for (size_t i = builder.getBinOffsets()[bin]; i < builder.getBinOffsets()[bin + 1]; i++) {
+                        load += std::max<size_t>(islands[builder.getBinIslands()[i]].constraintCount, 1);
+                        packed++;
+                    }
+                    minLoad = std::min(minLoad, load);
+                    maxLoad = std::max(maxLoad, load);
+                }
+                assert(packed == islands.size());
+                assert(maxLoad - minLoad <= 5);
+                
+                // Islands above the threshold are left for the colored solver
+                builder.packBins(4, 4);
+                assert(builder.getLargeIslands().size() == 10);
+                std::cout << "✓ PASSED: Island builder" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Island builder - " << e.what() << std::endl;
+            }
+            
+            // Test 11: Fixed-timestep scheduling and interpolation
+            std::cout << "\n[Test 11] Fixed-timestep scheduler..." << std::endl;
+            totalTests++;
+            try {
+                PhysicsEngine engine;
+                assert(engine.initialize(0, 10));
+                engine.setSimulationRate(30.0f);
+                engine.setMaxSubsteps(4);
+                uint32_t body = engine.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+                
+                // Less than a step only accumulates
+                assert(engine.update(0.02f) == 0);
+                assert(std::abs(engine.getInterpolationAlpha() - 0.6f) < 1e-4f);
+                
+                // Crossing the step boundary runs one substep and blends toward it
+                assert(engine.update(0.02f) == 1);
+                float alpha = engine.getInterpolationAlpha();
+                assert(alpha > 0.15f && alpha < 0.25f);
+                float position[3];
+                float rotation[4];
+                assert(engine.getInterpolatedTransform(body, position, rotation));
+                float current = engine.getCPUPhysics()->getECSManager()->getTransformComponent(body)->position[1];
+                assert(current < 10.0f);
+                assert(std::abs(position[1] - (10.0f + (current - 10.0f) * alpha)) < 1e-4f);
+                assert(std::abs(rotation[0] - 1.0f) < 1e-6f);
+                
+                // A long frame is capped at the substep limit
+                assert(engine.update(1.0f) == 4);
+                assert(engine.getInterpolationAlpha() <= 1.0f);
+                
+                // Respawning bodies (new entity IDs every time) does not grow the interpolation state
+                std::vector<uint32_t> spawned;
+                for (int i = 0; i < 5; i++) {
+                    spawned.push_back(engine.createRigidBody(static_cast<float>(i) * 2.0f, 5.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f));
+                }
+                AllocationTracker& tracker = AllocationTracker::getInstance();
+                tracker.setEnabled(true);
+                for (int frame = 0; frame < 20; frame++) {
+                    assert(engine.removeRigidBody(spawned[frame % 5]));
+                    spawned[frame % 5] = engine.createRigidBody(static_cast<float>(frame % 5) * 2.0f, 5.0f, 0.0f,
+                                                                1.0f, 1.0f, 1.0f, 1.0f);
+                    AllocationStep frameStep;
+                    assert(engine.update(1.0f / 30.0f) >= 1);
+                    frameStep.finish();
+                    const AllocationTracker::Phase* interpolation = tracker.getLastStep().find("interpolation");
+                    assert(!AllocationTracker::isAvailable() || frame == 0 ||
+                           (interpolation && interpolation->counts.allocations == 0));
+                }
+                tracker.setEnabled(false);
+                float respawned[3];
+                assert(engine.getInterpolatedTransform(spawned[0], respawned, rotation));
+                std::cout << "✓ PASSED: Fixed-timestep scheduler" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Fixed-timestep scheduler - " << e.what() << std::endl;
+            }
+            
+            // Test 12: Fused vectorized integrator
+            std::cout << "\n[Test 12] Fused integrator..." << std::endl;
+            totalTests++;
+            try {
+                // 37 bodies so the last range is a partial SIMD block; body 5 is static, body 6 sleeps
+                cpu_physics::SolverBodies bodies;
+                for (int i = 0; i < 37; i++) {
+                    const float velocity[3] = {0.1f * i, 1.0f - 0.05f * i, -0.2f};
+                    const float position[3] = {float(i), 2.0f * i, -1.0f};
+                    uint32_t body = bodies.add(velocity, position, (i == 5 || i == 6) ? 0.0f : 1.0f);
+                    bodies.angularVelocityX[body] = 0.3f;
+                    bodies.angularVelocityY[body] = 0.01f * i;
+                    bodies.gravityScale[body] = (i % 4 == 3) ? 0.0f : 1.0f;
+                    bodies.halfExtentX[body] = 0.5f;
+                    bodies.halfExtentY[body] = 0.25f;
+                    bodies.halfExtentZ[body] = 1.0f;
+                }
+                cpu_physics::SolverBodies reference = bodies;
+                cpu_physics::SolverBodies parallel = bodies;
+                
+                const float gravity[3] = {0.0f, -9.81f, 0.0f};
+                const float dt = 1.0f / 60.0f;
+                cpu_physics::BodyIntegrator integrator;
+                integrator.integrate(bodies, gravity, dt);
+                
+                cpu_physics::BodyIntegrator parallelIntegrator;
+                parallelIntegrator.setJobSystem(std::make_shared<JobSystem>(4));
+                parallelIntegrator.setParallelThreshold(8);
+                parallelIntegrator.integrate(parallel, gravity, dt);
+                
+                for (size_t i = 0; i < bodies.size(); i++) {
+                    bool moving = reference.motionMask[i] > 0.0f;
+                    float vy = moving ? (reference.velocityY[i] + gravity[1] * reference.gravityScale[i] * dt) * 0.99f
+                                      : reference.velocityY[i];
+                    float py = moving ? reference.positionY[i] + vy * dt : reference.positionY[i];
+                    assert(std::abs(bodies.velocityY[i] - vy) < 1e-5f);
+                    assert(std::abs(bodies.positionY[i] - py) < 1e-5f);
+                    assert(bodies.aabbMinY[i] == bodies.positionY[i] - 0.25f);
+                    assert(bodies.aabbMaxZ[i] == bodies.positionZ[i] + 1.0f);
+                    
+                    float norm = bodies.rotationW[i] * bodies.rotationW[i] + bodies.rotationX[i] * bodies.rotationX[i] +
+                                 bodies.rotationY[i] * bodies.rotationY[i] + bodies.rotationZ[i] * bodies.rotationZ[i];
+                    assert(std::abs(norm - 1.0f) < 1e-5f);
+                    assert(moving ? bodies.rotationX[i] > 0.0f : bodies.rotationW[i] == 1.0f);
+                    
+                    assert(parallel.velocityY[i] == bodies.velocityY[i]);
+                    assert(parallel.positionX[i] == bodies.positionX[i]);
+                    assert(parallel.rotationY[i] == bodies.rotationY[i]);
+                }
+                assert(bodies.positionY[5] == 10.0f && bodies.velocityX[6] == reference.velocityX[6]);
+                
+                // The engine integrates angular velocity into the transform rotation
+                auto cpuEngine = std::make_unique<cpu_physics::CPUPhysicsEngine>();
+                cpuEngine->initialize(10);
+                uint32_t spinning = cpuEngine->createRigidBody(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0);
+                auto ecs = cpuEngine->getECSManager();
+                ecs->getPhysicsComponent(spinning)->angularVelocity[1] = 2.0f;
+                cpuEngine->updatePhysics(dt);
+                assert(ecs->getTransformComponent(spinning)->rotation[2] > 0.0f);
+                std::cout << "✓ PASSED: Fused integrator" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Fused integrator - " << e.what() << std::endl;
+            }
+            
+            // Test 13: Work-stealing job system
+            std::cout << "\n[Test 13] Job system..." << std::endl;
+            totalTests++;
+            try {
+                JobSystem jobs(3);
+                
+                // Parallel-for with automatic grain covers every index exactly once
+                std::vector<int> hits(10000, 0);
+                jobs.parallelFor(hits.size(), 0, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) hits[i]++;
+                });
+                for (int hit : hits) assert(hit == 1);
+                
+                // Dependencies: the second stage starts after every first-stage job
+                std::atomic<int> firstStage{0};
+                std::atomic<int> seenBySecond{-1};
+                JobCounter first, second;
+                for (int i = 0; i < 16; i++) {
+                    jobs.run([&]() { firstStage++; }, &first);
+                }
+                jobs.runAfter(first, [&]() { seenBySecond = firstStage.load(); }, &second);
+                jobs.wait(second);
+                assert(seenBySecond == 16);
+                
+                // Nested parallel-for from inside jobs must not deadlock
+                std::atomic<size_t> nestedTotal{0};
+                JobCounter nested;
+                for (int i = 0; i < 8; i++) {
+                    jobs.run([&]() {
+                        jobs.parallelFor(1000, 16, [&](size_t begin, size_t end) { nestedTotal += end - begin; });
+                    }, &nested);
+                }
+                jobs.wait(nested);
+                assert(nestedTotal == 8000);
+                
+                // Host thread pool hook: the engine runs its workers on the host's threads
+                std::vector<std::thread> hostThreads;
+                {
+                    auto hosted = std::make_shared<JobSystem>(2, [&](std::function<void()> loop) {
+                        hostThreads.emplace_back(std::move(loop));
+                    });
+                    assert(hosted->getWorkerCount() == 2 && hostThreads.size() == 2);
+                    
+                    PhysicsEngine engine;
+                    engine.setJobSystem(hosted);
+                    assert(engine.initialize(0, 10));
+                    assert(engine.getCPUPhysics()->getJobSystem() == hosted);
+                    engine.createRigidBody(0.0f, 5.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+                    engine.updatePhysics(0.016f);
+                    engine.cleanup();
+                }
+                for (auto& thread : hostThreads) thread.join();
+                std::cout << "✓ PASSED: Job system" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Job system - " << e.what() << std::endl;
+            }
+            
+            // Test 14: Dependency-graph system scheduler
+            std::cout << "\n[Test 14] System scheduler..." << std::endl;
+            totalTests++;
+            try {
+                using Priority = cpu_physics::interfaces::CPUPhysicsSystem::Priority;
+                auto ecs = std::make_shared<cpu_physics::ECSManager>();
+                
+                // Trigger and spin share no written component, so they should overlap in time
+                std::atomic<int> started{0};
+                std::atomic<int> overlapped{0};
+                auto meetOther = [&]() {
+                    started++;
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+                    while (started.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+                        std::this_thread::yield();
+                    }
+                    if (started.load() >= 2) overlapped++;
+                };
+                std::vector<std::string> finished;
+                std::mutex finishedMutex;
+                auto record = [&](const char* name) {
+                    std::lock_guard<std::mutex> lock(finishedMutex);
+                    finished.push_back(name);
+                };
+                
+                auto trigger = std::make_shared<ScriptedTestSystem>(ecs, "Trigger", Priority::HIGH,
+                    std::vector<ComponentType>{ComponentType::TRANSFORM, ComponentType::BOX_COLLIDER},
+                    std::vector<ComponentType>{}, [&]() { meetOther(); record("Trigger"); });
+                auto spin = std::make_shared<ScriptedTestSystem>(ecs, "Spin", Priority::NORMAL,
+                    std::vector<ComponentType>{ComponentType::PHYSICS},
+                    std::vector<ComponentType>{ComponentType::PHYSICS}, [&]() { meetOther(); record("Spin"); });
+                // Writes Transform (read by Trigger) and reads Physics (written by Spin)
+                auto move = std::make_shared<ScriptedTestSystem>(ecs, "Move", Priority::LOW,
+                    std::vector<ComponentType>{ComponentType::PHYSICS, ComponentType::TRANSFORM},
+                    std::vector<ComponentType>{ComponentType::TRANSFORM}, [&]() { record("Move"); });
+                for (auto& system : {trigger, spin, move}) {
+                    assert(system->initialize());
+                }
+                
+                cpu_physics::SystemScheduler scheduler;
+                scheduler.setJobSystem(std::make_shared<JobSystem>(2));
+                scheduler.addSystem(move);
+                scheduler.addSystem(spin);
+                scheduler.addSystem(trigger);
+                
+                assert(scheduler.getExecutionOrder()[0] == trigger);
+                assert(!scheduler.dependsOn(spin.get(), trigger.get()));
+                assert(scheduler.dependsOn(move.get(), trigger.get()));
+                assert(scheduler.dependsOn(move.get(), spin.get()));
+                
+                scheduler.update(0.016f);
+                assert(overlapped == 2);
+                assert(finished.size() == 3 && finished.back() == "Move");
+                assert(trigger->getLastUpdateTime() > 0.0f);
+                
+                // The graph is only rebuilt when the system set changes
+                size_t builds = scheduler.getGraphBuildCount();
+                scheduler.update(0.016f);
+                assert(scheduler.getGraphBuildCount() == builds);
+                assert(scheduler.removeSystem(spin.get()));
+                scheduler.update(0.016f);
+                assert(scheduler.getGraphBuildCount() == builds + 1);
+                assert(scheduler.getSystemCount() == 2);
+                std::cout << "✓ PASSED: System scheduler" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: System scheduler - " << e.what() << std::endl;
+            }
+            
+            // Test 15: Asynchronous stepping
+            std::cout << "\n[Test 15] Asynchronous stepping..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                PhysicsEngine syncEngine;
+                PhysicsEngine asyncEngine;
+                assert(syncEngine.initialize(0, 10) && asyncEngine.initialize(0, 10));
+                uint32_t syncBody = syncEngine.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+                uint32_t asyncBody = asyncEngine.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+                
+                // endStep() without a step in flight is a no-op
+                asyncEngine.endStep();
+                assert(!asyncEngine.isStepInFlight());
+                
+                for (int step = 0; step < 3; step++) {
+                    syncEngine.updatePhysics(dt);
+                    asyncEngine.beginStep(dt);
+                    assert(asyncEngine.isStepInFlight());
+                    asyncEngine.endStep();
+                    assert(!asyncEngine.isStepInFlight());
+                }
+                
+                // A new step joins the one in flight before starting
+                asyncEngine.beginStep(dt);
+                asyncEngine.beginStep(dt);
+                asyncEngine.endStep();
+                syncEngine.updatePhysics(dt);
+                syncEngine.updatePhysics(dt);
+                
+                auto* syncTransform = syncEngine.getCPUPhysics()->getECSManager()->getTransformComponent(syncBody);
+                auto* asyncTransform = asyncEngine.getCPUPhysics()->getECSManager()->getTransformComponent(asyncBody);
+                assert(asyncTransform->position[1] < 10.0f);
+                assert(asyncTransform->position[1] == syncTransform->position[1]);
+                
+                // Cleanup joins a step that was never ended
+                asyncEngine.beginStep(dt);
+                asyncEngine.cleanup();
+                assert(!asyncEngine.isStepInFlight());
+                std::cout << "✓ PASSED: Asynchronous stepping" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Asynchronous stepping - " << e.what() << std::endl;
+            }
+            
+            // Test 16: Independent physics worlds on shared resources
+            std::cout << "\n[Test 16] Physics worlds..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                auto shared = std::make_shared<SharedPhysicsResources>(3);
+                
+                // Worlds share the job system but nothing else
+                std::vector<std::unique_ptr<PhysicsWorld>> worlds;
+                std::vector<PhysicsWorld*> worldPointers;
+                for (int i = 0; i < 8; i++) {
+                    worlds.push_back(std::make_unique<PhysicsWorld>(shared));
+                    assert(worlds.back()->initialize(10));
+                    worlds.back()->setGravity(0.0f, -1.0f - static_cast<float>(i), 0.0f);
+                    assert(worlds.back()->createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f) != 0);
+                    worldPointers.push_back(worlds.back().get());
+                }
+                assert(worlds[0]->getCPUPhysics()->getJobSystem() == shared->getJobSystem());
+                assert(worlds[0]->getCPUPhysics()->getECSManager() != worlds[1]->getCPUPhysics()->getECSManager());
+                
+                // A world stepped on its own gives the same result as when stepped alongside others
+                PhysicsWorld reference(shared);
+                assert(reference.initialize(10));
+                reference.setGravity(0.0f, -4.0f, 0.0f);
+                uint32_t referenceBody = reference.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+                
+                for (int step = 0; step < 10; step++) {
+                    PhysicsWorld::stepWorlds(worldPointers, dt);
+                    reference.step(dt);
+                }
+                
+                float lastHeight = 10.0f;
+                for (auto& world : worlds) {
+                    assert(world->getStepCount() == 10);
+                    auto ecs = world->getCPUPhysics()->getECSManager();
+                    float height = ecs->getTransformComponent(ecs->getEntitiesWithTransformComponent()[0])->position[1];
+                    assert(height < lastHeight); // stronger gravity fell further
+                    lastHeight = height;
+                }
+                auto referenceEcs = reference.getCPUPhysics()->getECSManager();
+                auto thirdEcs = worlds[3]->getCPUPhysics()->getECSManager();
+                assert(referenceEcs->getTransformComponent(referenceBody)->position[1] ==
+                       thirdEcs->getTransformComponent(thirdEcs->getEntitiesWithTransformComponent()[0])->position[1]);
+                std::cout << "✓ PASSED: Physics worlds" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Physics worlds - " << e.what() << std::endl;
+            }
+            
+            // Test 17: Deterministic mode
+            std::cout << "\n[Test 17] Deterministic mode..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                auto makeEngine = [](uint32_t workers) {
+                    auto engine = std::make_unique<cpu_physics::CPUPhysicsEngine>();
+                    engine->setJobSystem(std::make_shared<JobSystem>(workers));
+                    engine->initialize(512);
+                    engine->setDeterministic(true);
+                    auto collision = engine->getCollisionSystem();
+                    collision->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                    collision->setLargeIslandThreshold(8); // exercise the colored solver too
+                    
+                    // Overlapping piles so contacts, islands and colors all get work
+                    engine->createRigidBody(0.0f, -1.0f, 0.0f, 60.0f, 1.0f, 60.0f, 0.0f);
+                    for (int i = 0; i < 300; i++) {
+                        float x = static_cast<float>(i % 15) * 0.9f;
+                        float y = static_cast<float>(i / 15) * 0.9f;
+                        engine->createRigidBody(x, y, static_cast<float>(i % 3) * 0.3f, 1.0f, 1.0f, 1.0f, 1.0f + (i % 5) * 0.25f);
+                    }
+                    return engine;
+                };
+                
+                auto serial = makeEngine(1);
+                auto wide = makeEngine(6);
+                assert(serial->isDeterministic() && wide->isDeterministic());
+                
+                uint64_t firstHash = 0;
+                for (int step = 0; step < 20; step++) {
+                    serial->updatePhysics(dt);
+                    wide->updatePhysics(dt);
+                    assert(serial->getLastStateHash() != 0);
+                    assert(serial->getLastStateHash() == wide->getLastStateHash());
+                    if (step == 0) firstHash = serial->getLastStateHash();
+                }
+                assert(serial->getCollisionSystem()->getLastCollisionCount() > 0);
+                assert(serial->getLastStateHash() != firstHash);
+                
+                // The hash sees small drift in a single body
+                wide->getECSManager()->getTransformComponent(301)->position[0] += 1e-4f;
+                serial->updatePhysics(dt);
+                wide->updatePhysics(dt);
+                assert(serial->getLastStateHash() != wide->getLastStateHash());
+                std::cout << "✓ PASSED: Deterministic mode" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Deterministic mode - " << e.what() << std::endl;
+            }
+            
+            // Test 18: Dedicated physics thread with command queue and snapshots
+            std::cout << "\n[Test 18] Physics thread..." << std::endl;
+            totalTests++;
+            try {
+                // The MPSC queue keeps every producer's entries and their order
+                CommandQueue<uint64_t> queue(64);
+                std::vector<std::thread> producers;
+                for (uint64_t producer = 0; producer < 4; producer++) {
+                    producers.emplace_back([&, producer]() {
+                        for (uint64_t i = 0; i < 2000; i++) {
+                            while (!queue.push(producer << 32 | i)) std::this_thread::yield();
+                        }
+                    });
+                }
+                std::vector<uint64_t> expected(4, 0);
+                size_t received = 0;
+                while (received < 8000) {
+                    uint64_t value;
+                    if (queue.pop(value)) {
+                        assert((value & 0xffffffffu) == expected[value >> 32]++);
+                        received++;
+                    }
+                }
+                for (auto& producer : producers) producer.join();
+                
+                PhysicsEngine engine;
+                assert(engine.initialize(0, 100));
+                engine.setSimulationRate(240.0f);
+                PhysicsThread physicsThread(engine, 256);
+                
+                // Commands are applied at the next step; handles are usable right away
+                PhysicsThread::BodyHandle falling = physicsThread.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                PhysicsThread::BodyHandle pushed = physicsThread.createRigidBody(5.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                assert(falling != 0 && pushed != falling);
+                assert(physicsThread.setVelocity(pushed, 1.0f, 0.0f, 0.0f));
+                assert(physicsThread.acquireSnapshot().getBody(falling) == nullptr);
+                physicsThread.stepOnce();
+                const PhysicsSnapshot& first = physicsThread.acquireSnapshot();
+                assert(first.stepIndex == 1);
+                assert(first.getBody(falling)->position[1] < 10.0f);
+                assert(first.getBody(pushed)->position[0] > 5.0f);
+                
+                // Producers on several threads while the physics thread runs and this thread reads
+                physicsThread.start();
+                std::vector<std::thread> writers;
+                std::atomic<uint32_t> created{0};
+                for (int writer = 0; writer < 4; writer++) {
+                    writers.emplace_back([&, writer]() {
+                        for (int i = 0; i < 10; i++) {
+                            auto handle = physicsThread.createRigidBody(static_cast<float>(writer * 2), 20.0f,
+                                                                        static_cast<float>(i * 2), 1.0f, 1.0f, 1.0f);
+                            if (handle != 0 && physicsThread.setVelocity(handle, 0.0f, 1.0f, 0.0f)) {
+                                created++;
+                            }
+                        }
+                    });
+                }
+                for (auto& writer : writers) writer.join();
+                physicsThread.setGravity(0.0f, 0.0f, 0.0f);
+                
+                uint64_t lastStep = first.stepIndex;
+                size_t aliveBodies = 0;
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (aliveBodies < 42 && std::chrono::steady_clock::now() < deadline) {
+                    const PhysicsSnapshot& snapshot = physicsThread.acquireSnapshot();
+                    assert(snapshot.stepIndex >= lastStep);
+                    lastStep = snapshot.stepIndex;
+                    aliveBodies = 0;
+                    for (size_t handle = 1; handle < snapshot.bodies.size(); handle++) {
+                        aliveBodies += snapshot.getBody(static_cast<uint32_t>(handle)) != nullptr;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                physicsThread.stop();
+                assert(created == 40 && aliveBodies == 42);
+                assert(physicsThread.getDroppedCommandCount() == 0);
+                
+                // Removal takes effect at the next step
+                physicsThread.removeRigidBody(falling);
+                physicsThread.stepOnce();
+                assert(physicsThread.acquireSnapshot().getBody(falling) == nullptr);
+                assert(engine.getCPUPhysics()->getRigidBodyCount() == 41);
+                std::cout << "✓ PASSED: Physics thread" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Physics thread - " << e.what() << std::endl;
+            }
+            
+            // Test 19: Batched worlds in SIMD lanes
+            std::cout << "\n[Test 19] Batched worlds..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                const uint32_t worldCount = 2 * cpu_physics::simd::WIDTH + 3; // last block partly used
+                const float scene[4][7] = {
+                    {0.0f, -0.5f, 0.0f, 20.0f, 1.0f, 20.0f, 0.0f}, // static floor
+                    {0.0f, 0.45f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f},
+                    {0.2f, 1.3f, 0.1f, 1.0f, 1.0f, 1.0f, 2.0f},
+                    {3.0f, 2.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.5f}
+                };
+                
+                cpu_physics::BatchedWorlds batch;
+                for (const auto& body : scene) {
+                    batch.addBody(body[0], body[1], body[2], body[3], body[4], body[5], body[6]);
+                }
+                batch.setJobSystem(std::make_shared<JobSystem>(3));
+                assert(batch.initialize(worldCount));
+                assert(batch.getBodyCount() == 4 && batch.getBlockCount() == 3);
+                
+                // Every world starts from its own initial conditions
+                const uint32_t stateSize = cpu_physics::BatchedWorlds::STATE_SIZE;
+                std::vector<float> states(worldCount * 4 * stateSize);
+                batch.observe(states.data());
+                for (uint32_t world = 0; world < worldCount; world++) {
+                    float* body3 = &states[(world * 4 + 3) * stateSize];
+                    body3[0] = -3.0f + 0.3f * static_cast<float>(world); // sweeps into the stack
+                    body3[7] = -2.0f;                                     // velocity x
+                    states[(world * 4 + 2) * stateSize + 8] = -0.1f * static_cast<float>(world % 5);
+                }
+                batch.reset(states.data());
+                for (int step = 0; step < 40; step++) {
+                    batch.step(dt);
+                }
+                batch.observe(states.data());
+                
+                // Each lane matches a deterministic engine holding the same world
+                for (uint32_t world : {0u, 5u, worldCount - 1}) {
+                    cpu_physics::CPUPhysicsEngine engine;
+                    engine.initialize(10);
+                    engine.setDeterministic(true);
+                    engine.getCollisionSystem()->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                    std::vector<uint32_t> ids;
+                    for (const auto& body : scene) {
+                        ids.push_back(engine.createRigidBody(body[0], body[1], body[2], body[3], body[4], body[5], body[6]));
+                    }
+                    auto ecs = engine.getECSManager();
+                    ecs->getTransformComponent(ids[3])->position[0] = -3.0f + 0.3f * static_cast<float>(world);
+                    ecs->getPhysicsComponent(ids[3])->velocity[0] = -2.0f;
+                    ecs->getPhysicsComponent(ids[2])->velocity[1] = -0.1f * static_cast<float>(world % 5);
+                    for (int step = 0; step < 40; step++) {
+                        engine.updatePhysics(dt);
+                    }
+                    
+                    for (uint32_t body = 0; body < 4; body++) {
+                        const float* state = &states[(world * 4 + body) * stateSize];
+                        const auto* transform = ecs->getTransformComponent(ids[body]);
+                        const auto* physics = ecs->getPhysicsComponent(ids[body]);
+                        for (int axis = 0; axis < 3; axis++) {
+                            assert(state[axis] == transform->position[axis]);
+                            assert(state[7 + axis] == physics->velocity[axis]);
+                        }
+                    }
+                }
+                
+                // The stack rests on the floor, and partial resets leave other worlds alone
+                assert(states[(0 * 4 + 1) * stateSize + 1] > 0.0f);
+                std::vector<float> before = states;
+                uint32_t resetWorld = 4;
+                batch.resetWorldsToTemplate(&resetWorld, 1);
+                batch.observe(states.data());
+                assert(states[(4 * 4 + 3) * stateSize + 0] == 3.0f);
+                assert(states[(4 * 4 + 3) * stateSize + 7] == 0.0f);
+                assert(std::equal(states.begin(), states.begin() + 4 * 4 * stateSize, before.begin()));
+                std::cout << "✓ PASSED: Batched worlds" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Batched worlds - " << e.what() << std::endl;
+            }
+            
+            // Test 20: Time-budgeted stepping and sleeping
+            std::cout << "\n[Test 20] Time-budgeted stepping..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                cpu_physics::CPUPhysicsEngine engine;
+                engine.initialize(200);
+                auto collision = engine.getCollisionSystem();
+                collision->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                collision->setSolverIterations(64);
+                collision->setSleepingEnabled(true);
+                
+                engine.createRigidBody(0.0f, -0.5f, 0.0f, 40.0f, 1.0f, 40.0f, 0.0f);
+                std::vector<uint32_t> boxes;
+                for (int i = 0; i < 8; i++) {
+                    boxes.push_back(engine.createRigidBody(static_cast<float>(i) * 2.0f, 0.45f, 0.0f, 1.0f, 1.0f, 1.0f));
+                }
+                
+                // Unbudgeted steps run every iteration and let the resting boxes fall asleep
+                auto ecs = engine.getECSManager();
+                for (int step = 0; step < 120; step++) {
+                    engine.updatePhysics(dt);
+                }
+                auto stats = engine.getLastBudgetStats();
+                assert(!stats.isDegraded() && stats.solverIterations == 64);
+                for (uint32_t box : boxes) {
+                    assert(ecs->getPhysicsComponent(box)->isSleeping);
+                }
+                
+                // A falling box wakes the one it lands on
+                engine.createRigidBody(0.0f, 3.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                bool woke = false;
+                for (int step = 0; step < 60 && !woke; step++) {
+                    engine.updatePhysics(dt);
+                    woke = !ecs->getPhysicsComponent(boxes[0])->isSleeping;
+                }
+                assert(woke && ecs->getPhysicsComponent(boxes[1])->isSleeping);
+                
+                // A budget far below the solve cost cuts iterations, then defers the sleep checks
+                engine.updatePhysics(dt, 1e-6f);
+                stats = engine.getLastBudgetStats();
+                assert(stats.reducedIterations && stats.solverIterations == 1);
+                assert(stats.deferredSleepChecks && stats.isDegraded());
+                
+                // The configured iteration count survives the degraded step
+                engine.updatePhysics(dt);
+                assert(engine.getLastBudgetStats().solverIterations == 64);
+                
+                // The fixed-timestep loop drops substeps that are predicted not to fit
+                PhysicsEngine hybrid;
+                hybrid.initialize(0, 100);
+                hybrid.getCPUPhysics()->getCollisionSystem()->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                hybrid.createRigidBody(0.0f, -0.5f, 0.0f, 40.0f, 1.0f, 40.0f, 0.0f);
+                hybrid.createRigidBody(0.0f, 2.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                assert(hybrid.update(4.0f * hybrid.getFixedTimestep()) == 4);
+                assert(hybrid.getLastBudgetStats().droppedSubsteps == 0);
+                assert(hybrid.update(4.0f * hybrid.getFixedTimestep(), 1e-6f) == 1);
+                assert(hybrid.getLastBudgetStats().droppedSubsteps == 3);
+                assert(hybrid.update(0.5f * hybrid.getFixedTimestep()) == 0); // dropped time is not carried over
+                hybrid.cleanup();
+                std::cout << "✓ PASSED: Time-budgeted stepping" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Time-budgeted stepping - " << e.what() << std::endl;
+            }
+            
+            // Test 21: Simulation LOD around focus points
+            std::cout << "\n[Test 21] Simulation LOD..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                cpu_physics::CPUPhysicsEngine engine;
+                engine.initialize(20);
+                auto collision = engine.getCollisionSystem();
+                collision->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                collision->addFocusPoint(0.0f, 0.0f, 0.0f);
+                collision->setLodDistances(10.0f, 20.0f);
+                auto ecs = engine.getECSManager();
+                
+                // Far bodies skip three of every four steps, then catch up on the skipped time
+                uint32_t nearBox = engine.createRigidBody(0.0f, 10.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                uint32_t farBox = engine.createRigidBody(0.0f, 10.0f, 100.0f, 1.0f, 1.0f, 1.0f);
+                engine.updatePhysics(dt);
+                for (int step = 1; step < 4; step++) {
+                    float heldY = ecs->getTransformComponent(farBox)->position[1];
+                    engine.updatePhysics(dt);
+                    assert(collision->getLastLodSkippedCount() == 1);
+                    assert(ecs->getTransformComponent(farBox)->position[1] == heldY);
+                }
+                engine.updatePhysics(dt);
+                assert(collision->getLastLodSkippedCount() == 0);
+                assert(ecs->getPhysicsComponent(farBox)->lodPeriod == 4 && ecs->getPhysicsComponent(nearBox)->lodPeriod == 1);
+                float nearVelocity = ecs->getPhysicsComponent(nearBox)->velocity[1];
+                float farVelocity = ecs->getPhysicsComponent(farBox)->velocity[1];
+                assert(std::abs(farVelocity - nearVelocity) < 0.05f * std::abs(nearVelocity));
+                
+                // A full-rate body pushing a reduced-rate one promotes it and moves it
+                engine.createRigidBody(0.0f, -0.5f, 100.0f, 20.0f, 1.0f, 20.0f, 0.0f);
+                uint32_t crate = engine.createRigidBody(0.0f, 0.45f, 104.0f, 1.0f, 1.0f, 1.0f);
+                uint32_t projectile = engine.createRigidBody(0.0f, 0.6f, 102.0f, 1.0f, 1.0f, 1.0f);
+                ecs->getPhysicsComponent(projectile)->lodImportance = 1000.0f;
+                ecs->getPhysicsComponent(projectile)->useGravity = false;
+                ecs->getPhysicsComponent(projectile)->velocity[2] = 6.0f;
+                bool promoted = false;
+                for (int step = 0; step < 40 && !promoted; step++) {
+                    engine.updatePhysics(dt);
+                    promoted = ecs->getPhysicsComponent(crate)->lodHoldSteps > 0;
+                }
+                assert(promoted && ecs->getPhysicsComponent(crate)->velocity[2] > 0.0f);
+                engine.updatePhysics(dt);
+                assert(ecs->getPhysicsComponent(crate)->lodPeriod == 1);
+                
+                // Without focus points every body runs at full rate again
+                collision->clearFocusPoints();
+                engine.updatePhysics(dt);
+                assert(collision->getLastLodSkippedCount() == 0);
+                std::cout << "✓ PASSED: Simulation LOD" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Simulation LOD - " << e.what() << std::endl;
+            }
+            
+            // Test 22: Continuous collision detection
+            std::cout << "\n[Test 22] Continuous collision detection..." << std::endl;
+            totalTests++;
+            try {
+                const float dt = 1.0f / 60.0f;
+                auto fireAtWall = [dt](bool continuous, float& finalX, float& finalVelocity) {
+                    cpu_physics::CPUPhysicsEngine engine;
+                    engine.initialize(10);
+                    engine.getCollisionSystem()->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                    engine.createRigidBody(0.0f, 0.0f, 0.0f, 0.4f, 10.0f, 10.0f, 0.0f); // wall as in main.cpp
+                    uint32_t projectile = engine.createRigidBody(-3.0f, 0.0f, 0.0f, 0.1f, 0.1f, 0.1f, 0.05f);
+                    assert(engine.setContinuousCollision(projectile, continuous));
+                    auto* physics = engine.getECSManager()->getPhysicsComponent(projectile);
+                    physics->useGravity = false;
+                    physics->velocity[0] = 150.0f; // 2.5 units per step
+                    size_t hits = 0;
+                    for (int step = 0; step < 4; step++) {
+                        engine.updatePhysics(dt);
+                        hits += engine.getCollisionSystem()->getLastContinuousHitCount();
+                    }
+                    finalX = engine.getECSManager()->getTransformComponent(projectile)->position[0];
+                    finalVelocity = physics->velocity[0];
+                    return hits;
+                };
+                
+                // Without CCD the projectile steps over the wall
+                float x = 0.0f, velocity = 0.0f;
+                assert(fireAtWall(false, x, velocity) == 0);
+                assert(x > 0.2f && velocity > 0.0f);
+                
+                // With CCD it stops at the wall and bounces back, all at the normal step rate
+                assert(fireAtWall(true, x, velocity) == 1);
+                assert(x < -0.2f && velocity < 0.0f);
+                std::cout << "✓ PASSED: Continuous collision detection" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Continuous collision detection - " << e.what() << std::endl;
+            }
+            
+            // Test 23: Asynchronous logging backend
+            std::cout << "\n[Test 23] Asynchronous logging..." << std::endl;
+            totalTests++;
+            try {
+                Logger& logger = Logger::getInstance();
+                const std::string logPath = "titanium_async_log_test.txt";
+                std::remove(logPath.c_str());
+                logger.enableConsoleOutput(false);
+                logger.setOutputFile(logPath);
+                assert(logger.isAsync());
+                
+                auto readLines = [&logPath]() {
+                    std::ifstream file(logPath);
+                    std::vector<std::string> lines;
+                    for (std::string line; std::getline(file, line);) {
+                        lines.push_back(line);
+                    }
+                    return lines;
+                };
+                
+                // Blocking policy: every message arrives, in order per thread
+                logger.setOverflowPolicy(LogOverflowPolicy::BLOCK);
+                logger.setThreadBufferCapacity(16);
+                const int threadCount = 4;
+                const int messagesPerThread = 500;
+                std::vector<std::thread> producers;
+                for (int t = 0; t < threadCount; t++) {
+                    producers.emplace_back([t, messagesPerThread]() {
+                        for (int i = 0; i < messagesPerThread; i++) {
+                            Logger::getInstance().info(LogCategory::GENERAL, "async-test " + std::to_string(t) + " " + std::to_string(i));
+                        }
+                    });
+                }
+                for (auto& producer : producers) {
+                    producer.join();
+                }
+                const std::string longMessage(1000, 'x');
+                logger.info(LogCategory::GENERAL, "long " + longMessage + " end");
+                logger.flush();
+                
+                std::vector<int> nextIndex(threadCount, 0);
+                bool longFound = false;
+                for (const auto& line : readLines()) {
+                    auto marker = line.find("async-test ");
+                    if (marker != std::string::npos) {
+                        int thread = 0, index = 0;
+                        std::istringstream(line.substr(marker + 11)) >> thread >> index;
+                        assert(index == nextIndex[thread]);
+                        nextIndex[thread]++;
+                    }
+                    longFound |= line.find("long " + longMessage + " end") != std::string::npos;
+                }
+                for (int count : nextIndex) {
+                    assert(count == messagesPerThread);
+                }
+                assert(longFound);
+                
+                // Drop policy never waits: whatever does not fit is counted instead
+                logger.setOverflowPolicy(LogOverflowPolicy::DROP);
+                uint64_t droppedBefore = logger.getDroppedMessageCount();
+                const int burst = 5000;
+                std::thread([burst]() {
+                    for (int i = 0; i < burst; i++) {
+                        Logger::getInstance().info(LogCategory::GENERAL, "drop-test " + std::to_string(i));
+                    }
+                }).join();
+                logger.flush();
+                size_t written = 0;
+                for (const auto& line : readLines()) {
+                    written += line.find("drop-test ") != std::string::npos ? 1 : 0;
+                }
+                assert(written + (logger.getDroppedMessageCount() - droppedBefore) == static_cast<size_t>(burst));
+                
+                logger.setThreadBufferCapacity(512);
+                logger.closeOutputFile();
+                logger.enableConsoleOutput(true);
+                std::remove(logPath.c_str());
+                std::cout << "✓ PASSED: Asynchronous logging" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Asynchronous logging - " << e.what() << std::endl;
+            }
+            
+            // Test 24: Lazy log formatting and disabled log calls
+            std::cout << "\n[Test 24] Lazy log formatting..." << std::endl;
+            totalTests++;
+            try {
+                Logger& logger = Logger::getInstance();
+                
+                // Disabled levels and categories never evaluate their arguments
+                int evaluations = 0;
+                auto expensive = [&evaluations]() {
+                    evaluations++;
+                    return std::string("expensive");
+                };
+                logger.setLogLevel(LogLevel::WARN);
+                LOG_DEBUG(LogCategory::PHYSICS, "debug " + expensive());
+                LOG_INFO(LogCategory::PHYSICS, "info {}", expensive());
+                logger.disableCategory(LogCategory::COLLISION);
+                LOG_ERROR(LogCategory::COLLISION, "error " + expensive());
+                assert(evaluations == 0);
+                logger.enableCategory(LogCategory::COLLISION);
+                logger.setLogLevel(LogLevel::INFO);
+                
+                // Arguments are captured raw and formatted std::format-style later
+                LogArguments arguments;
+                arguments.encode(42, -3, 1.5f, 3.14159, "text", std::string("string"), true, uint64_t(7));
+                std::string text = LogArguments::format("{} {} {} {:.2f} {} {} {} {} {{braces}} {}",
+                                                        arguments.data(), arguments.size());
+                assert(text == "42 -3 1.5 3.14 text string true 7 {braces} {?}");
+                
+                // String literals, char arrays and null C strings
+                char buffer[] = "array";
+                const char* missing = nullptr;
+                LogArguments strings;
+                strings.encode("literal", buffer, missing);
+                assert(LogArguments::format("{} {} {}", strings.data(), strings.size()) == "literal array (null)");
+                
+                // Both backends produce the same text (called directly: LOG_INFO may be compiled out)
+                const std::string logPath = "titanium_format_log_test.txt";
+                std::remove(logPath.c_str());
+                logger.enableConsoleOutput(false);
+                logger.setOutputFile(logPath);
+                logger.logFormat(LogLevel::INFO, LogCategory::GENERAL, "format-test async {} {:.1f} {}", 7u, 0.25f, "seven");
+                logger.setAsync(false);
+                logger.logFormat(LogLevel::INFO, LogCategory::GENERAL, "format-test sync {} {:.1f} {}", 7u, 0.25f, "seven");
+                logger.setAsync(true);
+                logger.flush();
+                std::ifstream file(logPath);
+                int found = 0;
+                for (std::string line; std::getline(file, line);) {
+                    found += line.find("format-test async 7 0.2 seven") != std::string::npos ? 1 : 0;
+                    found += line.find("format-test sync 7 0.2 seven") != std::string::npos ? 1 : 0;
+                }
+                assert(found == 2);
+                
+                logger.closeOutputFile();
+                logger.enableConsoleOutput(true);
+                std::remove(logPath.c_str());
+                std::cout << "✓ PASSED: Lazy log formatting" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Lazy log formatting - " << e.what() << std::endl;
+            }
+            
+            // Test 25: Binary log sink and decoding
+            std::cout << "\n[Test 25] Binary log sink..." << std::endl;
+            totalTests++;
+            try {
+                Logger& logger = Logger::getInstance();
+                const std::string binaryPath = "titanium_binary_log_test.tlog";
+                std::remove(binaryPath.c_str());
+                
+                // Text sinks off: the binary log alone never formats anything
+                logger.enableConsoleOutput(false);
+                logger.setBinaryOutputFile(binaryPath);
+                for (int i = 0; i < 3; i++) {
+                    logger.logFormat(LogLevel::INFO, LogCategory::PHYSICS, "binary-test body {} at {:.2f}", i, 0.5f * i);
+                }
+                logger.info(LogCategory::GENERAL, "binary-test plain");
+                logger.logMetric(LogLevel::WARN, LogCategory::PERFORMANCE, "binary_test_ms", 2.5f);
+                logger.setAsync(false);
+                logger.logFormat(LogLevel::INFO, LogCategory::PHYSICS, "binary-test body {} at {:.2f}", 3, 1.5f);
+                logger.setAsync(true);
+                logger.closeBinaryOutputFile();
+                logger.enableConsoleOutput(true);
+                
+                BinaryLogReader reader;
+                assert(reader.open(binaryPath));
+                std::vector<BinaryLogEntry> entries;
+                for (BinaryLogEntry entry; reader.next(entry);) {
+                    entries.push_back(entry);
+                }
+                assert(!reader.isDamaged());
+                assert(entries.size() == 6);
+                
+                // Each format string and metric name is stored once
+                assert(reader.getStringCount() == 2);
+                assert(entries[0].kind == LogRecordKind::FORMAT);
+                assert(entries[0].category == LogCategory::PHYSICS);
+                assert(entries[2].text() == "binary-test body 2 at 1.00");
+                assert(entries[3].kind == LogRecordKind::TEXT && entries[3].text() == "binary-test plain");
+                assert(entries[5].text() == "binary-test body 3 at 1.50");
+                
+                // Metrics keep their numeric type
+                const BinaryLogEntry& metric = entries[4];
+                assert(metric.kind == LogRecordKind::METRIC && metric.level == LogLevel::WARN);
+                assert(metric.format == "binary_test_ms" && metric.text() == "binary_test_ms=2.5");
+                auto values = LogArguments::decode(metric.payload.data(), metric.payload.size());
+                assert(values.size() == 1 && values[0].type == LogArguments::Type::FLOAT);
+                
+                // A binary record is much smaller than its text line
+                std::ifstream size(binaryPath, std::ios::binary | std::ios::ate);
+                assert(size.tellg() < 6 * 60);
+                
+                std::remove(binaryPath.c_str());
+                std::cout << "✓ PASSED: Binary log sink" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Binary log sink - " << e.what() << std::endl;
+            }
+            
+            // Test 26: Hierarchical profiler and Chrome trace export
+            std::cout << "\n[Test 26] Scoped profiler..." << std::endl;
+            totalTests++;
+            try {
+                Profiler& profiler = Profiler::getInstance();
+                cpu_physics::CPUPhysicsEngine engine;
+                engine.initialize(20);
+                engine.getCollisionSystem()->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                engine.createRigidBody(0.0f, -0.5f, 0.0f, 20.0f, 1.0f, 20.0f, 0.0f);
+                for (int i = 0; i < 4; i++) {
+                    engine.createRigidBody(static_cast<float>(i) * 2.0f, 0.45f, 0.0f, 1.0f, 1.0f, 1.0f);
+                }
+                
+                // Disabled scopes record nothing
+                profiler.setEnabled(false);
+                profiler.clear();
+                engine.updatePhysics(1.0f / 60.0f);
+                assert(profiler.getEvents().empty());
+                
+                const int steps = 5;
+                profiler.setEnabled(true);
+                for (int step = 0; step < steps; step++) {
+                    engine.updatePhysics(1.0f / 60.0f);
+                }
+                profiler.setEnabled(false);
+                
+#if TITANIUM_PROFILING
+                // Scopes nest under the step that ran them
+                ProfileNode tree = profiler.getAggregateTree();
+                const ProfileNode* step = tree.find("CPUPhysicsEngine::updatePhysics");
+                assert(step && step->calls == steps);
+                const ProfileNode* broadphase = step->find("CollisionSystem::update/contacts/broadphase");
+                const ProfileNode* narrowphase = step->find("CollisionSystem::update/contacts/narrowphase");
+                assert(broadphase && broadphase->calls == steps && narrowphase && narrowphase->calls == steps);
+                assert(step->find("CollisionSystem::update/integrate") && step->find("legacy sync"));
+                const ProfileNode* update = step->find("CollisionSystem::update");
+                assert(update->minMs <= update->averageMs() && update->averageMs() <= update->maxMs);
+                assert(update->totalMs <= step->totalMs);
+                
+                // Chrome trace: one complete event per scope
+                std::string trace = profiler.getChromeTrace();
+                size_t completeEvents = 0;
+                for (size_t at = trace.find("\"ph\":\"X\""); at != std::string::npos;
+                     at = trace.find("\"ph\":\"X\"", at + 1)) {
+                    completeEvents++;
+                }
+                assert(trace.rfind("{\"displayTimeUnit\"", 0) == 0 && completeEvents == profiler.getEvents().size());
+                const std::string tracePath = "titanium_profile_test.json";
+                assert(profiler.exportChromeTrace(tracePath));
+                std::remove(tracePath.c_str());
+#endif
+                
+                profiler.clear();
+                assert(profiler.getEvents().empty() && profiler.getDroppedEventCount() == 0);
+                std::cout << "✓ PASSED: Scoped profiler" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Scoped profiler - " << e.what() << std::endl;
+            }
+            
+            // Test 27: Per-step statistics and rolling percentiles
+            std::cout << "\n[Test 27] Per-step physics statistics..." << std::endl;
+            totalTests++;
+            try {
+                PhysicsEngine engine;
+                engine.initialize(0, 16);
+                auto collision = engine.getCPUPhysics()->getCollisionSystem();
+                collision->setLayerInteractionCallback([](uint32_t, uint32_t) { return true; });
+                engine.createRigidBody(0.0f, -0.5f, 0.0f, 20.0f, 1.0f, 20.0f, 0.0f);
+                for (int i = 0; i < 3; i++) {
+                    engine.createRigidBody(static_cast<float>(i) * 3.0f, 0.45f, 0.0f, 1.0f, 1.0f, 1.0f);
+                }
+                engine.createRigidBody(0.0f, 0.0f, 5.0f, 1.0f, 1.0f, 1.0f, 0.0f); // static, overlaps the ground
+                
+                const int steps = 12;
+                for (int step = 0; step < steps; step++) {
+                    engine.updatePhysics(1.0f / 60.0f);
+                }
+                
+                const cpu_physics::PhysicsStepStats& stats = engine.getLastStepStats();
+                assert(stats.stepIndex == steps - 1);
+                assert(stats.staticBodies == 2 && stats.awakeBodies == 3 && stats.sleepingBodies == 0);
+                assert(stats.broadphasePairsTested == 10);
+                assert(stats.layerFilteredPairs == 0);
+                assert(stats.broadphasePairsEmitted == 4 && stats.narrowphaseContacts == 4);
+                assert(stats.solverIterations == collision->getContactSolver().getIterations());
+                assert(stats.islands == 3);
+                assert(stats.solverResidual >= 0.0f && stats.solverResidual < 1.0f);
+                assert(stats.totalMs > 0.0f && stats.collisionDetectionMs + stats.solveMs <= stats.totalMs);
+                assert(stats.particles == 0);
+                
+                // Rolling window
+                const cpu_physics::PhysicsStatsHistory& history = engine.getStatsHistory();
+                assert(history.size() == steps && history.latest().stepIndex == stats.stepIndex);
+                auto total = history.summarize(&cpu_physics::PhysicsStepStats::totalMs);
+                assert(total.min <= total.p50 && total.p50 <= total.p90 && total.p90 <= total.p99 && total.p99 <= total.max);
+                assert(history.percentile(&cpu_physics::PhysicsStepStats::narrowphaseContacts, 50.0) == 4.0);
+                
+                cpu_physics::PhysicsStatsHistory window(4);
+                for (int i = 0; i < 10; i++) {
+                    cpu_physics::PhysicsStepStats sample;
+                    sample.totalMs = static_cast<float>(i);
+                    window.push(sample);
+                }
+                assert(window.size() == 4 && window.at(0).totalMs == 6.0f && window.latest().totalMs == 9.0f);
+                assert(window.percentile(&cpu_physics::PhysicsStepStats::totalMs, 50.0) == 7.0);
+                assert(window.percentile(&cpu_physics::PhysicsStepStats::totalMs, 0.0) == 6.0);
+                assert(window.percentile(&cpu_physics::PhysicsStepStats::totalMs, 99.0) == 9.0);
+                
+                // Pairs rejected by the layer rules never reach the narrow phase
+                collision->setLayerInteractionCallback([](uint32_t, uint32_t) { return false; });
+                engine.updatePhysics(1.0f / 60.0f);
+                assert(engine.getLastStepStats().layerFilteredPairs == 4);
+                assert(engine.getLastStepStats().broadphasePairsEmitted == 0);
+                assert(engine.getLastStepStats().narrowphaseContacts == 0);
+                assert(engine.getLastStepStats().solverIterations == 0);
+                
+                std::cout << "✓ PASSED: Per-step physics statistics" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Per-step physics statistics - " << e.what() << std::endl;
+            }
+            
+            // Test 28: Shared-memory metrics page
+            std::cout << "\n[Test 28] Shared-memory metrics page..." << std::endl;
+            totalTests++;
+            try {
+                const std::string pagePath = "titanium_metrics_test.page";
+                std::remove(pagePath.c_str());
+                
+                PhysicsEngine engine;
+                engine.initialize(0, 16);
+                engine.createRigidBody(0.0f, 5.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+                assert(engine.enableMetricsExport(pagePath) && engine.isMetricsExportEnabled());
+                
+                MetricsReader reader;
+                MetricsSnapshot snapshot;
+                assert(reader.open(pagePath) && reader.isWriterActive());
+                assert(!reader.read(snapshot)); // nothing published yet
+                
+                for (int step = 0; step < 5; step++) {
+                    engine.updatePhysics(1.0f / 60.0f);
+                }
+                assert(reader.read(snapshot));
+                assert(snapshot.stats.stepIndex == 4 && snapshot.stats.awakeBodies == 1);
+                assert(snapshot.stats.totalMs == engine.getLastStepStats().totalMs);
+                assert(snapshot.publishTime > 0);
+                
+                // Torn reads: every field of a published sample carries the same number
+                MetricsExporter exporter;
+                const std::string tornPath = "titanium_metrics_torn_test.page";
+                assert(exporter.open(tornPath));
+                MetricsReader tornReader;
+                assert(tornReader.open(tornPath));
+                std::atomic<bool> writing{true};
+                std::thread writer([&]() {
+                    cpu_physics::PhysicsStepStats stats;
+                    for (uint32_t i = 1; i <= 200000; i++) {
+                        stats.stepIndex = i;
+                        stats.awakeBodies = i;
+                        stats.broadphasePairsTested = i;
+                        stats.totalMs = static_cast<float>(i % 4096);
+                        exporter.publish(stats);
+                    }
+                    writing = false;
+                });
+                int consistentReads = 0;
+                bool torn = false;
+                while (writing) {
+                    MetricsSnapshot sample;
+                    if (tornReader.read(sample)) {
+                        const auto& stats = sample.stats;
+                        torn |= stats.awakeBodies != stats.stepIndex || stats.broadphasePairsTested != stats.stepIndex ||
+                                stats.totalMs != static_cast<float>(stats.stepIndex % 4096);
+                        consistentReads++;
+                    }
+                }
+                writer.join();
+                assert(!torn);
+                assert(exporter.getPublishedCount() == 200000);
+                assert(tornReader.read(snapshot) && snapshot.stats.stepIndex == 200000);
+                std::cout << "  " << consistentReads << " concurrent reads, none torn" << std::endl;
+                exporter.close();
+                assert(!tornReader.isWriterActive());
+                
+                // Only pages written by a matching build are accepted
+                {
+                    std::ofstream notAPage("titanium_metrics_bad_test.page");
+                    notAPage << std::string(sizeof(MetricsPageLayout), 'x');
+                }
+                MetricsReader badReader;
+                assert(!badReader.open("titanium_metrics_bad_test.page"));
+                
+                engine.disableMetricsExport();
+                assert(!engine.isMetricsExportEnabled() && !reader.isWriterActive());
+                reader.close();
+                tornReader.close();
+                std::remove(pagePath.c_str());
+                std::remove(tornPath.c_str());
+                std::remove("titanium_metrics_bad_test.page");
+                
+                std::cout << "✓ PASSED: Shared-memory metrics page" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Shared-memory metrics page - " << e.what() << std::endl;
+            }
+            
+            // Test 29: Per-body collision layers
+            std::cout << "\n[Test 29] Per-body collision layers..." << std::endl;
+            totalTests++;
+            try {
+                PhysicsEngine engine;
+                engine.initialize(0, 16);
+                uint32_t debris = engine.createPhysicsLayer("debris");
+                uint32_t props = engine.createPhysicsLayer("props");
+                assert(engine.setLayerInteraction(debris, debris, true));
+                assert(engine.setLayerInteraction(props, props, true));
+                
+                // Three overlapping boxes: two debris, one prop
+                engine.createRigidBody(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, debris);
+                engine.createRigidBody(0.5f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, debris);
+                engine.createRigidBody(0.25f, 0.5f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, props);
+                engine.setGravity(0.0f, 0.0f, 0.0f);
+                engine.updatePhysics(1.0f / 60.0f);
+                
+                const auto& stats = engine.getLastStepStats();
+                assert(stats.broadphasePairsTested == 3);
+                assert(stats.layerFilteredPairs == 2);
+                assert(stats.broadphasePairsEmitted == 1 && stats.narrowphaseContacts == 1);
+                
+                // Letting the layers meet brings the other pairs back
+                assert(engine.setLayerInteraction(debris, props, true));
+                engine.updatePhysics(1.0f / 60.0f);
+                assert(engine.getLastStepStats().layerFilteredPairs == 0);
+                assert(engine.getLastStepStats().narrowphaseContacts == 3);
+                
+                std::cout << "✓ PASSED: Per-body collision layers" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Per-body collision layers - " << e.what() << std::endl;
+            }
+            
+            // Test 30: Hardware performance counters
+            std::cout << "\n[Test 30] Hardware performance counters..." << std::endl;
+            totalTests++;
+            try {
+                HardwareCounters& counters = HardwareCounters::getInstance();
+                PhysicsEngine engine;
+                engine.initialize(0, 64);
+                uint32_t layer = engine.createPhysicsLayer("counted");
+                assert(engine.setLayerInteraction(layer, layer, true));
+                for (int i = 0; i < 16; i++) {
+                    engine.createRigidBody(static_cast<float>(i) * 0.8f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, layer);
+                }
+                
+                // Disabled counters leave a scope's target alone
+                HardwareCounterValues untouched;
+                { CounterScope scope(untouched); }
+                assert(untouched.cycles == 0 && untouched.instructions == 0);
+                
+                bool available = counters.setEnabled(true);
+                engine.updatePhysics(1.0f / 60.0f);
+                const auto& stats = engine.getLastStepStats();
+                if (available) {
+                    assert(HardwareCounters::isEnabled() && counters.getUnavailableReason().empty());
+                    assert(counters.getAvailableCounters() & COUNTER_CYCLES);
+                    assert(stats.broadphaseCounters.cycles > 0 && stats.gatherCounters.cycles > 0);
+                    if (counters.getAvailableCounters() & COUNTER_INSTRUCTIONS) {
+                        assert(stats.broadphaseCounters.ipc() > 0.0);
+                    }
+                    std::cout << "  broadphase IPC " << stats.broadphaseCounters.ipc() << std::endl;
+                } else {
+                    // The step runs as before, without counts
+                    assert(!HardwareCounters::isEnabled() && !counters.getUnavailableReason().empty());
+                    assert(stats.broadphaseCounters.cycles == 0 && stats.solveCounters.cycles == 0);
+                    assert(stats.narrowphaseContacts == 15);
+                    std::cout << "  unavailable: " << counters.getUnavailableReason() << std::endl;
+                }
+                counters.setEnabled(false);
+                
+                std::cout << "✓ PASSED: Hardware performance counters" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Hardware performance counters - " << e.what() << std::endl;
+            }
+            
+            // Test 31: Per-step allocation tracking
+            std::cout << "\n[Test 31] Per-step allocation tracking..." << std::endl;
+            totalTests++;
+            try {
+                AllocationTracker& tracker = AllocationTracker::getInstance();
+                PhysicsEngine engine;
+                engine.setJobSystem(std::make_shared<JobSystem>(2));
+                engine.initialize(0, 256);
+                uint32_t layer = engine.createPhysicsLayer("tracked");
+                assert(engine.setLayerInteraction(layer, layer, true));
+                engine.createRigidBody(0.0f, -0.5f, 0.0f, 40.0f, 1.0f, 40.0f, 0.0f, layer);
+                for (int i = 0; i < 128; i++) {
+                    engine.createRigidBody(static_cast<float>(i % 16) * 1.1f - 8.0f, 0.5f + static_cast<float>(i / 16),
+                                           0.0f, 1.0f, 1.0f, 1.0f, 1.0f, layer);
+                }
+                
+                // Untracked steps report nothing
+                engine.updatePhysics(1.0f / 60.0f);
+                assert(engine.getLastStepStats().allocations == 0);
+                
+                if (AllocationTracker::isAvailable()) {
+                    tracker.setEnabled(true);
+                    for (int step = 0; step < 5; step++) {
+                        engine.updatePhysics(1.0f / 60.0f);
+                    }
+                    AllocationTracker::StepReport report = tracker.getLastStep();
+                    const auto& stats = engine.getLastStepStats();
+                    assert(stats.allocations == report.total.allocations);
+                    assert(stats.allocatedBytes == report.total.bytes);
+                    
+                    uint64_t phaseSum = 0;
+                    for (size_t i = 0; i < report.phaseCount; i++) {
+                        phaseSum += report.phases[i].counts.allocations;
+                        if (report.phases[i].counts.allocations > 0) {
+                            std::cout << "  " << report.phases[i].name << ": " << report.phases[i].counts.allocations
+                                      << " allocations, " << report.phases[i].counts.bytes << " bytes" << std::endl;
+                        }
+                    }
+                    assert(phaseSum == report.total.allocations);
+                    assert(report.find("gather") && report.find("broadphase") && report.find("solve"));
+                    
+                    // Allocations outside a step are never counted: they leave no phase on the thread,
+                    // and a step tracked right after them starts from zero
+                    static int* volatile sink = nullptr;
+                    sink = new int[1000];
+                    delete[] sink;
+                    assert(AllocationTracker::getThreadPhase() < 0);
+                    {
+                        AllocationStep empty;
+                        AllocationCounts counts = empty.finish();
+                        assert(counts.allocations == 0 && counts.bytes == 0);
+                    }
+                    AllocationTracker::StepReport emptyReport = tracker.getLastStep();
+                    assert(emptyReport.step == report.step + 1 && emptyReport.total.allocations == 0);
+                    for (size_t i = 0; i < emptyReport.phaseCount; i++) {
+                        assert(emptyReport.phases[i].counts.allocations == 0);
+                    }
+                    
+                    // The check reports a step that allocates, attributed to its phase
+                    uint64_t violations = tracker.getViolationCount();
+                    tracker.setZeroAllocationCheck(ZeroAllocationCheck::REPORT);
+                    {
+                        AllocationStep forced;
+                        AllocationPhase phase("forced");
+                        sink = new int[16];
+                        delete[] sink;
+                    }
+                    assert(tracker.getViolationCount() == violations + 1);
+                    const AllocationTracker::Phase* forcedPhase = tracker.getLastStep().find("forced");
+                    assert(forcedPhase && forcedPhase->counts.allocations == 1 &&
+                           forcedPhase->counts.bytes == 16 * sizeof(int));
+                    tracker.setZeroAllocationCheck(ZeroAllocationCheck::OFF);
+                    tracker.setEnabled(false);
+                    engine.updatePhysics(1.0f / 60.0f);
+                    assert(engine.getLastStepStats().allocations == 0);
+                } else {
+                    tracker.setEnabled(true);
+                    assert(!AllocationTracker::isEnabled());
+                }
+                
+                std::cout << "✓ PASSED: Per-step allocation tracking" << std::endl;
+                passedTests++;
+            } catch (const std::exception& e) {
+                std::cout << "✗ FAILED: Per-step allocation tracking - " << e.what() << std::endl;
+            }
+            
             std::cout << "\n=== Test Summary ===" << std::endl;
             std::cout << "Total tests: " << totalTests << std::endl;
             std::cout << "Passed: " << passedTests << std::endl;
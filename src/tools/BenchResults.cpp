@@ -0,0 +1,589 @@
+#include "BenchResults.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::string jsonPercentiles(const cpu_physics::StatPercentiles& p) {
+    return "{\"min\":" + jsonNumber(p.min) + ",\"p50\":" + jsonNumber(p.p50) + ",\"p90\":" + jsonNumber(p.p90) +
+           ",\"p99\":" + jsonNumber(p.p99) + ",\"max\":" + jsonNumber(p.max) + "}";
+}
+
+// Just enough JSON to read reports back
+struct JsonValue {
+    enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* get(const std::string& key) const {
+        for (const auto& [name, value] : members) {
+            if (name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+
+    double numberOr(const std::string& key, double fallback) const {
+        const JsonValue* value = get(key);
+        return value && value->type == Type::NUMBER ? value->number : fallback;
+    }
+
+    std::string stringOr(const std::string& key, const std::string& fallback) const {
+        const JsonValue* value = get(key);
+        return value && value->type == Type::STRING ? value->string : fallback;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& source) : text(source) {}
+
+    bool parse(JsonValue& value) {
+        return parseValue(value, 0) && (skipSpace(), position == text.size());
+    }
+
+    size_t getPosition() const { return position; }
+
+private:
+    static constexpr int MAX_DEPTH = 64;
+    const std::string& text;
+    size_t position = 0;
+
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+            position++;
+        }
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (position < text.size() && text[position] == c) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    bool literal(const char* word) {
+        size_t length = std::char_traits<char>::length(word);
+        if (text.compare(position, length, word) != 0) {
+            return false;
+        }
+        position += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        skipSpace();
+        if (position >= text.size() || depth > MAX_DEPTH) {
+            return false;
+        }
+        char c = text[position];
+        if (c == '{') {
+            value.type = JsonValue::Type::OBJECT;
+            position++;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                skipSpace();
+                if (!parseString(key) || !consume(':')) {
+                    return false;
+                }
+                value.members.emplace_back(std::move(key), JsonValue{});
+                if (!parseValue(value.members.back().second, depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::ARRAY;
+            position++;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back(), depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::STRING;
+            return parseString(value.string);
+        }
+        if (literal("true")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            value.boolean = true;
+            return true;
+        }
+        if (literal("false")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            return true;
+        }
+        if (literal("null")) {
+            value.type = JsonValue::Type::NUL;
+            return true;
+        }
+        const char* begin = text.c_str() + position;
+        char* end = nullptr;
+        value.number = std::strtod(begin, &end);
+        if (end == begin) {
+            return false;
+        }
+        value.type = JsonValue::Type::NUMBER;
+        position += static_cast<size_t>(end - begin);
+        return true;
+    }
+
+    // Escapes other than \" and \\ are not written by the bench and are kept as is
+    bool parseString(std::string& output) {
+        if (position >= text.size() || text[position] != '"') {
+            return false;
+        }
+        for (position++; position < text.size(); position++) {
+            char c = text[position];
+            if (c == '"') {
+                position++;
+                return true;
+            }
+            if (c == '\\' && position + 1 < text.size()) {
+                c = text[++position];
+            }
+            output += c;
+        }
+        return false;
+    }
+};
+
+cpu_physics::StatPercentiles readPercentiles(const JsonValue* value) {
+    cpu_physics::StatPercentiles p;
+    if (value) {
+        p.min = value->numberOr("min", 0.0);
+        p.p50 = value->numberOr("p50", 0.0);
+        p.p90 = value->numberOr("p90", 0.0);
+        p.p99 = value->numberOr("p99", 0.0);
+        p.max = value->numberOr("max", 0.0);
+    }
+    return p;
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+struct MetricComparison {
+    std::string metric;
+    double baselineMs = 0.0; // medians over the repetitions
+    double currentMs = 0.0;
+    double change = 0.0;     // relative
+    double pSlower = 1.0;    // NaN when there are too few repetitions to test
+    double pFaster = 1.0;
+    const char* verdict = "";
+    bool regression = false;
+    bool improvement = false;
+};
+
+// With fewer, even fully separated samples cannot reach p < 0.05 (3 against 3 gives 0.05)
+constexpr size_t MIN_REPETITIONS_FOR_TEST = 4;
+
+} // namespace
+
+const double* RepetitionResult::find(const std::string& name) const {
+    for (const auto& [metric, value] : metrics) {
+        if (metric == name) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+std::string toJson(const BenchReport& report) {
+    std::ostringstream json;
+    json << "{\n  \"engine\": \"titanium-gpu-physics\",\n  \"version\": " << jsonString(report.version) << ",\n";
+    json << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+    json << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+    json << "  \"steps\": " << report.steps << ",\n  \"warmupSteps\": " << report.warmupSteps << ",\n";
+    json << "  \"timestep\": " << jsonNumber(report.timestep) << ",\n";
+    json << "  \"repetitions\": " << report.repetitions << ",\n  \"results\": [";
+    for (size_t i = 0; i < report.results.size(); i++) {
+        const RunResult& r = report.results[i];
+        json << (i > 0 ? "," : "") << "\n    {\"scenario\": " << jsonString(r.scenario) << ", \"bodies\": " << r.bodies
+             << ", \"threads\": " << r.threads;
+        if (r.skipped) {
+            json << ", \"skipped\": " << jsonString(r.skipReason) << "}";
+            continue;
+        }
+        json << ", \"steps\": " << r.steps << ", \"truncated\": " << (r.truncated ? "true" : "false");
+        json << ", \"stepsPerSecond\": " << jsonNumber(r.stepsPerSecond);
+        json << ", \"stepMs\": " << jsonPercentiles(r.stepMs) << ", \"meanStepMs\": " << jsonNumber(r.meanStepMs);
+        json << ", \"phasesMs\": {";
+        for (size_t p = 0; p < r.phases.size(); p++) {
+            json << (p > 0 ? ", " : "") << jsonString(r.phases[p].first) << ": " << jsonPercentiles(r.phases[p].second);
+        }
+        json << "}, \"meanContacts\": " << jsonNumber(r.meanContacts);
+        json << ", \"meanPairsTested\": " << jsonNumber(r.meanPairsTested);
+        json << ", \"memory\": {\"rssBytes\": " << r.rssBytes << ", \"rssGrowthBytes\": " << r.rssGrowthBytes << "}";
+        if (!r.counters.empty()) {
+            json << ",\n     \"counters\": {";
+            for (size_t c = 0; c < r.counters.size(); c++) {
+                const CounterSummary& counter = r.counters[c];
+                json << (c > 0 ? ", " : "") << jsonString(counter.phase) << ": {\"per\": " << jsonString(counter.per)
+                     << ", \"ipc\": " << jsonNumber(counter.ipc)
+                     << ", \"cyclesPerItem\": " << jsonNumber(counter.cyclesPerItem)
+                     << ", \"l1dMissesPerItem\": " << jsonNumber(counter.l1dMissesPerItem)
+                     << ", \"llcMissesPerItem\": " << jsonNumber(counter.llcMissesPerItem)
+                     << ", \"branchMissesPerItem\": " << jsonNumber(counter.branchMissesPerItem) << "}";
+            }
+            json << "}";
+        }
+        if (!r.allocations.empty()) {
+            json << ",\n     \"allocationsPerStep\": {";
+            for (size_t a = 0; a < r.allocations.size(); a++) {
+                json << (a > 0 ? ", " : "") << jsonString(r.allocations[a].phase) << ": {\"allocations\": "
+                     << jsonNumber(r.allocations[a].allocationsPerStep) << ", \"bytes\": "
+                     << jsonNumber(r.allocations[a].bytesPerStep) << "}";
+            }
+            json << "}";
+        }
+        json << ",\n     \"repetitions\": [";
+        for (size_t k = 0; k < r.repetitions.size(); k++) {
+            const RepetitionResult& repetition = r.repetitions[k];
+            json << (k > 0 ? "," : "") << "\n      {\"stepsPerSecond\": " << jsonNumber(repetition.stepsPerSecond)
+                 << ", \"metrics\": {";
+            for (size_t m = 0; m < repetition.metrics.size(); m++) {
+                json << (m > 0 ? ", " : "") << jsonString(repetition.metrics[m].first) << ": "
+                     << jsonNumber(repetition.metrics[m].second);
+            }
+            json << "}}";
+        }
+        json << "]}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+bool loadReport(const std::string& path, BenchReport& report, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.parse(root) || root.type != JsonValue::Type::OBJECT) {
+        error = path + " is not valid JSON (near byte " + std::to_string(parser.getPosition()) + ")";
+        return false;
+    }
+    const JsonValue* results = root.get("results");
+    if (root.stringOr("engine", "") != "titanium-gpu-physics" || !results ||
+        results->type != JsonValue::Type::ARRAY) {
+        error = path + " is not a titanium-bench report";
+        return false;
+    }
+
+    report = BenchReport{};
+    report.version = root.stringOr("version", "unknown");
+    report.steps = static_cast<uint32_t>(root.numberOr("steps", 0.0));
+    report.warmupSteps = static_cast<uint32_t>(root.numberOr("warmupSteps", 0.0));
+    report.timestep = static_cast<float>(root.numberOr("timestep", 1.0 / 60.0));
+    report.repetitions = static_cast<uint32_t>(root.numberOr("repetitions", 1.0));
+
+    for (const JsonValue& item : results->items) {
+        RunResult run;
+        run.scenario = item.stringOr("scenario", "");
+        run.bodies = static_cast<uint32_t>(item.numberOr("bodies", 0.0));
+        run.threads = static_cast<uint32_t>(item.numberOr("threads", 0.0));
+        if (const JsonValue* skipped = item.get("skipped")) {
+            run.skipped = true;
+            run.skipReason = skipped->string;
+        }
+        run.steps = static_cast<uint32_t>(item.numberOr("steps", 0.0));
+        const JsonValue* truncated = item.get("truncated");
+        run.truncated = truncated && truncated->boolean;
+        run.stepsPerSecond = item.numberOr("stepsPerSecond", 0.0);
+        run.stepMs = readPercentiles(item.get("stepMs"));
+        run.meanStepMs = item.numberOr("meanStepMs", 0.0);
+        if (const JsonValue* phases = item.get("phasesMs")) {
+            for (const auto& [name, value] : phases->members) {
+                run.phases.emplace_back(name, readPercentiles(&value));
+            }
+        }
+        run.meanContacts = item.numberOr("meanContacts", 0.0);
+        run.meanPairsTested = item.numberOr("meanPairsTested", 0.0);
+        if (const JsonValue* counters = item.get("counters")) {
+            for (const auto& [phase, value] : counters->members) {
+                CounterSummary counter;
+                counter.phase = phase;
+                counter.per = value.stringOr("per", "");
+                counter.ipc = value.numberOr("ipc", 0.0);
+                counter.cyclesPerItem = value.numberOr("cyclesPerItem", 0.0);
+                counter.l1dMissesPerItem = value.numberOr("l1dMissesPerItem", 0.0);
+                counter.llcMissesPerItem = value.numberOr("llcMissesPerItem", 0.0);
+                counter.branchMissesPerItem = value.numberOr("branchMissesPerItem", 0.0);
+                run.counters.push_back(std::move(counter));
+            }
+        }
+        if (const JsonValue* allocations = item.get("allocationsPerStep")) {
+            for (const auto& [phase, value] : allocations->members) {
+                run.allocations.push_back({phase, value.numberOr("allocations", 0.0), value.numberOr("bytes", 0.0)});
+            }
+        }
+        if (const JsonValue* repetitions = item.get("repetitions")) {
+            for (const JsonValue& entry : repetitions->items) {
+                RepetitionResult repetition;
+                repetition.stepsPerSecond = entry.numberOr("stepsPerSecond", 0.0);
+                if (const JsonValue* metrics = entry.get("metrics")) {
+                    for (const auto& [name, value] : metrics->members) {
+                        if (value.type == JsonValue::Type::NUMBER) {
+                            repetition.metrics.emplace_back(name, value.number);
+                        }
+                    }
+                }
+                run.repetitions.push_back(std::move(repetition));
+            }
+        }
+        if (run.scenario.empty() || run.bodies == 0 || run.threads == 0) {
+            error = path + " has a result without scenario, bodies or threads";
+            return false;
+        }
+        report.results.push_back(std::move(run));
+    }
+    return true;
+}
+
+double mannWhitneyGreater(const std::vector<double>& current, const std::vector<double>& baseline) {
+    size_t n = current.size();
+    size_t m = baseline.size();
+    if (n == 0 || m == 0) {
+        return 1.0;
+    }
+
+    double u = 0.0;
+    bool ties = false;
+    for (double c : current) {
+        for (double b : baseline) {
+            if (c > b) {
+                u += 1.0;
+            } else if (c == b) {
+                u += 0.5;
+                ties = true;
+            }
+        }
+    }
+
+    if (!ties && n + m <= 50) {
+        // U counts follow the coefficients of the Gaussian binomial [n+m choose n](q):
+        // the product over i of (1 - q^(m+i)) / (1 - q^i)
+        size_t maxU = n * m;
+        std::vector<double> counts(maxU + 1, 0.0);
+        counts[0] = 1.0;
+        for (size_t i = 1; i <= n; i++) {
+            for (size_t k = maxU; k >= m + i; k--) {
+                counts[k] -= counts[k - m - i];
+            }
+            for (size_t k = i; k <= maxU; k++) {
+                counts[k] += counts[k - i];
+            }
+        }
+        double total = 0.0;
+        double tail = 0.0;
+        for (size_t k = 0; k <= maxU; k++) {
+            total += counts[k];
+            if (static_cast<double>(k) >= u) {
+                tail += counts[k];
+            }
+        }
+        return tail / total;
+    }
+
+    // Normal approximation with continuity and tie corrections
+    std::vector<double> pooled(current);
+    pooled.insert(pooled.end(), baseline.begin(), baseline.end());
+    std::sort(pooled.begin(), pooled.end());
+    double tieTerm = 0.0;
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j] == pooled[i]) {
+            j++;
+        }
+        double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+    double total = static_cast<double>(n + m);
+    double mean = static_cast<double>(n * m) / 2.0;
+    double variance = static_cast<double>(n * m) / 12.0 * ((total + 1.0) - tieTerm / (total * (total - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+size_t compareReports(const BenchReport& baseline, const BenchReport& current, const CompareOptions& options,
+                      std::ostream& output) {
+    char line[192];
+    size_t regressions = 0;
+    size_t regressedRuns = 0;
+    size_t comparedRuns = 0;
+    bool untested = false;
+
+    std::snprintf(line, sizeof(line), "Baseline %s, %u repetitions; current %s, %u repetitions; alpha %.3g, threshold %.1f%%\n",
+                  baseline.version.c_str(), baseline.repetitions, current.version.c_str(), current.repetitions,
+                  options.alpha, options.threshold * 100.0);
+    output << line;
+
+    for (const RunResult& base : baseline.results) {
+        if (base.skipped) {
+            continue;
+        }
+        auto found = std::find_if(current.results.begin(), current.results.end(),
+                                  [&](const RunResult& run) { return run.sameRun(base); });
+        std::snprintf(line, sizeof(line), "\n%s  %u bodies  %u thread%s", base.scenario.c_str(), base.bodies,
+                      base.threads, base.threads == 1 ? "" : "s");
+        output << line;
+        if (found == current.results.end() || found->skipped) {
+            output << "  -- not run: " << (found == current.results.end() ? "missing" : found->skipReason) << "\n";
+            continue;
+        }
+        comparedRuns++;
+        output << "\n";
+        if (base.repetitions.empty() || found->repetitions.empty()) {
+            output << "  no per-repetition metrics to compare\n";
+            continue;
+        }
+
+        // Metrics present in both, in the baseline's order
+        std::vector<MetricComparison> rows;
+        bool testable = base.repetitions.size() >= MIN_REPETITIONS_FOR_TEST &&
+                        found->repetitions.size() >= MIN_REPETITIONS_FOR_TEST;
+        untested |= !testable;
+        for (const auto& [metric, unused] : base.repetitions.front().metrics) {
+            std::vector<double> before;
+            std::vector<double> after;
+            for (const RepetitionResult& repetition : base.repetitions) {
+                if (const double* value = repetition.find(metric)) {
+                    before.push_back(*value);
+                }
+            }
+            for (const RepetitionResult& repetition : found->repetitions) {
+                if (const double* value = repetition.find(metric)) {
+                    after.push_back(*value);
+                }
+            }
+            if (before.empty() || after.empty()) {
+                continue;
+            }
+
+            MetricComparison row;
+            row.metric = metric;
+            row.baselineMs = median(before);
+            row.currentMs = median(after);
+            double delta = row.currentMs - row.baselineMs;
+            row.change = row.baselineMs > 0.0 ? delta / row.baselineMs : (delta > 0.0 ? INFINITY : 0.0);
+            if (testable) {
+                row.pSlower = mannWhitneyGreater(after, before);
+                row.pFaster = mannWhitneyGreater(before, after);
+            } else {
+                row.pSlower = row.pFaster = NAN;
+            }
+            bool large = std::fabs(delta) >= options.minDeltaMs && std::fabs(row.change) >= options.threshold;
+            bool slower = testable ? row.pSlower < options.alpha : delta > 0.0;
+            bool faster = testable ? row.pFaster < options.alpha : delta < 0.0;
+            row.regression = large && delta > 0.0 && slower;
+            row.improvement = large && delta < 0.0 && faster;
+            row.verdict = row.regression ? "REGRESSION" : row.improvement ? "improved" : "";
+            rows.push_back(row);
+        }
+
+        // The step rows always, then changed metrics by how much time they account for
+        std::stable_sort(rows.begin(), rows.end(), [](const MetricComparison& a, const MetricComparison& b) {
+            bool stepA = a.metric.rfind("step.", 0) == 0;
+            bool stepB = b.metric.rfind("step.", 0) == 0;
+            if (stepA || stepB) {
+                return stepA && !stepB;
+            }
+            return std::fabs(a.currentMs - a.baselineMs) > std::fabs(b.currentMs - b.baselineMs);
+        });
+
+        std::snprintf(line, sizeof(line), "  %-38s %12s %12s %9s %9s  %s\n", "metric", "baseline ms", "current ms",
+                      "change", "p-value", "verdict");
+        output << line;
+        size_t runRegressions = 0;
+        for (const MetricComparison& row : rows) {
+            bool step = row.metric.rfind("step.", 0) == 0;
+            if (!step && !options.allMetrics && !row.regression && !row.improvement) {
+                continue;
+            }
+            double p = row.currentMs >= row.baselineMs ? row.pSlower : row.pFaster;
+            char pText[16];
+            if (std::isnan(p)) {
+                std::snprintf(pText, sizeof(pText), "-");
+            } else {
+                std::snprintf(pText, sizeof(pText), "%.4f", p);
+            }
+            std::snprintf(line, sizeof(line), "  %-38s %12.4f %12.4f %+8.1f%% %9s  %s\n", row.metric.c_str(),
+                          row.baselineMs, row.currentMs, row.change * 100.0, pText, row.verdict);
+            output << line;
+            runRegressions += row.regression ? 1 : 0;
+        }
+        regressions += runRegressions;
+        regressedRuns += runRegressions > 0 ? 1 : 0;
+    }
+
+    if (untested) {
+        std::snprintf(line, sizeof(line), "\nFewer than %zu repetitions on a side: changes were judged by the threshold alone\n",
+                      MIN_REPETITIONS_FOR_TEST);
+        output << line;
+    }
+    std::snprintf(line, sizeof(line), "\n%zu regressed metric%s in %zu of %zu runs\n", regressions,
+                  regressions == 1 ? "" : "s", regressedRuns, comparedRuns);
+    output << line;
+    return regressions;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "PhysicsEngine/CPUPhysicsEngine/systems/PhysicsStepStats.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Results of titanium-bench runs, their JSON form and the baseline comparison
+
+// One rebuild-and-run of a scene. Metrics are milliseconds per step, keyed as
+// "step.p50", "step.mean", "phase.<step stats phase>" and "scope.<profiler scope>"
+struct RepetitionResult {
+    double stepsPerSecond = 0.0;
+    std::vector<std::pair<std::string, double>> metrics;
+
+    const double* find(const std::string& name) const;
+};
+
+// Hardware counters of one phase over the measured steps, per item the phase processed
+struct CounterSummary {
+    std::string phase;
+    std::string per; // "body" or "pair"
+    double ipc = 0.0;
+    double cyclesPerItem = 0.0;
+    double l1dMissesPerItem = 0.0;
+    double llcMissesPerItem = 0.0;
+    double branchMissesPerItem = 0.0;
+};
+
+// Heap allocations of one phase (or "total"), averaged over the measured steps
+struct AllocationSummary {
+    std::string phase;
+    double allocationsPerStep = 0.0;
+    double bytesPerStep = 0.0;
+};
+
+struct RunResult {
+    std::string scenario;
+    uint32_t bodies = 0;
+    uint32_t threads = 0;
+    bool skipped = false;
+    std::string skipReason;
+
+    // Pooled over the repetitions
+    uint32_t steps = 0;
+    bool truncated = false; // a repetition stopped at --max-seconds
+    double stepsPerSecond = 0.0;
+    cpu_physics::StatPercentiles stepMs;
+    double meanStepMs = 0.0;
+    std::vector<std::pair<std::string, cpu_physics::StatPercentiles>> phases;
+    double meanContacts = 0.0;
+    double meanPairsTested = 0.0;
+    uint64_t rssBytes = 0;
+    uint64_t rssGrowthBytes = 0;
+    std::vector<CounterSummary> counters; // empty unless --counters found them readable
+    std::vector<AllocationSummary> allocations; // empty unless --allocations
+
+    std::vector<RepetitionResult> repetitions;
+
+    bool sameRun(const RunResult& other) const {
+        return scenario == other.scenario && bodies == other.bodies && threads == other.threads;
+    }
+};
+
+struct BenchReport {
+    std::string version;
+    uint32_t steps = 0;
+    uint32_t warmupSteps = 0;
+    float timestep = 0.0f;
+    uint32_t repetitions = 1;
+    std::vector<RunResult> results;
+};
+
+std::string toJson(const BenchReport& report);
+// False with a message if the file is missing or not a titanium-bench report
+bool loadReport(const std::string& path, BenchReport& report, std::string& error);
+
+// One-sided Mann-Whitney U test: the probability of current being at least this much
+// larger than baseline if both came from the same distribution. Exact for small samples
+// without ties, normal approximation with tie correction otherwise.
+double mannWhitneyGreater(const std::vector<double>& current, const std::vector<double>& baseline);
+
+struct CompareOptions {
+    double alpha = 0.05;      // significance level of the one-sided tests
+    double threshold = 0.05;  // relative change of the medians worth reporting
+    double minDeltaMs = 0.02; // absolute change below which a metric is noise
+    bool allMetrics = false;  // list every metric, not only the changed ones
+};
+
+// Prints a diff table per run and returns the number of regressed metrics
+size_t compareReports(const BenchReport& baseline, const BenchReport& current, const CompareOptions& options,
+                      std::ostream& output);
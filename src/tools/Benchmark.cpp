@@ -0,0 +1,799 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "PhysicsEngine/PhysicsEngine.h"
+#include "PhysicsEngine/CPUPhysicsEngine/CPUPhysicsEngine.h"
+#include "PhysicsEngine/managers/jobmanager/JobSystem.h"
+#include "PhysicsEngine/managers/logmanager/Logger.h"
+#include "PhysicsEngine/managers/profilemanager/AllocationTracker.h"
+#include "PhysicsEngine/managers/profilemanager/HardwareCounters.h"
+#include "PhysicsEngine/managers/profilemanager/Profiler.h"
+#include "BenchResults.h"
+#ifdef VULKAN_AVAILABLE
+#include "PhysicsEngine/GPUPhysicsEngine/managers/vulkanmanager/VulkanManager.h"
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifndef TITANIUM_VERSION
+#define TITANIUM_VERSION "unknown"
+#endif
+
+// titanium-bench: deterministic scene benchmarks swept over body and thread counts, written as JSON
+// and optionally compared against a stored baseline
+
+namespace {
+
+using cpu_physics::PhysicsStepStats;
+using cpu_physics::PhysicsStatsHistory;
+
+// Same sequence on every platform and standard library (std:: distributions are not)
+class BenchRandom {
+public:
+    explicit BenchRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [low, high)
+    float range(float low, float high) {
+        return low + (high - low) * static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint64_t state;
+};
+
+struct BenchConfig {
+    std::vector<std::string> scenarios;
+    std::vector<uint32_t> bodyCounts{1000, 2000, 4000};
+    std::vector<uint32_t> threadCounts;
+    uint32_t steps = 200;
+    uint32_t warmupSteps = 20;
+    float timestep = 1.0f / 60.0f;
+    double maxSeconds = 30.0; // per repetition; a run stops early rather than stall the sweep
+    uint32_t repetitions = 1; // engines rebuilt per run; significance tests need at least 4
+    bool profileScopes = true;
+    bool hardwareCounters = false;
+    bool allocations = false;
+    std::string outputPath = "titanium_bench_results.json";
+    std::string baselinePath;
+    CompareOptions compare;
+};
+
+// A scene built into an engine, with the work it does between steps
+struct Scene {
+    uint32_t layer = 0; // colliding layer for the scene's bodies
+    std::function<void(PhysicsEngine&, BenchRandom&)> beforeStep; // may be empty
+    size_t particles = 0;
+
+    uint32_t box(PhysicsEngine& engine, float x, float y, float z, float width, float height, float depth,
+                 float mass = 1.0f) const {
+        return engine.createRigidBody(x, y, z, width, height, depth, mass, layer);
+    }
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    bool particles; // GPU scenario: swept over counts but not threads
+    std::function<bool(PhysicsEngine&, uint32_t, BenchRandom&, Scene&)> build;
+};
+
+uint32_t createGround(PhysicsEngine& engine, float halfSize, uint32_t layer) {
+    return engine.createRigidBody(0.0f, -0.5f, 0.0f, halfSize * 2.0f, 1.0f, halfSize * 2.0f, 0.0f, layer);
+}
+
+// Square-ish grid side for count cells
+uint32_t gridSide(uint32_t count) {
+    return std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count)))));
+}
+
+// Pyramids of resting boxes, ten wide at the base
+bool buildPyramids(PhysicsEngine& engine, uint32_t bodies, BenchRandom&, Scene& scene) {
+    const uint32_t base = 10;
+    const uint32_t perPyramid = base * (base + 1) / 2;
+    uint32_t pyramids = (bodies + perPyramid - 1) / perPyramid;
+    uint32_t side = gridSide(pyramids);
+    const float spacing = static_cast<float>(base) + 4.0f;
+    createGround(engine, static_cast<float>(side) * spacing * 0.5f + spacing, scene.layer);
+
+    uint32_t created = 0;
+    for (uint32_t p = 0; p < pyramids && created < bodies; p++) {
+        float originX = (static_cast<float>(p % side) - static_cast<float>(side - 1) * 0.5f) * spacing;
+        float originZ = (static_cast<float>(p / side) - static_cast<float>(side - 1) * 0.5f) * spacing;
+        for (uint32_t level = 0; level < base && created < bodies; level++) {
+            uint32_t row = base - level;
+            for (uint32_t i = 0; i < row && created < bodies; i++, created++) {
+                float x = originX + static_cast<float>(i) - static_cast<float>(row - 1) * 0.5f;
+                scene.box(engine, x, 0.5f + static_cast<float>(level), originZ, 1.0f, 1.0f, 1.0f);
+            }
+        }
+    }
+    return true;
+}
+
+// Boxes dropped in a dense column onto the ground
+bool buildRain(PhysicsEngine& engine, uint32_t bodies, BenchRandom& random, Scene& scene) {
+    uint32_t side = gridSide(bodies / 8 + 1);
+    float halfSize = static_cast<float>(side) * 0.75f + 2.0f;
+    createGround(engine, halfSize, scene.layer);
+    for (uint32_t i = 0; i < bodies; i++) {
+        uint32_t cell = i % (side * side);
+        float x = (static_cast<float>(cell % side) - static_cast<float>(side) * 0.5f) * 1.5f + random.range(-0.2f, 0.2f);
+        float z = (static_cast<float>(cell / side) - static_cast<float>(side) * 0.5f) * 1.5f + random.range(-0.2f, 0.2f);
+        float y = 2.0f + static_cast<float>(i / (side * side)) * 1.5f + random.range(0.0f, 0.5f);
+        scene.box(engine, x, y, z, 1.0f, 1.0f, 1.0f, random.range(0.5f, 2.0f));
+    }
+    return true;
+}
+
+// A static city block grid with a tenth of the bodies driving through the streets
+bool buildCity(PhysicsEngine& engine, uint32_t bodies, BenchRandom& random, Scene& scene) {
+    uint32_t buildings = bodies - bodies / 10;
+    uint32_t vehicles = bodies - buildings;
+    uint32_t side = gridSide(buildings);
+    const float spacing = 6.0f;
+    float halfSize = static_cast<float>(side) * spacing * 0.5f + spacing;
+    createGround(engine, halfSize, scene.layer);
+
+    for (uint32_t i = 0; i < buildings; i++) {
+        float x = (static_cast<float>(i % side) - static_cast<float>(side - 1) * 0.5f) * spacing;
+        float z = (static_cast<float>(i / side) - static_cast<float>(side - 1) * 0.5f) * spacing;
+        float height = random.range(3.0f, 20.0f);
+        scene.box(engine, x, height * 0.5f, z, 3.0f, height, 3.0f, 0.0f);
+    }
+
+    // Streets run between the building rows along x
+    auto ecs = engine.getCPUPhysics()->getECSManager();
+    for (uint32_t i = 0; i < vehicles; i++) {
+        float street = (static_cast<float>(i % side) - static_cast<float>(side - 1) * 0.5f) * spacing + spacing * 0.5f;
+        float x = random.range(-halfSize + 2.0f, halfSize - 2.0f);
+        uint32_t body = scene.box(engine, x, 0.5f, street, 1.0f, 1.0f, 1.0f);
+        if (auto* physics = ecs->getPhysicsComponent(body)) {
+            physics->velocity[0] = random.range(-8.0f, 8.0f);
+        }
+    }
+    return true;
+}
+
+// Eight interleaved layers that only collide with themselves and the ground, so most
+// overlapping pairs are rejected by the layer rules
+bool buildLayers(PhysicsEngine& engine, uint32_t bodies, BenchRandom& random, Scene&) {
+    const uint32_t layerCount = 8;
+    uint32_t groundLayer = engine.createPhysicsLayer("bench-ground");
+    std::vector<uint32_t> layers;
+    for (uint32_t i = 0; i < layerCount; i++) {
+        layers.push_back(engine.createPhysicsLayer("bench-layer-" + std::to_string(i)));
+        engine.setLayerInteraction(layers.back(), layers.back(), true);
+        engine.setLayerInteraction(layers.back(), groundLayer, true);
+    }
+
+    uint32_t side = gridSide(bodies / 4 + 1);
+    createGround(engine, static_cast<float>(side) * 0.5f + 2.0f, groundLayer);
+    for (uint32_t i = 0; i < bodies; i++) {
+        uint32_t cell = i % (side * side);
+        float x = (static_cast<float>(cell % side) - static_cast<float>(side) * 0.5f) * 0.9f;
+        float z = (static_cast<float>(cell / side) - static_cast<float>(side) * 0.5f) * 0.9f;
+        float y = 0.5f + static_cast<float>(i / (side * side)) * 0.9f + random.range(0.0f, 0.1f);
+        engine.createRigidBody(x, y, z, 1.0f, 1.0f, 1.0f, 1.0f, layers[i % layerCount]);
+    }
+    return true;
+}
+
+// Rain where one percent of the bodies are removed and respawned above the pile every step
+bool buildChurn(PhysicsEngine& engine, uint32_t bodies, BenchRandom& random, Scene& scene) {
+    uint32_t side = gridSide(bodies / 8 + 1);
+    float halfSize = static_cast<float>(side) * 0.75f + 2.0f;
+    createGround(engine, halfSize, scene.layer);
+
+    auto live = std::make_shared<std::vector<uint32_t>>();
+    auto spawn = [side, live, layer = scene.layer](PhysicsEngine& target, BenchRandom& rng, float y) {
+        float x = (rng.range(0.0f, 1.0f) - 0.5f) * static_cast<float>(side) * 1.5f;
+        float z = (rng.range(0.0f, 1.0f) - 0.5f) * static_cast<float>(side) * 1.5f;
+        uint32_t body = target.createRigidBody(x, y, z, 1.0f, 1.0f, 1.0f, 1.0f, layer);
+        if (body != 0) {
+            live->push_back(body);
+        }
+    };
+    for (uint32_t i = 0; i < bodies; i++) {
+        spawn(engine, random, 2.0f + static_cast<float>(i / (side * side)) * 1.5f);
+    }
+
+    uint32_t perStep = std::max<uint32_t>(1, bodies / 100);
+    auto next = std::make_shared<size_t>(0);
+    scene.beforeStep = [live, next, perStep, spawn](PhysicsEngine& target, BenchRandom& rng) {
+        for (uint32_t i = 0; i < perStep && !live->empty(); i++) {
+            size_t slot = *next % live->size();
+            target.removeRigidBody((*live)[slot]);
+            (*live)[slot] = live->back();
+            live->pop_back();
+            (*next)++;
+        }
+        for (uint32_t i = 0; i < perStep; i++) {
+            spawn(target, rng, 30.0f);
+        }
+    };
+    return true;
+}
+
+// GPU particle cloud; needs Vulkan
+bool buildParticles(PhysicsEngine& engine, uint32_t count, BenchRandom& random, Scene& scene) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (!engine.addParticle(random.range(-20.0f, 20.0f), random.range(0.0f, 40.0f), random.range(-20.0f, 20.0f),
+                                random.range(-1.0f, 1.0f), 0.0f, random.range(-1.0f, 1.0f))) {
+            return false;
+        }
+    }
+    scene.particles = count;
+    return true;
+}
+
+const std::vector<Scenario>& allScenarios() {
+    static const std::vector<Scenario> scenarios = {
+        {"pyramid", "pyramids of resting boxes", false, buildPyramids},
+        {"rain", "dense rain of boxes onto the ground", false, buildRain},
+        {"city", "static city with sparse moving bodies", false, buildCity},
+        {"layers", "interleaved bodies in eight non-interacting layers", false, buildLayers},
+        {"churn", "rain with 1% of the bodies respawned every step", false, buildChurn},
+        {"particles", "GPU particle cloud", true, buildParticles},
+    };
+    return scenarios;
+}
+
+// Resident set size of the process, 0 where it cannot be read
+uint64_t residentBytes() {
+#ifdef _WIN32
+    return 0;
+#else
+    std::ifstream statm("/proc/self/statm");
+    uint64_t pages = 0;
+    uint64_t resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Phases of PhysicsStepStats reported per run and compared per repetition
+struct Phase {
+    const char* name;
+    float PhysicsStepStats::*field;
+};
+
+constexpr Phase PHASES[] = {
+    {"gather", &PhysicsStepStats::gatherMs},
+    {"integrate", &PhysicsStepStats::integrateMs},
+    {"continuous", &PhysicsStepStats::continuousMs},
+    {"collisionDetection", &PhysicsStepStats::collisionDetectionMs},
+    {"broadphase", &PhysicsStepStats::broadphaseMs},
+    {"narrowphase", &PhysicsStepStats::narrowphaseMs},
+    {"solve", &PhysicsStepStats::solveMs},
+    {"writeBack", &PhysicsStepStats::writeBackMs},
+    {"sleep", &PhysicsStepStats::sleepMs},
+    {"systems", &PhysicsStepStats::systemsMs},
+    {"legacySync", &PhysicsStepStats::legacySyncMs},
+    {"gpuDispatch", &PhysicsStepStats::gpuDispatchMs},
+};
+
+// Phases with hardware counters and the items their counts are divided by
+struct CounterPhase {
+    const char* name;
+    HardwareCounterValues PhysicsStepStats::*counters;
+    const char* per;
+    double (*items)(const PhysicsStepStats&);
+};
+
+double bodiesInStep(const PhysicsStepStats& s) {
+    return static_cast<double>(s.awakeBodies) + s.sleepingBodies + s.staticBodies;
+}
+
+const CounterPhase COUNTER_PHASES[] = {
+    {"gather", &PhysicsStepStats::gatherCounters, "body", bodiesInStep},
+    {"integrate", &PhysicsStepStats::integrateCounters, "body", bodiesInStep},
+    {"broadphase", &PhysicsStepStats::broadphaseCounters, "pair",
+     [](const PhysicsStepStats& s) { return static_cast<double>(s.broadphasePairsTested); }},
+    {"narrowphase", &PhysicsStepStats::narrowphaseCounters, "pair",
+     [](const PhysicsStepStats& s) { return static_cast<double>(s.broadphasePairsEmitted); }},
+    {"solve", &PhysicsStepStats::solveCounters, "body", bodiesInStep},
+    {"writeBack", &PhysicsStepStats::writeBackCounters, "body", bodiesInStep},
+    {"systems", &PhysicsStepStats::systemsCounters, "body", bodiesInStep},
+};
+
+// Counter totals of every phase over the window, divided by the items the phase processed
+std::vector<CounterSummary> summarizeCounters(const PhysicsStatsHistory& history) {
+    std::vector<CounterSummary> summaries;
+    for (const CounterPhase& phase : COUNTER_PHASES) {
+        HardwareCounterValues total;
+        double items = 0.0;
+        for (size_t i = 0; i < history.size(); i++) {
+            total += history.at(i).*phase.counters;
+            items += phase.items(history.at(i));
+        }
+        if (total.cycles == 0) {
+            continue; // the phase did not run
+        }
+        CounterSummary summary;
+        summary.phase = phase.name;
+        summary.per = phase.per;
+        summary.ipc = total.ipc();
+        double perItem = items > 0.0 ? 1.0 / items : 0.0;
+        summary.cyclesPerItem = static_cast<double>(total.cycles) * perItem;
+        summary.l1dMissesPerItem = static_cast<double>(total.l1dMisses) * perItem;
+        summary.llcMissesPerItem = static_cast<double>(total.llcMisses) * perItem;
+        summary.branchMissesPerItem = static_cast<double>(total.branchMisses) * perItem;
+        summaries.push_back(std::move(summary));
+    }
+    return summaries;
+}
+
+// Profiler events are drained this often, outside the timed region, so the
+// per-thread buffers never fill up during a run
+constexpr uint32_t PROFILE_DRAIN_STEPS = 32;
+
+// Adds the total time of every scope in the tree to its name's entry
+void sumScopes(const ProfileNode& node, std::vector<std::pair<std::string, double>>& totals) {
+    for (const ProfileNode& child : node.children) {
+        auto entry = std::find_if(totals.begin(), totals.end(), [&](const auto& t) { return t.first == child.name; });
+        if (entry == totals.end()) {
+            totals.emplace_back(child.name, child.totalMs);
+        } else {
+            entry->second += child.totalMs;
+        }
+        sumScopes(child, totals);
+    }
+}
+
+// Adds a step's allocations to the run's totals per phase, "total" first
+void addAllocations(const AllocationTracker::StepReport& step, std::vector<AllocationSummary>& totals) {
+    auto add = [&totals](const char* phase, const AllocationCounts& counts) {
+        auto entry = std::find_if(totals.begin(), totals.end(), [&](const auto& t) { return t.phase == phase; });
+        if (entry == totals.end()) {
+            totals.push_back({phase, 0.0, 0.0});
+            entry = totals.end() - 1;
+        }
+        entry->allocationsPerStep += static_cast<double>(counts.allocations);
+        entry->bytesPerStep += static_cast<double>(counts.bytes);
+    };
+    add("total", step.total);
+    for (size_t i = 0; i < step.phaseCount; i++) {
+        add(step.phases[i].name, step.phases[i].counts);
+    }
+}
+
+// One repetition on a freshly built engine; its steps are added to the pooled history
+bool runRepetition(const Scenario& scenario, uint32_t bodies, uint32_t threads, const BenchConfig& config,
+                   RunResult& result, PhysicsStatsHistory& pooled, double& seconds, double& contacts, double& pairs) {
+    BenchRandom random(0x7469746eull ^ (static_cast<uint64_t>(bodies) << 8));
+    Scene scene;
+
+    PhysicsEngine engine;
+    // One thread means no workers: the stepping thread runs every job itself
+    engine.setJobSystem(threads > 1 ? std::make_shared<JobSystem>(threads - 1)
+                                    : std::make_shared<JobSystem>(0, [](std::function<void()>) {}));
+    if (!engine.initialize(scenario.particles ? bodies : 0, scenario.particles ? 16 : bodies + 16)) {
+        result.skipReason = "engine failed to initialize";
+        return false;
+    }
+    // Bodies collide only on registered layers that are set to interact
+    scene.layer = engine.createPhysicsLayer("bench");
+    engine.setLayerInteraction(scene.layer, scene.layer, true);
+    if (!scenario.build(engine, bodies, random, scene)) {
+        result.skipReason = scenario.particles ? "GPU physics not available" : "scene failed to build";
+        return false;
+    }
+
+    for (uint32_t step = 0; step < config.warmupSteps; step++) {
+        if (scene.beforeStep) {
+            scene.beforeStep(engine, random);
+        }
+        engine.updatePhysics(config.timestep);
+    }
+
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+    profiler.setEnabled(config.profileScopes);
+
+    RepetitionResult repetition;
+    std::vector<double> stepMs;
+    std::vector<double> phaseMs(std::size(PHASES), 0.0);
+    std::vector<std::pair<std::string, double>> scopeMs;
+    double elapsed = 0.0;
+    uint32_t steps = 0;
+    for (; steps < config.steps; steps++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        if (scene.beforeStep) {
+            scene.beforeStep(engine, random);
+        }
+        engine.updatePhysics(config.timestep);
+        elapsed += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        const PhysicsStepStats& stats = engine.getLastStepStats();
+        pooled.push(stats);
+        stepMs.push_back(stats.totalMs);
+        for (size_t p = 0; p < std::size(PHASES); p++) {
+            phaseMs[p] += stats.*PHASES[p].field;
+        }
+        contacts += stats.narrowphaseContacts;
+        pairs += static_cast<double>(stats.broadphasePairsTested);
+        if (AllocationTracker::isEnabled()) {
+            addAllocations(AllocationTracker::getInstance().getLastStep(), result.allocations);
+        }
+
+        if (config.profileScopes && (steps + 1) % PROFILE_DRAIN_STEPS == 0) {
+            sumScopes(profiler.getAggregateTree(), scopeMs);
+            profiler.clear();
+        }
+        if (elapsed > config.maxSeconds && steps + 1 < config.steps) {
+            result.truncated = true;
+            steps++;
+            break;
+        }
+    }
+    if (config.profileScopes) {
+        sumScopes(profiler.getAggregateTree(), scopeMs);
+        profiler.setEnabled(false);
+        profiler.clear();
+    }
+    result.steps += steps;
+    seconds += elapsed;
+
+    double perStep = 1.0 / static_cast<double>(std::max(steps, 1u));
+    std::sort(stepMs.begin(), stepMs.end());
+    double stepTotal = 0.0;
+    for (double ms : stepMs) {
+        stepTotal += ms;
+    }
+    repetition.stepsPerSecond = elapsed > 0.0 ? static_cast<double>(steps) / elapsed : 0.0;
+    repetition.metrics.emplace_back("step.p50", stepMs.empty() ? 0.0 : stepMs[stepMs.size() / 2]);
+    repetition.metrics.emplace_back("step.mean", stepTotal * perStep);
+    for (size_t p = 0; p < std::size(PHASES); p++) {
+        repetition.metrics.emplace_back(std::string("phase.") + PHASES[p].name, phaseMs[p] * perStep);
+    }
+    for (const auto& [name, ms] : scopeMs) {
+        repetition.metrics.emplace_back("scope." + name, ms * perStep);
+    }
+    result.repetitions.push_back(std::move(repetition));
+    return true;
+}
+
+RunResult runScenario(const Scenario& scenario, uint32_t bodies, uint32_t threads, const BenchConfig& config) {
+    RunResult result;
+    result.scenario = scenario.name;
+    result.bodies = bodies;
+    result.threads = threads;
+
+    uint64_t rssBefore = residentBytes();
+    PhysicsStatsHistory history(static_cast<size_t>(config.steps) * config.repetitions);
+    double seconds = 0.0;
+    double contacts = 0.0;
+    double pairs = 0.0;
+    for (uint32_t r = 0; r < config.repetitions; r++) {
+        if (!runRepetition(scenario, bodies, threads, config, result, history, seconds, contacts, pairs)) {
+            result.skipped = true;
+            result.repetitions.clear();
+            return result;
+        }
+    }
+
+    result.stepsPerSecond = seconds > 0.0 ? static_cast<double>(result.steps) / seconds : 0.0;
+    result.stepMs = history.summarize(&PhysicsStepStats::totalMs);
+    for (size_t i = 0; i < history.size(); i++) {
+        result.meanStepMs += history.at(i).totalMs;
+    }
+    result.meanStepMs /= static_cast<double>(std::max<size_t>(history.size(), 1));
+    result.meanContacts = contacts / std::max(result.steps, 1u);
+    result.meanPairsTested = pairs / std::max(result.steps, 1u);
+    for (const Phase& phase : PHASES) {
+        result.phases.emplace_back(phase.name, history.summarize(phase.field));
+    }
+    if (HardwareCounters::isEnabled()) {
+        result.counters = summarizeCounters(history);
+    }
+    for (AllocationSummary& allocation : result.allocations) {
+        allocation.allocationsPerStep /= std::max(result.steps, 1u);
+        allocation.bytesPerStep /= std::max(result.steps, 1u);
+    }
+    result.rssBytes = residentBytes();
+    result.rssGrowthBytes = result.rssBytes > rssBefore ? result.rssBytes - rssBefore : 0;
+    return result;
+}
+
+template<typename T>
+bool parseList(const std::string& text, std::vector<T>& values) {
+    values.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        if constexpr (std::is_same_v<T, std::string>) {
+            values.push_back(item);
+        } else {
+            try {
+                long long value = std::stoll(item);
+                if (value <= 0) {
+                    return false;
+                }
+                values.push_back(static_cast<T>(value));
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+    }
+    return !values.empty();
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [OPTIONS]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --scenarios LIST    Comma-separated scenarios (default all):" << std::endl;
+    for (const Scenario& scenario : allScenarios()) {
+        std::printf("                        %-10s %s\n", scenario.name, scenario.description);
+    }
+    std::cout << "  --bodies LIST       Body (or particle) counts (default 1000,2000,4000)" << std::endl;
+    std::cout << "  --threads LIST      Thread counts (default 1 and all hardware threads)" << std::endl;
+    std::cout << "  --steps N           Measured steps per run (default 200)" << std::endl;
+    std::cout << "  --warmup N          Unmeasured steps before each run (default 20)" << std::endl;
+    std::cout << "  --max-seconds S     Stop a run early after S seconds (default 30)" << std::endl;
+    std::cout << "  --repetitions N     Rebuild and rerun each scene N times (default 1; with --compare" << std::endl;
+    std::cout << "                      the baseline's, at least 5)" << std::endl;
+    std::cout << "  --no-scopes         Do not record profiler scopes during the measured steps" << std::endl;
+    std::cout << "  --counters          Read CPU performance counters per phase (Linux perf_event_open)" << std::endl;
+    std::cout << "  --allocations       Count heap allocations per phase of each step" << std::endl;
+    std::cout << "  --output PATH       JSON results file (default titanium_bench_results.json, - for stdout)" << std::endl;
+    std::cout << "  --quick             Smoke run: 500 bodies, 1 thread, 30 steps" << std::endl;
+    std::cout << "Baseline comparison:" << std::endl;
+    std::cout << "  --compare PATH      Rerun the runs of a stored results file and diff against it;" << std::endl;
+    std::cout << "                      exits with 2 if any metric regressed" << std::endl;
+    std::cout << "  --alpha P           Significance level of the Mann-Whitney tests (default 0.05)" << std::endl;
+    std::cout << "  --threshold PCT     Smallest relative change reported, in percent (default 5)" << std::endl;
+    std::cout << "  --all-metrics       List every phase and scope, not only the changed ones" << std::endl;
+    std::cout << "  --help, -h          Show this help message" << std::endl;
+    std::cout << "The broadphase tests every pair, so a step costs O(bodies^2); counts far above" << std::endl;
+    std::cout << "10000 are accepted but are usually cut short by --max-seconds." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    config.threadCounts = hardwareThreads > 1 ? std::vector<uint32_t>{1, hardwareThreads} : std::vector<uint32_t>{1};
+    bool repetitionsSet = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+        if (arg == "--scenarios" && hasValue) {
+            ok = parseList(argv[++i], config.scenarios);
+        } else if (arg == "--bodies" && hasValue) {
+            ok = parseList(argv[++i], config.bodyCounts);
+        } else if (arg == "--threads" && hasValue) {
+            ok = parseList(argv[++i], config.threadCounts);
+        } else if (arg == "--steps" && hasValue) {
+            config.steps = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--warmup" && hasValue) {
+            config.warmupSteps = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--max-seconds" && hasValue) {
+            config.maxSeconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--repetitions" && hasValue) {
+            config.repetitions = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+            repetitionsSet = true;
+        } else if (arg == "--no-scopes") {
+            config.profileScopes = false;
+        } else if (arg == "--counters") {
+            config.hardwareCounters = true;
+        } else if (arg == "--allocations") {
+            config.allocations = true;
+        } else if (arg == "--output" && hasValue) {
+            config.outputPath = argv[++i];
+        } else if (arg == "--compare" && hasValue) {
+            config.baselinePath = argv[++i];
+        } else if (arg == "--alpha" && hasValue) {
+            config.compare.alpha = std::atof(argv[++i]);
+            ok = config.compare.alpha > 0.0 && config.compare.alpha < 1.0;
+        } else if (arg == "--threshold" && hasValue) {
+            config.compare.threshold = std::atof(argv[++i]) / 100.0;
+            ok = config.compare.threshold >= 0.0;
+        } else if (arg == "--all-metrics") {
+            config.compare.allMetrics = true;
+        } else if (arg == "--quick") {
+            config.bodyCounts = {500};
+            config.threadCounts = {1};
+            config.steps = 30;
+            config.warmupSteps = 5;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Invalid argument: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // A comparison reruns exactly the baseline's runs with its step settings
+    BenchReport baseline;
+    std::vector<RunResult> planned;
+    if (!config.baselinePath.empty()) {
+        std::string error;
+        if (!loadReport(config.baselinePath, baseline, error)) {
+            std::cerr << "Failed to load baseline: " << error << std::endl;
+            return 1;
+        }
+        config.steps = baseline.steps;
+        config.warmupSteps = baseline.warmupSteps;
+        config.timestep = baseline.timestep;
+        if (!repetitionsSet) {
+            config.repetitions = std::max(baseline.repetitions, 5u);
+        }
+        config.scenarios.clear();
+        for (const RunResult& run : baseline.results) {
+            if (!run.skipped) {
+                planned.push_back(run);
+                if (std::find(config.scenarios.begin(), config.scenarios.end(), run.scenario) == config.scenarios.end()) {
+                    config.scenarios.push_back(run.scenario);
+                }
+            }
+        }
+        if (baseline.repetitions < 4) {
+            std::cerr << "Baseline has " << baseline.repetitions
+                      << " repetition(s); record it with --repetitions 5 or more for significance tests" << std::endl;
+        }
+    }
+
+    std::vector<const Scenario*> selected;
+    for (const Scenario& scenario : allScenarios()) {
+        if (config.scenarios.empty() ||
+            std::find(config.scenarios.begin(), config.scenarios.end(), scenario.name) != config.scenarios.end()) {
+            selected.push_back(&scenario);
+        }
+    }
+    for (const std::string& name : config.scenarios) {
+        if (std::none_of(selected.begin(), selected.end(), [&](const Scenario* s) { return name == s->name; })) {
+            std::cerr << "Unknown scenario: " << name << std::endl;
+            return 1;
+        }
+    }
+    if (config.baselinePath.empty()) {
+        for (const Scenario* scenario : selected) {
+            for (uint32_t bodies : config.bodyCounts) {
+                // Particles run on the GPU: the CPU thread count does not apply
+                std::vector<uint32_t> threadCounts = scenario->particles ? std::vector<uint32_t>{1} : config.threadCounts;
+                for (uint32_t threads : threadCounts) {
+                    RunResult run;
+                    run.scenario = scenario->name;
+                    run.bodies = bodies;
+                    run.threads = threads;
+                    planned.push_back(run);
+                }
+            }
+        }
+    }
+
+    // Engine chatter would dominate the output and the timings
+    Logger::getInstance().setLogLevel(LogLevel::WARN);
+#ifdef VULKAN_AVAILABLE
+    bool particlesSelected = std::any_of(selected.begin(), selected.end(), [](const Scenario* s) { return s->particles; });
+    if (particlesSelected && !VulkanManager::getInstance().initialize()) {
+        std::cerr << "Vulkan not available - particle scenarios will be skipped" << std::endl;
+    }
+#endif
+
+    if (config.allocations) {
+        if (AllocationTracker::isAvailable()) {
+            AllocationTracker::getInstance().setEnabled(true);
+        } else {
+            std::cerr << "Allocation tracking unavailable: built with TITANIUM_ALLOCATION_TRACKING=OFF" << std::endl;
+        }
+    }
+    if (config.hardwareCounters && !HardwareCounters::getInstance().setEnabled(true)) {
+        std::cerr << "Hardware counters unavailable: " << HardwareCounters::getInstance().getUnavailableReason()
+                  << std::endl;
+    }
+
+    BenchReport report;
+    report.version = TITANIUM_VERSION;
+    report.steps = config.steps;
+    report.warmupSteps = config.warmupSteps;
+    report.timestep = config.timestep;
+    report.repetitions = config.repetitions;
+    std::printf("%-10s %8s %7s %7s %10s %9s %9s %9s %10s\n", "scenario", "bodies", "threads", "steps", "steps/s",
+                "p50 ms", "p99 ms", "max ms", "rss MiB");
+    for (const RunResult& run : planned) {
+        auto scenario = std::find_if(selected.begin(), selected.end(),
+                                     [&](const Scenario* s) { return run.scenario == s->name; });
+        RunResult result = runScenario(**scenario, run.bodies, run.threads, config);
+        if (result.skipped) {
+            std::printf("%-10s %8u %7u   skipped: %s\n", result.scenario.c_str(), result.bodies, result.threads,
+                        result.skipReason.c_str());
+        } else {
+            std::printf("%-10s %8u %7u %7u%s %10.1f %9.3f %9.3f %9.3f %10.1f\n", result.scenario.c_str(),
+                        result.bodies, result.threads, result.steps, result.truncated ? "*" : " ",
+                        result.stepsPerSecond, result.stepMs.p50, result.stepMs.p99, result.stepMs.max,
+                        static_cast<double>(result.rssBytes) / (1024.0 * 1024.0));
+        }
+        std::fflush(stdout);
+        report.results.push_back(std::move(result));
+    }
+    if (std::any_of(report.results.begin(), report.results.end(), [](const RunResult& r) { return r.truncated; })) {
+        std::printf("* stopped after --max-seconds\n");
+    }
+    if (std::any_of(report.results.begin(), report.results.end(), [](const RunResult& r) { return !r.counters.empty(); })) {
+        std::printf("\n%-10s %8s %7s %-12s %6s %10s %9s %9s %9s\n", "scenario", "bodies", "threads", "phase", "ipc",
+                    "cycles", "L1D miss", "LLC miss", "br miss");
+        for (const RunResult& result : report.results) {
+            for (const CounterSummary& counter : result.counters) {
+                std::printf("%-10s %8u %7u %-12s %6.2f %10.1f %9.3f %9.3f %9.3f  per %s\n", result.scenario.c_str(),
+                            result.bodies, result.threads, counter.phase.c_str(), counter.ipc, counter.cyclesPerItem,
+                            counter.l1dMissesPerItem, counter.llcMissesPerItem, counter.branchMissesPerItem,
+                            counter.per.c_str());
+            }
+        }
+    }
+
+    if (std::any_of(report.results.begin(), report.results.end(), [](const RunResult& r) { return !r.allocations.empty(); })) {
+        std::printf("\n%-10s %8s %7s %-20s %12s %12s\n", "scenario", "bodies", "threads", "phase", "allocs/step",
+                    "bytes/step");
+        for (const RunResult& result : report.results) {
+            for (const AllocationSummary& allocation : result.allocations) {
+                if (allocation.allocationsPerStep > 0.0 || allocation.phase == "total") {
+                    std::printf("%-10s %8u %7u %-20s %12.1f %12.1f\n", result.scenario.c_str(), result.bodies,
+                                result.threads, allocation.phase.c_str(), allocation.allocationsPerStep,
+                                allocation.bytesPerStep);
+                }
+            }
+        }
+    }
+
+    std::string json = toJson(report);
+    if (config.outputPath == "-") {
+        std::cout << json;
+    } else {
+        std::ofstream output(config.outputPath, std::ios::trunc);
+        if (!output.is_open() || !(output << json)) {
+            std::cerr << "Failed to write " << config.outputPath << std::endl;
+            return 1;
+        }
+        std::printf("Results written to %s\n", config.outputPath.c_str());
+    }
+#ifdef VULKAN_AVAILABLE
+    if (VulkanManager::getInstance().isInitialized()) {
+        VulkanManager::getInstance().cleanup();
+    }
+#endif
+
+    if (!config.baselinePath.empty()) {
+        // Keep stdout machine-readable when the JSON went there
+        std::ostream& table = config.outputPath == "-" ? std::cerr : std::cout;
+        table << "\nComparison with " << config.baselinePath << "\n";
+        if (compareReports(baseline, report, config.compare, table) > 0) {
+            return 2;
+        }
+    }
+    return 0;
+}
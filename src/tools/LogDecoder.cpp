@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "PhysicsEngine/managers/logmanager/LogBinary.h"
+#include "PhysicsEngine/managers/logmanager/LogFormat.h"
+#include "PhysicsEngine/managers/logmanager/Logger.h"
+
+// titanium-logdecode: prints a binary log (Logger::setBinaryOutputFile) as text or JSON lines
+
+namespace {
+
+std::string trimmed(std::string text) {
+    while (!text.empty() && text.back() == ' ') {
+        text.pop_back();
+    }
+    return text;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': quoted += "\\\""; break;
+            case '\\': quoted += "\\\\"; break;
+            case '\n': quoted += "\\n"; break;
+            case '\r': quoted += "\\r"; break;
+            case '\t': quoted += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    quoted += escaped;
+                } else {
+                    quoted += c;
+                }
+                break;
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string jsonValue(const LogArguments::Decoded& argument) {
+    switch (argument.type) {
+        case LogArguments::Type::STRING:
+            return jsonString(argument.text);
+        case LogArguments::Type::FLOAT:
+        case LogArguments::Type::DOUBLE:
+            // JSON has no inf or nan
+            if (argument.text.find_first_of("in") != std::string::npos) {
+                return "null";
+            }
+            return argument.text;
+        default:
+            return argument.text;
+    }
+}
+
+std::string toJson(const BinaryLogEntry& entry) {
+    std::string json = "{\"timestamp\":" + std::to_string(entry.timestamp);
+    json += ",\"level\":" + jsonString(trimmed(Logger::logLevelToString(entry.level)));
+    json += ",\"category\":" + jsonString(trimmed(Logger::logCategoryToString(entry.category)));
+
+    if (entry.kind == LogRecordKind::METRIC) {
+        auto values = LogArguments::decode(entry.payload.data(), entry.payload.size());
+        json += ",\"metric\":" + jsonString(entry.format);
+        json += ",\"value\":" + (values.empty() ? std::string("null") : jsonValue(values.front()));
+    } else {
+        json += ",\"message\":" + jsonString(entry.text());
+        if (entry.kind == LogRecordKind::FORMAT) {
+            json += ",\"format\":" + jsonString(entry.format) + ",\"args\":[";
+            auto values = LogArguments::decode(entry.payload.data(), entry.payload.size());
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i > 0) {
+                    json += ',';
+                }
+                json += jsonValue(values[i]);
+            }
+            json += "]";
+        }
+    }
+    return json + "}";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    bool timestamps = true;
+    std::string path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" || arg == "-j") {
+            json = true;
+        } else if (arg == "--no-timestamps") {
+            timestamps = false;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS] <binary log>" << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --json, -j        One JSON object per line instead of text" << std::endl;
+            std::cout << "  --no-timestamps   Omit timestamps from text output" << std::endl;
+            std::cout << "  --help, -h        Show this help message" << std::endl;
+            return 0;
+        } else {
+            path = arg;
+        }
+    }
+
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--json] [--no-timestamps] <binary log>" << std::endl;
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Not a readable binary log: " << path << std::endl;
+        return 1;
+    }
+
+    BinaryLogEntry entry;
+    while (reader.next(entry)) {
+        if (json) {
+            std::cout << toJson(entry) << '\n';
+        } else {
+            std::cout << Logger::formatLine(entry.level, entry.category, entry.text(), entry.timestamp, timestamps)
+                      << '\n';
+        }
+    }
+    std::cout.flush();
+
+    if (reader.isDamaged()) {
+        std::cerr << "Stopped at a damaged or truncated record" << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "PhysicsEngine/managers/metricsmanager/MetricsPage.h"
+
+// titanium-top: live view of a metrics page (PhysicsEngine::enableMetricsExport)
+
+namespace {
+
+using cpu_physics::PhysicsStepStats;
+using cpu_physics::PhysicsStatsHistory;
+
+struct Phase {
+    const char* name;
+    float PhysicsStepStats::*field;
+};
+
+constexpr Phase PHASES[] = {
+    {"gather", &PhysicsStepStats::gatherMs},
+    {"integrate", &PhysicsStepStats::integrateMs},
+    {"continuous", &PhysicsStepStats::continuousMs},
+    {"collision", &PhysicsStepStats::collisionDetectionMs},
+    {"  broadphase", &PhysicsStepStats::broadphaseMs},
+    {"  narrowphase", &PhysicsStepStats::narrowphaseMs},
+    {"solve", &PhysicsStepStats::solveMs},
+    {"write back", &PhysicsStepStats::writeBackMs},
+    {"sleep", &PhysicsStepStats::sleepMs},
+    {"systems", &PhysicsStepStats::systemsMs},
+    {"legacy sync", &PhysicsStepStats::legacySyncMs},
+    {"gpu dispatch", &PhysicsStepStats::gpuDispatchMs},
+    {"total", &PhysicsStepStats::totalMs},
+};
+
+double bodiesInStep(const PhysicsStepStats& s) {
+    return static_cast<double>(s.awakeBodies) + s.sleepingBodies + s.staticBodies;
+}
+
+// Counters are shown per item the phase processed
+struct CounterPhase {
+    const char* name;
+    HardwareCounterValues PhysicsStepStats::*counters;
+    const char* per;
+    double (*items)(const PhysicsStepStats&);
+};
+
+const CounterPhase COUNTER_PHASES[] = {
+    {"gather", &PhysicsStepStats::gatherCounters, "body", bodiesInStep},
+    {"integrate", &PhysicsStepStats::integrateCounters, "body", bodiesInStep},
+    {"broadphase", &PhysicsStepStats::broadphaseCounters, "pair",
+     [](const PhysicsStepStats& s) { return static_cast<double>(s.broadphasePairsTested); }},
+    {"narrowphase", &PhysicsStepStats::narrowphaseCounters, "pair",
+     [](const PhysicsStepStats& s) { return static_cast<double>(s.broadphasePairsEmitted); }},
+    {"solve", &PhysicsStepStats::solveCounters, "body", bodiesInStep},
+    {"write back", &PhysicsStepStats::writeBackCounters, "body", bodiesInStep},
+    {"systems", &PhysicsStepStats::systemsCounters, "body", bodiesInStep},
+};
+
+std::string bytes(uint64_t count) {
+    char text[32];
+    if (count >= 1024ull * 1024ull) {
+        std::snprintf(text, sizeof(text), "%.1f MiB", static_cast<double>(count) / (1024.0 * 1024.0));
+    } else if (count >= 1024ull) {
+        std::snprintf(text, sizeof(text), "%.1f KiB", static_cast<double>(count) / 1024.0);
+    } else {
+        std::snprintf(text, sizeof(text), "%llu B", static_cast<unsigned long long>(count));
+    }
+    return text;
+}
+
+void print(const std::string& path, const MetricsReader& reader, const MetricsSnapshot& snapshot,
+           const PhysicsStatsHistory& history) {
+    const PhysicsStepStats& s = snapshot.stats;
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    double age = now > snapshot.publishTime ? static_cast<double>(now - snapshot.publishTime) * 1e-9 : 0.0;
+
+    std::printf("titanium-top  %s  pid %llu  step %llu  updated %.2f s ago%s\n\n", path.c_str(),
+                static_cast<unsigned long long>(reader.getWriterPid()),
+                static_cast<unsigned long long>(s.stepIndex), age,
+                reader.isWriterActive() ? "" : "  (writer stopped)");
+    std::printf("bodies     awake %u  sleeping %u  static %u  lod-skipped %u\n", s.awakeBodies, s.sleepingBodies,
+                s.staticBodies, s.lodSkippedBodies);
+    std::printf("pairs      tested %llu  emitted %llu  layer-filtered %llu  contacts %u\n",
+                static_cast<unsigned long long>(s.broadphasePairsTested),
+                static_cast<unsigned long long>(s.broadphasePairsEmitted),
+                static_cast<unsigned long long>(s.layerFilteredPairs), s.narrowphaseContacts);
+    std::printf("solver     iterations %u  residual %.4f m/s  islands %u\n", s.solverIterations, s.solverResidual,
+                s.islands);
+    std::printf("particles  %u  uploaded %s  downloaded %s\n", s.particles, bytes(s.bytesUploaded).c_str(),
+                bytes(s.bytesDownloaded).c_str());
+    // Zero unless the writer tracks allocations
+    if (s.allocations > 0) {
+        std::printf("heap       %llu allocations  %s\n", static_cast<unsigned long long>(s.allocations),
+                    bytes(s.allocatedBytes).c_str());
+    }
+    std::printf("\n");
+
+    std::printf("%-14s %9s %9s %9s %9s\n", "phase", "last ms", "p50 ms", "p99 ms", "max ms");
+    for (const Phase& phase : PHASES) {
+        auto summary = history.summarize(phase.field);
+        std::printf("%-14s %9.3f %9.3f %9.3f %9.3f\n", phase.name, s.*phase.field, summary.p50, summary.p99,
+                    summary.max);
+    }
+
+    // Present when the writer enabled HardwareCounters and could read them
+    bool counted = false;
+    for (const CounterPhase& phase : COUNTER_PHASES) {
+        counted |= (s.*phase.counters).cycles > 0;
+    }
+    if (counted) {
+        std::printf("\n%-14s %6s %10s %9s %9s %9s\n", "counters", "ipc", "cycles", "L1D miss", "LLC miss", "br miss");
+        for (const CounterPhase& phase : COUNTER_PHASES) {
+            const HardwareCounterValues& c = s.*phase.counters;
+            double items = phase.items(s);
+            double perItem = items > 0.0 ? 1.0 / items : 0.0;
+            std::printf("%-14s %6.2f %10.1f %9.3f %9.3f %9.3f  per %s\n", phase.name, c.ipc(),
+                        static_cast<double>(c.cycles) * perItem, static_cast<double>(c.l1dMisses) * perItem,
+                        static_cast<double>(c.llcMisses) * perItem, static_cast<double>(c.branchMisses) * perItem,
+                        phase.per);
+        }
+    }
+    std::printf("\npercentiles over the last %zu sampled steps\n", history.size());
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    int intervalMs = 500;
+    size_t window = 120;
+    bool once = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--interval" || arg == "-i") && i + 1 < argc) {
+            intervalMs = std::max(std::stoi(argv[++i]), 10);
+        } else if ((arg == "--window" || arg == "-w") && i + 1 < argc) {
+            window = static_cast<size_t>(std::max(std::stoi(argv[++i]), 1));
+        } else if (arg == "--once") {
+            once = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS] <metrics file>" << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --interval, -i MS   Refresh period (default 500)" << std::endl;
+            std::cout << "  --window, -w N      Sampled steps kept for percentiles (default 120)" << std::endl;
+            std::cout << "  --once              Print the latest step once and exit" << std::endl;
+            std::cout << "  --help, -h          Show this help message" << std::endl;
+            return 0;
+        } else {
+            path = arg;
+        }
+    }
+
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--interval MS] [--window N] [--once] <metrics file>" << std::endl;
+        return 1;
+    }
+
+    MetricsReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Not a readable metrics page: " << path << std::endl;
+        return 1;
+    }
+
+    PhysicsStatsHistory history(window);
+    MetricsSnapshot snapshot;
+    bool sampled = false;
+    uint64_t lastStep = 0;
+
+    for (;;) {
+        if (reader.read(snapshot)) {
+            if (!sampled || snapshot.stats.stepIndex != lastStep) {
+                history.push(snapshot.stats);
+                lastStep = snapshot.stats.stepIndex;
+                sampled = true;
+            }
+            if (!once) {
+                std::printf("\033[H\033[2J"); // home and clear
+            }
+            print(path, reader, snapshot, history);
+        } else if (once) {
+            std::cerr << "No step has been published yet" << std::endl;
+            return 2;
+        }
+
+        if (once) {
+            return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+}